@@ -0,0 +1,288 @@
+#include <Crash2D/sweep_broadphase.hpp>
+#include <Crash2D/SparseSpatialBroadphase.hpp>
+#include <Crash2D/arena.hpp>
+
+#include <Crash2D/memory.hpp>
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <new>
+#include <random>
+#include <string>
+
+using namespace Crash2D;
+
+// Every broadphase backend against every object distribution, registered as
+// BM_Broadphase/<backend>/<distribution>/<frames>/count:<objects>/cell:<cell size>
+//
+// Each iteration is one frame: the backend is given the current bounds and asked for pairs.
+// Besides the frame time it reports the seconds per frame spent submitting bounds (insert_time)
+// and generating pairs (pair_time), the pairs emitted, the peak bytes the backend held and its
+// allocations per frame. The sweep on a static scene reports the one-off cost of inserting
+// every proxy as its insert_time, and its first, from scratch sort is made before timing starts.
+//
+// Memory is measured through the library's tagged allocator, installed for each run only, so the
+// other benchmarks in this binary allocate as usual. It covers the cells, proxies, sorted lists
+// and arena blocks, but not the pair set SparseSpatialBroadphase::getCollisionPairs() returns on
+// the default heap.
+
+// Tracks the bytes the library holds while one broadphase run is measured
+class PeakAllocator : public Allocator
+{
+public:
+	PeakAllocator() : live(0), peak(0) {}
+
+	virtual void* Allocate(const size_t bytes, const MemoryTag tag) override
+	{
+		void *p = ::operator new(bytes);
+
+		const size_t now = live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+		size_t high = peak.load(std::memory_order_relaxed);
+
+		while (now > high && !peak.compare_exchange_weak(high, now, std::memory_order_relaxed));
+
+		return p;
+	}
+
+	virtual void Deallocate(void *p, const size_t bytes, const MemoryTag tag) override
+	{
+		live.fetch_sub(bytes, std::memory_order_relaxed);
+		::operator delete(p);
+	}
+
+	std::atomic<size_t> live; /*!< The bytes currently held. */
+	std::atomic<size_t> peak; /*!< The most bytes held at once. */
+};
+
+static uint64_t CountAllocations()
+{
+	const MemoryStats stats = GetMemoryStats();
+	return stats.allocations[MEMORY_BROADPHASE] + stats.allocations[MEMORY_ARENAS];
+}
+
+static const char *BACKENDS[] = { "Sweep", "SparseSpatial", "SparseSpatialArena" };
+static const char *DISTRIBUTIONS[] = { "Uniform", "Clustered", "Corridor", "MixedSize" };
+static const char *FRAMES[] = { "Static", "Moving" };
+
+// An object with its bounds, moving with a constant velocity inside the world
+struct Object
+{
+	Vector2 position;
+	Vector2 halfSize;
+	Vector2 velocity;
+};
+
+// Lays out n objects at the same density, roughly one object per 16 by 16 units
+static std::vector<Object> Distribute(const unsigned distribution, const unsigned n, Vector2 &world)
+{
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<Precision_t> unit(0, 1);
+
+	const Precision_t side = std::sqrt(static_cast<Precision_t>(n)) * 16;
+	world = (distribution == 2) ? Vector2(side * 4, side / 4) : Vector2(side, side);
+
+	// Gaussian blobs for the clustered layout
+	std::vector<Vector2> centers;
+
+	for (unsigned i = 0; i < 32; i++)
+		centers.push_back(Vector2(unit(random) * world.x, unit(random) * world.y));
+
+	std::normal_distribution<Precision_t> spread(0, side / 40);
+
+	std::vector<Object> objects(n);
+
+	for (auto && o : objects)
+	{
+		if (distribution == 1)
+		{
+			const Vector2 &c = centers[random() % centers.size()];
+			o.position = Vector2(c.x + spread(random), c.y + spread(random));
+		}
+
+		else
+			o.position = Vector2(unit(random) * world.x, unit(random) * world.y);
+
+		Precision_t size = 4 + unit(random) * 8;
+
+		// Mostly small, some large and a few huge
+		if (distribution == 3)
+		{
+			const Precision_t roll = unit(random);
+			size = (roll < 0.9f) ? 2 + unit(random) * 4 : (roll < 0.99f) ? 10 + unit(random) * 10 : 50 + unit(random) * 50;
+		}
+
+		o.halfSize = Vector2(size, size * (0.5f + unit(random)));
+		o.velocity = Vector2(unit(random) - 0.5f, unit(random) - 0.5f) * 4;
+	}
+
+	return objects;
+}
+
+static void Move(std::vector<Object> &objects, const Vector2 &world)
+{
+	for (auto && o : objects)
+	{
+		o.position = o.position + o.velocity;
+
+		// Bounce off the edges of the world
+		if (o.position.x < 0 || o.position.x > world.x)
+			o.velocity.x = -o.velocity.x;
+
+		if (o.position.y < 0 || o.position.y > world.y)
+			o.velocity.y = -o.velocity.y;
+	}
+}
+
+static Bounds GetBounds(const Object &o)
+{
+	return Bounds(o.position - o.halfSize, o.position + o.halfSize);
+}
+
+static double Elapsed(const std::chrono::steady_clock::time_point &start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Runs the frames of one broadphase benchmark, the backends are gone once it returns
+static void Measure(benchmark::State &state, const unsigned backend, const unsigned frames, std::vector<Object> &objects, const Vector2 &world)
+{
+	const unsigned n = state.range(0);
+	const int cell = state.range(1);
+
+	SweepBroadphase sweep;
+	SparseSpatialBroadphase sparse(cell, cell);
+	FrameArena arena;
+	std::vector<ProxyPair> pairs;
+
+	double buildTime = 0;
+
+	if (backend == 0)
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		for (unsigned i = 0; i < n; i++)
+			sweep.Insert(i, GetBounds(objects[i]));
+
+		buildTime = Elapsed(start);
+
+		// Warm up, the first call sorts from scratch and would dominate the first frame
+		sweep.FindPairs(pairs);
+	}
+
+	double insertTime = 0;
+	double pairTime = 0;
+	size_t emitted = 0;
+
+	const uint64_t startAllocations = CountAllocations();
+
+	for (auto _ : state)
+	{
+		if (frames == 1)
+			Move(objects, world);
+
+		auto start = std::chrono::steady_clock::now();
+
+		if (backend == 0)
+		{
+			// The sweep keeps its proxies, only moved ones need new bounds
+			if (frames == 1)
+			{
+				for (unsigned i = 0; i < n; i++)
+					sweep.Update(i, GetBounds(objects[i]));
+			}
+
+			insertTime += Elapsed(start);
+			start = std::chrono::steady_clock::now();
+
+			sweep.FindPairs(pairs);
+			emitted = pairs.size();
+		}
+
+		else
+		{
+			// The spatial hash is rebuilt every frame
+			sparse.clear();
+
+			for (unsigned i = 0; i < n; i++)
+			{
+				const Bounds b = GetBounds(objects[i]);
+				sparse.addRectangle(b.min.x, b.min.y, b.max.x - b.min.x, b.max.y - b.min.y, &objects[i]);
+			}
+
+			insertTime += Elapsed(start);
+			start = std::chrono::steady_clock::now();
+
+			// The arena backend draws its pairs from memory reused every frame
+			if (backend == 2)
+			{
+				arena.Reset();
+				emitted = sparse.getCollisionPairs(arena).size();
+			}
+
+			else
+				emitted = sparse.getCollisionPairs().size();
+		}
+
+		pairTime += Elapsed(start);
+	}
+
+	const double frameCount = state.iterations();
+
+	// The sweep keeps its proxies, so a static scene only pays for inserting them once
+	const bool once = (backend == 0 && frames == 0);
+
+	state.counters["insert_time"] = benchmark::Counter(once ? buildTime : insertTime / frameCount);
+	state.counters["pair_time"] = benchmark::Counter(pairTime / frameCount);
+	state.counters["pairs"] = emitted;
+	state.counters["allocs"] = benchmark::Counter((CountAllocations() - startAllocations) / frameCount);
+}
+
+static void BM_Broadphase(benchmark::State &state, unsigned backend, unsigned distribution, unsigned frames)
+{
+	Vector2 world;
+	std::vector<Object> objects = Distribute(distribution, state.range(0), world);
+
+	// Installs only while the library holds no tagged memory, and is removed once the backends are gone
+	PeakAllocator tracker;
+	const bool tracked = SetAllocator(&tracker);
+
+	Measure(state, backend, frames, objects, world);
+
+	if (tracked)
+	{
+		SetAllocator(nullptr);
+		state.counters["peak"] = benchmark::Counter(tracker.peak.load(), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+	}
+}
+
+static bool Register()
+{
+	const std::vector<int64_t> counts = { 1 << 10, 1 << 13, 1 << 16, 1 << 19, 1 << 20 };
+
+	for (unsigned backend = 0; backend < 3; backend++)
+	{
+		for (unsigned distribution = 0; distribution < 4; distribution++)
+		{
+			for (unsigned frames = 0; frames < 2; frames++)
+			{
+				const std::string name = std::string("BM_Broadphase/") + BACKENDS[backend] + "/" + DISTRIBUTIONS[distribution] + "/" + FRAMES[frames];
+				benchmark::internal::Benchmark *b = benchmark::RegisterBenchmark(name.c_str(), BM_Broadphase, backend, distribution, frames);
+
+				b->ArgNames({ "count", "cell" })->Unit(benchmark::kMillisecond);
+
+				// Only the spatial hash has a cell size
+				if (backend != 0)
+					b->ArgsProduct({ counts, { 16, 64, 256 } });
+
+				else
+					b->ArgsProduct({ counts, { 0 } });
+			}
+		}
+	}
+
+	return true;
+}
+
+static const bool registered = Register();
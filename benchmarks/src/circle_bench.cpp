@@ -0,0 +1,70 @@
+#include <Crash2D/circle.hpp>
+#include <Crash2D/circle_kernel.hpp>
+#include <Crash2D/collision.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+
+using namespace Crash2D;
+
+static std::vector<Circle> Circles(unsigned n)
+{
+	std::vector<Circle> circles;
+
+	for (unsigned i = 0; i < n; i++)
+		circles.push_back(Circle(Vector2(std::cos(i * 1.3f) * 500, std::sin(i * 0.7f) * 500), 5 + (i % 7) * 3));
+
+	return circles;
+}
+
+// One GetCollision per pair, each paying for atan2, cos and sin
+static void BM_CirclesScalar(benchmark::State &state)
+{
+	const std::vector<Circle> circles = Circles(state.range(0));
+
+	for (auto _ : state)
+	{
+		unsigned hits = 0;
+
+		for (unsigned i = 1; i < circles.size(); i++)
+			hits += circles[0].GetCollision(circles[i]).Overlaps();
+
+		benchmark::DoNotOptimize(hits);
+	}
+
+	state.SetItemsProcessed(state.iterations() * (state.range(0) - 1));
+}
+
+// The same test through the batched kernel
+static void BM_CirclesKernel(benchmark::State &state)
+{
+	const std::vector<Circle> circles = Circles(state.range(0));
+	const unsigned n = circles.size() - 1;
+
+	std::vector<Precision_t> x, y, radius;
+
+	for (unsigned i = 1; i < circles.size(); i++)
+	{
+		x.push_back(circles[i].GetCenter().x);
+		y.push_back(circles[i].GetCenter().y);
+		radius.push_back(circles[i].GetRadius());
+	}
+
+	std::vector<unsigned char> overlaps(n);
+	std::vector<Precision_t> depth(n), normalX(n), normalY(n);
+
+	const CircleBatch batch = { x.data(), y.data(), radius.data(), n };
+	CircleContacts out = { overlaps.data(), depth.data(), normalX.data(), normalY.data() };
+
+	for (auto _ : state)
+	{
+		CollideCircles(circles[0].GetCenter(), circles[0].GetRadius(), batch, out);
+		benchmark::DoNotOptimize(overlaps.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_CirclesScalar)->RangeMultiplier(4)->Range(16, 4096);
+BENCHMARK(BM_CirclesKernel)->RangeMultiplier(4)->Range(16, 4096);
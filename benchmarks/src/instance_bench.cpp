@@ -0,0 +1,83 @@
+#include <Crash2D/polygon_instance.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265359
+#endif
+
+using namespace Crash2D;
+
+static std::vector<Vector2> Hull()
+{
+	std::vector<Vector2> points;
+
+	for (unsigned i = 0; i < 8; i++)
+	{
+		const Precision_t angle = (2 * M_PI * i) / 8;
+		points.push_back(Vector2(std::cos(angle) * 10, std::sin(angle) * 10));
+	}
+
+	return points;
+}
+
+static AffineMatrix Place(unsigned i)
+{
+	return AffineMatrix(Transformation(Vector2(1, 1), (i * 37) % 360, Vector2((i % 100) * 15, (i / 100) * 15)));
+}
+
+// Every crate owns a full copy of the hull
+static void BM_CratesPolygon(benchmark::State &state)
+{
+	const std::vector<Vector2> hull = Hull();
+	std::vector<Polygon> crates(state.range(0));
+
+	for (unsigned i = 0; i < crates.size(); i++)
+	{
+		crates[i].SetPointCount(hull.size());
+
+		for (unsigned j = 0; j < hull.size(); j++)
+			crates[i].SetPoint(j, Place(i).TransformPoint(hull[j]));
+
+		crates[i].ReCalc();
+	}
+
+	for (auto _ : state)
+	{
+		unsigned hits = 0;
+
+		for (unsigned i = 1; i < crates.size(); i++)
+			hits += crates[i - 1].Overlaps(crates[i]);
+
+		benchmark::DoNotOptimize(hits);
+	}
+
+	state.SetItemsProcessed(state.iterations() * (state.range(0) - 1));
+}
+
+// Every crate references one shared hull
+static void BM_CratesInstance(benchmark::State &state)
+{
+	const GeometryPtr hull = std::make_shared<const PolygonGeometry>(Hull());
+	std::vector<PolygonInstance> crates;
+
+	for (unsigned i = 0; i < state.range(0); i++)
+		crates.push_back(PolygonInstance(hull, Place(i)));
+
+	for (auto _ : state)
+	{
+		unsigned hits = 0;
+
+		for (unsigned i = 1; i < crates.size(); i++)
+			hits += crates[i - 1].Overlaps(crates[i]);
+
+		benchmark::DoNotOptimize(hits);
+	}
+
+	state.SetItemsProcessed(state.iterations() * (state.range(0) - 1));
+}
+
+BENCHMARK(BM_CratesPolygon)->RangeMultiplier(10)->Range(100, 10000);
+BENCHMARK(BM_CratesInstance)->RangeMultiplier(10)->Range(100, 10000);
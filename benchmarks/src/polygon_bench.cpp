@@ -0,0 +1,107 @@
+#include <Crash2D/polygon.hpp>
+#include <Crash2D/segment.hpp>
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265359
+#endif
+
+using namespace Crash2D;
+
+// A jagged outline similar to terrain, so that neighbouring outlines cross many times
+static Polygon Outline(const Vector2 &center, unsigned n)
+{
+	Polygon p;
+	p.SetPointCount(n);
+
+	for (unsigned i = 0; i < n; i++)
+	{
+		const Precision_t angle = (2 * M_PI * i) / n;
+		const Precision_t radius = (i % 2 == 0) ? 100 : 80;
+		p.SetPoint(i, center + Vector2(std::cos(angle) * radius, std::sin(angle) * radius));
+	}
+
+	p.ReCalc();
+	return p;
+}
+
+// Tests every pair of sides, the path used below SWEEP_THRESHOLD
+static void BM_PolygonIntersectsPairwise(benchmark::State &state)
+{
+	const Polygon a = Outline(Vector2(0, 0), state.range(0));
+	const Polygon b = Outline(Vector2(30, 10), state.range(0));
+
+	for (auto _ : state)
+	{
+		std::vector<Vector2> intersects;
+
+		for (auto && sA : a.GetSides())
+		{
+			for (auto && sB : b.GetSides())
+			{
+				auto i = sA.GetIntersects(sB);
+
+				if (i.size() > 0 && std::find(std::begin(intersects), std::end(intersects), i[0]) == std::end(intersects))
+					intersects.push_back(i[0]);
+			}
+		}
+
+		benchmark::DoNotOptimize(intersects);
+	}
+
+	state.SetComplexityN(state.range(0));
+}
+
+static void BM_PolygonIntersects(benchmark::State &state)
+{
+	const Polygon a = Outline(Vector2(0, 0), state.range(0));
+	const Polygon b = Outline(Vector2(30, 10), state.range(0));
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(a.GetIntersects(b));
+
+	state.SetComplexityN(state.range(0));
+}
+
+// An object that moves every frame but is only queried once every 16 frames
+static void BM_PolygonMoveEager(benchmark::State &state)
+{
+	Polygon p = Outline(Vector2(0, 0), state.range(0));
+	const Polygon other = Outline(Vector2(30, 0), 8);
+	const Transformation step(Vector2(1, 1), 1, Vector2(0.5, 0));
+
+	for (auto _ : state)
+	{
+		for (unsigned frame = 0; frame < 16; frame++)
+			p.Transform(step);
+
+		benchmark::DoNotOptimize(p.Overlaps(other));
+	}
+}
+
+static void BM_PolygonMoveLocal(benchmark::State &state)
+{
+	Polygon p = Outline(Vector2(0, 0), state.range(0));
+	p.SetLocalSpace(true);
+
+	const Polygon other = Outline(Vector2(30, 0), 8);
+	const Transformation step(Vector2(1, 1), 1, Vector2(0.5, 0));
+
+	for (auto _ : state)
+	{
+		for (unsigned frame = 0; frame < 16; frame++)
+			p.Transform(step);
+
+		benchmark::DoNotOptimize(p.Overlaps(other));
+	}
+}
+
+BENCHMARK(BM_PolygonIntersectsPairwise)->RangeMultiplier(2)->Range(8, 1024)->Complexity();
+BENCHMARK(BM_PolygonIntersects)->RangeMultiplier(2)->Range(8, 1024)->Complexity();
+BENCHMARK(BM_PolygonMoveEager)->RangeMultiplier(4)->Range(8, 512);
+BENCHMARK(BM_PolygonMoveLocal)->RangeMultiplier(4)->Range(8, 512);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,113 @@
+#include <Crash2D/polygon.hpp>
+#include <Crash2D/projection_kernel.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <limits>
+
+#ifndef M_PI
+#define M_PI 3.14159265359
+#endif
+
+using namespace Crash2D;
+
+static Polygon Regular(const Vector2 &center, unsigned n)
+{
+	Polygon p;
+	p.SetPointCount(n);
+
+	for (unsigned i = 0; i < n; i++)
+	{
+		const Precision_t angle = (2 * M_PI * i) / n;
+		p.SetPoint(i, center + Vector2(std::cos(angle) * 50, std::sin(angle) * 50));
+	}
+
+	p.ReCalc();
+	return p;
+}
+
+static AxesVec Axes(const Polygon &a, const Polygon &b)
+{
+	AxesVec axes = a.GetAxes();
+	axes.insert(axes.end(), b.GetAxes().begin(), b.GetAxes().end());
+
+	return axes;
+}
+
+// The scalar loop Polygon::Project used before the kernels
+static Projection ProjectScalar(const Polygon &p, const Axis &a)
+{
+	Precision_t min = a.Dot(p.GetPoint(0));
+	Precision_t max = min;
+
+	for (unsigned i = 1; i < p.GetPointCount(); i++)
+	{
+		const Precision_t prj = a.Dot(p.GetPoint(i));
+
+		if (prj < min)
+			min = prj;
+
+		else if (prj > max)
+			max = prj;
+	}
+
+	return Projection(min, max);
+}
+
+static void BM_SeparateScalar(benchmark::State &state)
+{
+	const Polygon a = Regular(Vector2(0, 0), state.range(0));
+	const Polygon b = Regular(Vector2(30, 10), state.range(0) + 1);
+	const AxesVec axes = Axes(a, b);
+
+	for (auto _ : state)
+	{
+		Precision_t smallest = std::numeric_limits<Precision_t>::infinity();
+
+		for (auto && axis : axes)
+		{
+			const Projection pA = ProjectScalar(b, axis);
+			const Projection pB = ProjectScalar(a, axis);
+
+			if (!pA.IsOverlap(pB))
+				break;
+
+			smallest = std::min(smallest, std::abs(pA.GetOverlap(pB)));
+		}
+
+		benchmark::DoNotOptimize(smallest);
+	}
+}
+
+// One virtual Project() per axis per shape, as ShapeImpl::CalcDisplacement does
+static void BM_SeparateVirtual(benchmark::State &state)
+{
+	const Polygon a = Regular(Vector2(0, 0), state.range(0));
+	const Polygon b = Regular(Vector2(30, 10), state.range(0) + 1);
+	const AxesVec axes = Axes(a, b);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(a.CalcDisplacement(axes, a, b));
+}
+
+// Every axis against both point sets in one pass
+static void BM_SeparateKernel(benchmark::State &state)
+{
+	const Polygon a = Regular(Vector2(0, 0), state.range(0));
+	const Polygon b = Regular(Vector2(30, 10), state.range(0) + 1);
+	const AxesVec axes = Axes(a, b);
+
+	PointArray pA, pB;
+	pA.Assign(a.GetPoints());
+	pB.Assign(b.GetPoints());
+
+	for (auto _ : state)
+	{
+		Precision_t overlap;
+		benchmark::DoNotOptimize(SeparatePoints(axes, pA, pB, overlap));
+	}
+}
+
+BENCHMARK(BM_SeparateScalar)->RangeMultiplier(2)->Range(4, 64);
+BENCHMARK(BM_SeparateVirtual)->RangeMultiplier(2)->Range(4, 64);
+BENCHMARK(BM_SeparateKernel)->RangeMultiplier(2)->Range(4, 64);
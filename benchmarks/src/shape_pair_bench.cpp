@@ -0,0 +1,132 @@
+#include <Crash2D/circle.hpp>
+#include <Crash2D/polygon.hpp>
+#include <Crash2D/segment.hpp>
+#include <Crash2D/collision.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <memory>
+#include <string>
+
+#ifndef M_PI
+#define M_PI 3.14159265359
+#endif
+
+using namespace Crash2D;
+
+// Every query of every Circle, Polygon and Segment pair, registered as
+// BM_Pair/<first>/<second>/<query>/<vertices>/<hit percent>
+
+static const char *KINDS[] = { "Circle", "Polygon", "Segment" };
+static const char *QUERIES[] = { "Overlaps", "GetDisplacement", "GetCollision", "GetIntersects", "Contains" };
+
+static const unsigned TARGETS = 64; // The number of shapes each iteration queries against
+static const Precision_t SIZE = 20; // The radius of every shape
+
+static Shape* Make(unsigned kind, const Vector2 &c, unsigned vertices, Precision_t angle)
+{
+	if (kind == 0)
+		return new Circle(c, SIZE);
+
+	if (kind == 2)
+	{
+		const Vector2 d(std::cos(angle) * SIZE, std::sin(angle) * SIZE);
+		return new Segment(c - d, c + d);
+	}
+
+	Polygon *p = new Polygon();
+	p->SetPointCount(vertices);
+
+	for (unsigned i = 0; i < vertices; i++)
+	{
+		const Precision_t a = angle + (2 * M_PI * i) / vertices;
+		p->SetPoint(i, c + Vector2(std::cos(a) * SIZE, std::sin(a) * SIZE));
+	}
+
+	p->ReCalc();
+	return p;
+}
+
+// Spreads the targets around the origin, hit percent of them close enough to overlap a shape there
+static std::vector<std::unique_ptr<Shape>> Targets(unsigned kind, unsigned vertices, unsigned hit)
+{
+	std::vector<std::unique_ptr<Shape>> targets;
+
+	for (unsigned i = 0; i < TARGETS; i++)
+	{
+		const Precision_t angle = i * 2.39996f;
+		const Precision_t distance = ((i * 37) % 100 < hit) ? SIZE * 0.6f : SIZE * 3;
+
+		targets.emplace_back(Make(kind, Vector2(std::cos(angle), std::sin(angle)) * distance, vertices, angle));
+	}
+
+	return targets;
+}
+
+static void BM_Pair(benchmark::State &state, unsigned first, unsigned second, unsigned query)
+{
+	const unsigned vertices = state.range(0);
+	const unsigned hit = state.range(1);
+
+	const std::unique_ptr<Shape> a(Make(first, Vector2(0, 0), vertices, 0.3f));
+	const std::vector<std::unique_ptr<Shape>> targets = Targets(second, vertices, hit);
+
+	for (auto _ : state)
+	{
+		for (auto && b : targets)
+		{
+			switch (query)
+			{
+			case 0:
+				benchmark::DoNotOptimize(a->Overlaps(*b));
+				break;
+
+			case 1:
+				benchmark::DoNotOptimize(a->GetDisplacement(*b));
+				break;
+
+			case 2:
+				benchmark::DoNotOptimize(a->GetCollision(*b).Overlaps());
+				break;
+
+			case 3:
+				benchmark::DoNotOptimize(a->GetIntersects(*b));
+				break;
+
+			default:
+				benchmark::DoNotOptimize(a->Contains(*b));
+				break;
+			}
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * TARGETS);
+}
+
+static bool Register()
+{
+	for (unsigned first = 0; first < 3; first++)
+	{
+		for (unsigned second = 0; second < 3; second++)
+		{
+			for (unsigned query = 0; query < 5; query++)
+			{
+				const std::string name = std::string("BM_Pair/") + KINDS[first] + "/" + KINDS[second] + "/" + QUERIES[query];
+				benchmark::internal::Benchmark *b = benchmark::RegisterBenchmark(name.c_str(), BM_Pair, first, second, query);
+
+				b->ArgNames({ "vertices", "hit" });
+
+				// Vertex counts only matter when a polygon is involved
+				if (first == 1 || second == 1)
+					b->ArgsProduct({ { 4, 16, 64 }, { 0, 50, 100 } });
+
+				else
+					b->ArgsProduct({ { 4 }, { 0, 50, 100 } });
+			}
+		}
+	}
+
+	return true;
+}
+
+static const bool registered = Register();
@@ -0,0 +1,82 @@
+#include <Crash2D/affine_matrix.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265359
+#endif
+
+using namespace Crash2D;
+
+static std::vector<Vector2> Points(unsigned n)
+{
+	std::vector<Vector2> points;
+
+	for (unsigned i = 0; i < n; i++)
+		points.push_back(Vector2(std::cos(i * 1.3f) * 50, std::sin(i * 0.7f) * 50));
+
+	return points;
+}
+
+// A three level hierarchy, such as a hand on a forearm on an upper arm
+static std::vector<Transformation> Chain()
+{
+	std::vector<Transformation> chain;
+	chain.push_back(Transformation(Vector2(1, 1), 30, Vector2(10, 0)));
+	chain.push_back(Transformation(Vector2(1, 1), -45, Vector2(25, 5)));
+	chain.push_back(Transformation(Vector2(1, 1), 10, Vector2(-3, 40)));
+
+	return chain;
+}
+
+// One pass per level with the per-point math Shape::Transform used before matrices
+static void BM_TransformNested(benchmark::State &state)
+{
+	const std::vector<Transformation> chain = Chain();
+	std::vector<Vector2> points = Points(state.range(0));
+
+	for (auto _ : state)
+	{
+		for (auto && t : chain)
+		{
+			const Precision_t radians = (t.GetRotation() * M_PI) / 180;
+			const Precision_t s = std::sin(radians);
+			const Precision_t c = std::cos(radians);
+
+			for (auto && pt : points)
+			{
+				const Vector2 p = (pt - t.GetPivot()) * t.GetScale();
+				pt = Vector2((p.x * c) - (p.y * s), (p.x * s) + (p.y * c)) + t.GetPivot() + t.GetTranslation();
+			}
+		}
+
+		benchmark::DoNotOptimize(points.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// The levels composed into one matrix and applied in a single batch
+static void BM_TransformComposed(benchmark::State &state)
+{
+	const std::vector<Transformation> chain = Chain();
+	std::vector<Vector2> points = Points(state.range(0));
+
+	for (auto _ : state)
+	{
+		AffineMatrix m;
+
+		for (auto && t : chain)
+			m = AffineMatrix(t) * m;
+
+		m.TransformPoints(points);
+		benchmark::DoNotOptimize(points.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_TransformNested)->RangeMultiplier(4)->Range(8, 2048);
+BENCHMARK(BM_TransformComposed)->RangeMultiplier(4)->Range(8, 2048);
@@ -0,0 +1,175 @@
+#include <Crash2D/collision_world.hpp>
+#include <Crash2D/thread_pool.hpp>
+#include <Crash2D/circle.hpp>
+#include <Crash2D/polygon.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+
+using namespace Crash2D;
+
+static Polygon* Hexagon(const Vector2 &c, Precision_t r)
+{
+	Polygon *p = new Polygon();
+	p->SetPointCount(6);
+
+	for (unsigned i = 0; i < 6; i++)
+		p->SetPoint(i, c + Vector2(std::cos(i * 1.0472f) * r, std::sin(i * 1.0472f) * r));
+
+	p->ReCalc();
+	return p;
+}
+
+// A dense field of circles and hexagons, roughly four candidate pairs per shape
+static std::vector<ShapeHandle> Fill(CollisionWorld &w, unsigned n)
+{
+	const unsigned side = std::sqrt(n);
+	std::vector<ShapeHandle> handles;
+
+	for (unsigned i = 0; i < n; i++)
+	{
+		const Vector2 c((i % side) * 12 + std::sin(i * 1.7f) * 4, (i / side) * 12 + std::cos(i * 0.9f) * 4);
+
+		if (i % 2)
+			handles.push_back(w.Add(new Circle(c, 6)));
+
+		else
+			handles.push_back(w.Add(Hexagon(c, 7)));
+	}
+
+	return handles;
+}
+
+// Nudges every step-th shape back and forth so its pairs have to be tested again
+static void Jiggle(CollisionWorld &w, const std::vector<ShapeHandle> &handles, unsigned step, unsigned frame)
+{
+	const Transformation t(Vector2(1, 1), 0, Vector2(frame % 2 ? 0.01f : -0.01f, 0));
+
+	for (unsigned i = frame % step; i < handles.size(); i += step)
+		w.Transform(handles[i], t);
+}
+
+// Argument 0 is the number of shapes, argument 1 the number of workers, zero for no scheduler
+static void BM_WorldStep(benchmark::State &state)
+{
+	CollisionWorld w;
+	const std::vector<ShapeHandle> handles = Fill(w, state.range(0));
+
+	ThreadPool pool(state.range(1) > 0 ? state.range(1) : 1);
+
+	if (state.range(1) > 0)
+		w.SetScheduler(&pool);
+
+	unsigned frame = 0;
+
+	for (auto _ : state)
+	{
+		Jiggle(w, handles, 1, frame++);
+		benchmark::DoNotOptimize(w.Step());
+	}
+
+	state.counters["contacts"] = w.GetContacts().size();
+}
+
+BENCHMARK(BM_WorldStep)->Args({ 4096, 0 })->Args({ 4096, 2 })->Args({ 4096, 4 })->Args({ 4096, 8 })->UseRealTime();
+
+// Argument 0 is the number of shapes, argument 1 moves one shape in that many each step
+static void BM_WorldStepResting(benchmark::State &state)
+{
+	CollisionWorld w;
+	const std::vector<ShapeHandle> handles = Fill(w, state.range(0));
+
+	unsigned frame = 0;
+
+	for (auto _ : state)
+	{
+		Jiggle(w, handles, state.range(1), frame++);
+		benchmark::DoNotOptimize(w.Step());
+	}
+
+	state.counters["tested"] = w.GetTestedCount();
+}
+
+BENCHMARK(BM_WorldStepResting)->Args({ 4096, 1 })->Args({ 4096, 10 })->Args({ 4096, 100 });
+
+// A level of static tiles with a few hundred dynamic shapes, most at rest.
+// Argument 0 is zero to add everything as dynamic and awake, one to use static tiles and a sleep delay.
+static void BM_WorldLevel(benchmark::State &state)
+{
+	CollisionWorld w;
+	const bool partitioned = state.range(0);
+	const MotionType tiles = partitioned ? MOTION_STATIC : MOTION_DYNAMIC;
+
+	for (unsigned y = 0; y < 48; y++)
+	{
+		for (unsigned x = 0; x < 64; x++)
+		{
+			// Floor, walls and scattered platforms
+			if (y == 0 || x == 0 || x == 63 || (y % 6 == 0 && (x / 8) % 2 == y / 6 % 2))
+				w.Add(Hexagon(Vector2(x * 12, y * 12), 7), tiles);
+		}
+	}
+
+	std::vector<ShapeHandle> bodies;
+
+	for (unsigned i = 0; i < 512; i++)
+		bodies.push_back(w.Add(new Circle(Vector2(12 + (i % 60) * 12, 8 + (i / 60) * 12 * 5), 6)));
+
+	if (partitioned)
+		w.SetSleepDelay(2);
+
+	unsigned frame = 0;
+
+	for (auto _ : state)
+	{
+		Jiggle(w, bodies, 16, frame++);
+		benchmark::DoNotOptimize(w.Step());
+	}
+
+	state.counters["pairs"] = w.GetPairCount();
+	state.counters["tested"] = w.GetTestedCount();
+	state.counters["contacts"] = w.GetContacts().size();
+}
+
+BENCHMARK(BM_WorldLevel)->Arg(0)->Arg(1);
+
+// A dense cloud of bullets around a few targets, every bullet moving each step.
+// Argument 0 is zero to let bullets hit bullets and discard those contacts afterwards, one to filter them in the broadphase.
+static void BM_WorldBullets(benchmark::State &state)
+{
+	CollisionWorld w;
+	const bool filtered = state.range(0);
+
+	const CollisionFilter target(1, 0xFFFFFFFF);
+	const CollisionFilter bullet(2, filtered ? ~2u : 0xFFFFFFFF);
+
+	for (unsigned i = 0; i < 16; i++)
+		w.Add(Hexagon(Vector2((i % 4) * 100 + 50, (i / 4) * 100 + 50), 20), MOTION_DYNAMIC, target);
+
+	std::vector<ShapeHandle> bullets;
+
+	for (unsigned i = 0; i < 3000; i++)
+		bullets.push_back(w.Add(new Circle(Vector2(std::fmod(i * 7.31f, 400), std::fmod(i * 3.77f, 400)), 3), MOTION_DYNAMIC, bullet));
+
+	unsigned frame = 0;
+	unsigned hits = 0;
+
+	for (auto _ : state)
+	{
+		Jiggle(w, bullets, 1, frame++);
+		w.Step();
+
+		// Only bullet against target contacts matter
+		hits = 0;
+
+		for (auto && c : w.GetContacts())
+			hits += (c.a.index < 16);
+
+		benchmark::DoNotOptimize(hits);
+	}
+
+	state.counters["pairs"] = w.GetPairCount();
+	state.counters["hits"] = hits;
+}
+
+BENCHMARK(BM_WorldBullets)->Arg(0)->Arg(1);
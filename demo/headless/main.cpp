@@ -0,0 +1,577 @@
+// Runs the demo workloads without a window or SFML, timing every frame.
+//
+// Usage: Crash2D_Stress [--workload broadphase|mtv|world|all] [--scale N] [--frames N] [--seed N] [--quiet] [--trace FILE]
+//                       [--record FILE] [--replay FILE]
+//
+// broadphase: the BroadphaseDemo frame, scale * 2500 random rectangles and a mouse
+//             rectangle scattered again every frame and fed to a SparseSpatialBroadphase.
+// mtv:        the MTVDemo frame, scale copies of every circle, polygon and segment pair,
+//             moving the second shape and resolving it out of the first with GetCollision().
+// world:      scale * 500 circles and boxes wandering over a CollisionWorld, stepped every frame.
+//
+// --record FILE writes the world workload to FILE with a Recorder. --replay FILE runs a recording
+// instead of the workloads, checks every step against the recorded contacts and exits with 2 on a mismatch.
+//
+// Prints workload,frame,milliseconds,result for every frame unless --quiet is given,
+// then the minimum, mean, percentiles and maximum frame time of each workload.
+// A library built with COUNTERS=1 adds the hot path counts of every frame as extra columns.
+// A library built with TRACE=1 writes a Chrome trace of the run to the file given by --trace.
+
+#include <Crash2D/SparseSpatialBroadphase.hpp>
+#include <Crash2D/collision_world.hpp>
+#include <Crash2D/recorder.hpp>
+#include <Crash2D/replayer.hpp>
+#include <Crash2D/box.hpp>
+#include <Crash2D/circle.hpp>
+#include <Crash2D/polygon.hpp>
+#include <Crash2D/segment.hpp>
+#include <Crash2D/collision.hpp>
+#include <Crash2D/counters.hpp>
+#include <Crash2D/trace.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Crash2D;
+
+struct Options
+{
+	std::string workload = "all";
+	unsigned scale = 1;
+	unsigned frames = 600;
+	unsigned seed = 1;
+	bool quiet = false;
+	std::string trace;
+	std::string record;
+	std::string replay;
+};
+
+// A workload sets itself up once, then runs one frame at a time and returns a count to print
+class Workload
+{
+public:
+	virtual ~Workload() = default;
+	virtual const char* GetName() const = 0;
+	virtual const size_t Frame() = 0;
+
+	// Workloads that run out before the frame count, like a replay, stop the run early
+	virtual const bool IsDone() const
+	{
+		return false;
+	}
+};
+
+class BroadphaseWorkload : public Workload
+{
+public:
+	BroadphaseWorkload(const unsigned scale, const unsigned seed) : _random(seed), _broadphase(100, 100), _mouse(0)
+	{
+		// The demo's 800 by 600 window, grown so the density stays the same
+		const double grow = std::sqrt(static_cast<double>(scale));
+		_width = 800 * grow;
+		_height = 600 * grow;
+
+		std::uniform_int_distribution<int> size(5, 15);
+
+		for (unsigned i = 0; i < 2500 * scale; i++)
+			_sizes.push_back({ size(_random), size(_random) });
+	}
+
+	virtual const char* GetName() const override
+	{
+		return "broadphase";
+	}
+
+	virtual const size_t Frame() override
+	{
+		std::uniform_int_distribution<int> x(0, _width), y(0, _height);
+
+		_broadphase.addRectangle(x(_random) - 25, y(_random) - 25, 50, 50, &_mouse);
+
+		for (auto && s : _sizes)
+			_broadphase.addRectangle(x(_random) - s.first / 2, y(_random) - s.second / 2, s.first, s.second, &s);
+
+		// Count what the demo would colour in, the pairs only live for the frame
+		size_t hits = 0;
+		_arena.Reset();
+
+		for (auto && pair : _broadphase.getCollisionPairs(_arena))
+			hits += (pair.first == &_mouse || pair.second == &_mouse);
+
+		_broadphase.clear();
+		return hits;
+	}
+
+private:
+	std::mt19937 _random;
+	SparseSpatialBroadphase _broadphase;
+	FrameArena _arena;
+	std::vector<std::pair<int, int>> _sizes;
+	int _mouse;
+	int _width, _height;
+};
+
+class MTVWorkload : public Workload
+{
+public:
+	MTVWorkload(const unsigned scale, const unsigned seed) : _random(seed)
+	{
+		for (unsigned i = 0; i < scale; i++)
+		{
+			// Every copy sits in its own 1000 unit cell
+			const Vector2 offset((i % 64) * 1000.f, (i / 64) * 1000.f);
+
+			for (unsigned a = 0; a < 3; a++)
+			{
+				for (unsigned b = 0; b < 3; b++)
+					_pairs.push_back({ ShapePtr(MakeA(a, offset)), ShapePtr(MakeB(b, offset)), 0 });
+			}
+		}
+	}
+
+	virtual const char* GetName() const override
+	{
+		return "mtv";
+	}
+
+	virtual const size_t Frame() override
+	{
+		std::uniform_int_distribution<int> dir(-1, 1);
+		size_t overlaps = 0;
+
+		for (auto && p : _pairs)
+		{
+			// The arrow, rotate and scale keys, pressed at random
+			Transformation t;
+			t.Translate(Vector2(dir(_random) * 4, dir(_random) * 4));
+			t.SetPivot(p.b->GetCenter());
+			t.Rotate(dir(_random));
+
+			// Keep the shape within a few key presses of its starting size
+			const int scale = dir(_random);
+
+			if (scale != 0 && std::abs(p.zoom + scale) <= 5)
+			{
+				t.SetScale(Vector2(1 + scale * 0.1f, 1 + scale * 0.1f));
+				p.zoom += scale;
+			}
+
+			p.b->Transform(t);
+
+			const Collision collision = p.a->GetCollision(*p.b);
+			const bool contains = p.a->Contains(*p.b);
+
+			// The demo draws the resolved shape, then moves it back
+			if (collision.Overlaps() || collision.AcontainsB())
+			{
+				Transformation resolve;
+				resolve.Translate(collision.GetDisplacement());
+				p.b->Transform(resolve);
+
+				resolve.Translate(-collision.GetDisplacement() * 2);
+				p.b->Transform(resolve);
+			}
+
+			overlaps += collision.Overlaps() + contains;
+
+			// Bring shapes that wandered off back onto the first shape
+			const Vector2 back = p.a->GetCenter() - p.b->GetCenter();
+
+			if (back.LengthSq() > 300 * 300)
+			{
+				Transformation home;
+				home.Translate(back);
+				p.b->Transform(home);
+			}
+		}
+
+		return overlaps;
+	}
+
+private:
+	using ShapePtr = std::unique_ptr<Shape>;
+
+	// The demo's first shapes
+	static Shape* MakeA(const unsigned kind, const Vector2 &o)
+	{
+		if (kind == 0)
+			return new Circle(o + Vector2(300, 400), 150);
+
+		if (kind == 2)
+			return new Segment(o + Vector2(400, 300), o + Vector2(500, 300));
+
+		return MakePolygon({ o + Vector2(250, 250), o + Vector2(350, 250), o + Vector2(350, 350), o + Vector2(250, 350) });
+	}
+
+	// The demo's second shapes
+	static Shape* MakeB(const unsigned kind, const Vector2 &o)
+	{
+		if (kind == 0)
+			return new Circle(o + Vector2(400, 300), 50);
+
+		if (kind == 2)
+			return new Segment(o + Vector2(450, 250), o + Vector2(450, 350));
+
+		return MakePolygon({ o + Vector2(350, 300), o + Vector2(400, 300), o + Vector2(325, 350) });
+	}
+
+	static Shape* MakePolygon(const std::vector<Vector2> &points)
+	{
+		Polygon *p = new Polygon();
+		p->SetPointCount(points.size());
+
+		for (unsigned i = 0; i < points.size(); i++)
+			p->SetPoint(i, points[i]);
+
+		p->ReCalc();
+		return p;
+	}
+
+	// A fixed shape and the shape moved against it
+	struct Pair
+	{
+		ShapePtr a;
+		ShapePtr b;
+		int zoom; /* Scale key presses so far, grow minus shrink */
+	};
+
+	std::mt19937 _random;
+	std::vector<Pair> _pairs;
+};
+
+class WorldWorkload : public Workload
+{
+public:
+	WorldWorkload(const unsigned scale, const unsigned seed, Recorder *recorder) : _random(seed)
+	{
+		_world.SetRecorder(recorder);
+
+		const double grow = std::sqrt(static_cast<double>(scale));
+		_size = static_cast<float>(1000 * grow);
+
+		std::uniform_real_distribution<float> at(0, _size), size(5, 15);
+
+		for (unsigned i = 0; i < 500 * scale; i++)
+		{
+			const Vector2 c(at(_random), at(_random));
+
+			// One in ten shapes is static scenery that never moves
+			if (i % 10 == 0)
+				_world.Add(new Box(c, Vector2(size(_random), size(_random))), MOTION_STATIC);
+
+			else if (i % 2)
+				_shapes.push_back(_world.Add(new Circle(c, size(_random))));
+
+			else
+				_shapes.push_back(_world.Add(new OrientedBox(c, Vector2(size(_random), size(_random)), at(_random))));
+		}
+	}
+
+	virtual const char* GetName() const override
+	{
+		return "world";
+	}
+
+	virtual const size_t Frame() override
+	{
+		std::uniform_real_distribution<float> step(-2, 2);
+
+		for (auto && h : _shapes)
+		{
+			const Vector2 c = _world.Get(h)->GetCenter();
+
+			// Wander, bouncing off the edges of the area
+			Vector2 d(step(_random), step(_random));
+
+			if (c.x + d.x < 0 || c.x + d.x > _size)
+				d.x = -d.x;
+
+			if (c.y + d.y < 0 || c.y + d.y > _size)
+				d.y = -d.y;
+
+			Transformation t;
+			t.Translate(d);
+			_world.Transform(h, t);
+		}
+
+		return _world.Step();
+	}
+
+private:
+	std::mt19937 _random;
+	CollisionWorld _world;
+	std::vector<ShapeHandle> _shapes;
+	float _size;
+};
+
+// Plays a recording back a step per frame, counting the steps that found other contacts
+class ReplayWorkload : public Workload
+{
+public:
+	ReplayWorkload(std::istream &in) : _replayer(in), _done(false), _mismatches(0)
+	{
+	}
+
+	virtual const char* GetName() const override
+	{
+		return "replay";
+	}
+
+	virtual const size_t Frame() override
+	{
+		ReplayStep step;
+
+		if (!_replayer.Next(_world, step))
+		{
+			_done = true;
+			return 0;
+		}
+
+		if (!step.Matches())
+		{
+			std::fprintf(stderr, "Step found %u contacts, the recording %u\n", step.contacts, step.expectedContacts);
+			_mismatches++;
+		}
+
+		return step.contacts;
+	}
+
+	virtual const bool IsDone() const override
+	{
+		return _done;
+	}
+
+	const std::string& GetError() const
+	{
+		return _replayer.GetError();
+	}
+
+	const unsigned GetMismatches() const
+	{
+		return _mismatches;
+	}
+
+private:
+	Replayer _replayer;
+	CollisionWorld _world;
+	bool _done;
+	unsigned _mismatches;
+};
+
+static void Usage()
+{
+	std::fprintf(stderr, "Usage: Crash2D_Stress [--workload broadphase|mtv|world|all] [--scale N] [--frames N] [--seed N] [--quiet] [--trace FILE]\n"
+		"                      [--record FILE] [--replay FILE]\n");
+}
+
+static bool Parse(int argc, char **argv, Options &options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const char *arg = argv[i];
+		const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+		if (std::strcmp(arg, "--quiet") == 0)
+		{
+			options.quiet = true;
+			continue;
+		}
+
+		if (!value)
+			return false;
+
+		if (std::strcmp(arg, "--workload") == 0)
+			options.workload = value;
+
+		else if (std::strcmp(arg, "--scale") == 0)
+			options.scale = std::max(1, std::atoi(value));
+
+		else if (std::strcmp(arg, "--frames") == 0)
+			options.frames = std::max(1, std::atoi(value));
+
+		else if (std::strcmp(arg, "--seed") == 0)
+			options.seed = std::atoi(value);
+
+		else if (std::strcmp(arg, "--trace") == 0)
+			options.trace = value;
+
+		else if (std::strcmp(arg, "--record") == 0)
+			options.record = value;
+
+		else if (std::strcmp(arg, "--replay") == 0)
+			options.replay = value;
+
+		else
+			return false;
+
+		i++;
+	}
+
+	return (options.workload == "all" || options.workload == "broadphase" || options.workload == "mtv" || options.workload == "world");
+}
+
+static double Percentile(const std::vector<double> &sorted, const double p)
+{
+	const size_t i = std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()));
+	return sorted[i];
+}
+
+static void Run(Workload &w, const Options &options)
+{
+	std::vector<double> times;
+	times.reserve(std::min(options.frames, 100000u));
+
+	for (unsigned frame = 0; frame < options.frames; frame++)
+	{
+		const Counters counts = GetCounters();
+		const auto start = std::chrono::steady_clock::now();
+		size_t result;
+
+		{
+			CRASH2D_ZONE("Frame");
+			result = w.Frame();
+		}
+
+		const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		if (w.IsDone())
+			break;
+
+		times.push_back(ms);
+
+		if (options.quiet)
+			continue;
+
+		std::printf("%s,%u,%.4f,%zu", w.GetName(), frame, ms, result);
+
+		if (CountersEnabled())
+		{
+			const Counters frameCounts = GetCounters() - counts;
+
+			for (unsigned c = 0; c < COUNTER_COUNT; c++)
+				std::printf(",%llu", static_cast<unsigned long long>(frameCounts.values[c]));
+		}
+
+		std::printf("\n");
+	}
+
+	if (times.empty())
+		return;
+
+	std::sort(times.begin(), times.end());
+
+	double total = 0;
+
+	for (auto && t : times)
+		total += t;
+
+	std::printf("# %s scale=%u frames=%u min=%.4f mean=%.4f p50=%.4f p90=%.4f p99=%.4f max=%.4f ms\n",
+		w.GetName(), options.scale, static_cast<unsigned>(times.size()), times.front(), total / times.size(),
+		Percentile(times, 0.5), Percentile(times, 0.9), Percentile(times, 0.99), times.back());
+}
+
+int main(int argc, char **argv)
+{
+	Options options;
+
+	if (!Parse(argc, argv, options))
+	{
+		Usage();
+		return 1;
+	}
+
+	if (!options.quiet)
+	{
+		std::printf("workload,frame,ms,result");
+
+		if (CountersEnabled())
+		{
+			for (unsigned c = 0; c < COUNTER_COUNT; c++)
+				std::printf(",%s", Counters::GetName(static_cast<Counter>(c)));
+		}
+
+		std::printf("\n");
+	}
+
+	int status = 0;
+
+	if (!options.replay.empty())
+	{
+		std::ifstream in(options.replay, std::ios::binary);
+		ReplayWorkload w(in);
+
+		// A replay runs until the recording ends
+		Options all = options;
+		all.frames = std::numeric_limits<unsigned>::max();
+		Run(w, all);
+
+		if (!w.GetError().empty())
+		{
+			std::fprintf(stderr, "%s: %s\n", options.replay.c_str(), w.GetError().c_str());
+			status = 1;
+		}
+
+		else if (w.GetMismatches())
+		{
+			std::fprintf(stderr, "%u steps did not match the recording\n", w.GetMismatches());
+			status = 2;
+		}
+	}
+
+	else
+	{
+		if (options.workload == "all" || options.workload == "broadphase")
+		{
+			BroadphaseWorkload w(options.scale, options.seed);
+			Run(w, options);
+		}
+
+		if (options.workload == "all" || options.workload == "mtv")
+		{
+			MTVWorkload w(options.scale, options.seed);
+			Run(w, options);
+		}
+
+		if (options.workload == "all" || options.workload == "world")
+		{
+			std::ofstream out;
+			std::unique_ptr<Recorder> recorder;
+
+			if (!options.record.empty())
+			{
+				out.open(options.record, std::ios::binary);
+				recorder.reset(new Recorder(out));
+			}
+
+			WorldWorkload w(options.scale, options.seed, recorder.get());
+			Run(w, options);
+
+			if (recorder && !recorder->IsGood())
+			{
+				std::fprintf(stderr, "Could not record to %s\n", options.record.c_str());
+				status = 1;
+			}
+		}
+	}
+
+	if (!options.trace.empty())
+	{
+		if (!TracingEnabled())
+			std::fprintf(stderr, "Tracing is off, rebuild with TRACE=1 to record spans\n");
+
+		std::ofstream out(options.trace);
+		WriteTrace(out);
+	}
+
+	return status;
+}
@@ -3,8 +3,16 @@
 
 #include "circle.hpp"
 #include "polygon.hpp"
+#include "polygon_instance.hpp"
 #include "segment.hpp"
+#include "oriented_box.hpp"
+#include "box.hpp"
+#include "capsule.hpp"
+#include "edge_table.hpp"
 #include "collision.hpp"
+#include "collision_world.hpp"
+#include "thread_pool.hpp"
 #include "projection.hpp"
+#include "affine_matrix.hpp"
 
 #endif
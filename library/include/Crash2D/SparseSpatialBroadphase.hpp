@@ -10,7 +10,15 @@
 #define SPARSESPATIALBROADPHASE_H
 
 #include "AxisAlignedBoundingBox.hpp"
-
+#include "collision_filter.hpp"
+#include "counters.hpp"
+#include "memory.hpp"
+#include "arena.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <iterator>
 #include <unordered_map>
 #include <unordered_set>
@@ -21,12 +29,26 @@ struct Point {
 
 	friend inline bool operator==(Point const& lhs, Point const& rhs)
 	{
-		return (lhs.x == rhs.x) && (lhs.y == lhs.y);
+		return (lhs.x == rhs.x) && (lhs.y == rhs.y);
 	}
 };
 
+// Pairs come back in hash order, which varies between runs. Use Crash2D::SweepBroadphase
+// or Crash2D::CollisionWorld where results must be reproducible.
 class SparseSpatialBroadphase {
-	typedef std::pair<void *const, const AABB> Proxy;
+	struct Proxy {
+		void *userdata;
+		AABB aabb;
+		Crash2D::CollisionFilter filter;
+
+		Proxy(void *const userdata, const AABB &aabb, const Crash2D::CollisionFilter &filter) :
+			userdata(userdata), aabb(aabb), filter(filter) {}
+
+		friend inline bool operator==(Proxy const& lhs, Proxy const& rhs)
+		{
+			return (lhs.userdata == rhs.userdata) && (lhs.aabb == rhs.aabb);
+		}
+	};
 	typedef std::pair<void *const, void *const> CollisionPair;
 
 	struct PointHash {
@@ -35,24 +57,77 @@ class SparseSpatialBroadphase {
 		}
 	};
 
+	// Hash the userdata the entries point to, not where the entries live,
+	// so equal proxies and pairs land in the same bucket
 	struct ProxyHash {
 		inline std::size_t operator()(const Proxy &v) const {
-			uintptr_t ad = (uintptr_t) &v;
+			uintptr_t ad = (uintptr_t) v.userdata;
 			return (size_t) ((13*ad) ^ (ad >> 15));
 		}
 	};
 
 	struct CollisionPairHash {
 		inline std::size_t operator()(const CollisionPair &v) const {
-			uintptr_t ad = (uintptr_t) &v;
-			return (size_t) ((13*ad) ^ (ad >> 15));
+			uintptr_t a = (uintptr_t) v.first, b = (uintptr_t) v.second;
+			return (size_t) ((13*a) ^ (b >> 15) ^ (b * 31));
 		}
 	};
 
+	template <typename T>
+	using Allocator = Crash2D::TaggedAllocator<T, Crash2D::MEMORY_BROADPHASE>;
+
+	typedef std::unordered_set<Proxy, ProxyHash, std::equal_to<Proxy>, Allocator<Proxy>> Cell;
+	typedef std::unordered_map<Point, Cell, PointHash, std::equal_to<Point>, Allocator<std::pair<const Point, Cell>>> CellMap;
+
+	// A hash node holds the value, the link to the next node and the cached hash
+	template <typename T>
+	static constexpr std::size_t nodeSize() {
+		return sizeof(T) + sizeof(void*) + sizeof(std::size_t);
+	}
+
 	int cell_width, cell_height;
-	std::unordered_map<Point, std::unordered_set<Proxy, ProxyHash>, PointHash> cells;
+	CellMap cells;
+
+	template <typename Set>
+	void findCollisionPairs(Set &collisionPairs) const {
+		CRASH2D_ZONE("Spatial hash pairs");
+		for (const auto &cell : cells) {
+			CRASH2D_COUNT(COUNTER_CELL_VISITS, 1);
+			for (auto proxyIt = cell.second.cbegin(); proxyIt != cell.second.cend();) {
+				const auto &proxy = *proxyIt;
+				for (auto otherIt = ++proxyIt; otherIt != cell.second.cend(); ++otherIt) {
+					const auto &other = *otherIt;
+					// Rejected pairs are dropped before they are hashed
+					if (!proxy.filter.Accepts(other.filter))
+						continue;
+
+					CRASH2D_COUNT(COUNTER_BOUNDS_TESTS, 1);
+					if (!proxy.aabb.intersectsAABB(other.aabb))
+						continue;
+
+					// Order each pair so one found in several cells is only reported once
+					collisionPairs.insert(std::less<void*>()(proxy.userdata, other.userdata) ?
+						CollisionPair(proxy.userdata, other.userdata) : CollisionPair(other.userdata, proxy.userdata));
+				}
+			}
+		}
+	}
 
 public:
+	// Pairs drawn from a frame arena, valid until the arena is reset
+	typedef std::unordered_set<CollisionPair, CollisionPairHash, std::equal_to<CollisionPair>,
+		Crash2D::ArenaAllocator<CollisionPair>> ArenaCollisionPairs;
+
+	// What the cells hold, to pick a cell size that keeps both the cell count and the proxies per cell low
+	struct MemoryUsage {
+		std::size_t cells; // Cells holding at least one proxy
+		std::size_t proxies; // Proxies over all cells, a rectangle counts once per cell it covers
+		std::size_t maxProxies; // Proxies in the fullest cell
+		std::size_t buckets; // Buckets of the cell table
+		float loadFactor; // Cells per bucket of the cell table
+		std::size_t bytes; // Estimated heap bytes of the cells and proxies
+	};
+
 	SparseSpatialBroadphase() : cell_width(1), cell_height(1) {};
 	SparseSpatialBroadphase(int cell_width, int cell_height) :
 		cell_width(cell_width), cell_height(cell_height) {}
@@ -78,33 +153,45 @@ public:
 		return cell_height;
 	}
 
-	void addPoint(const int x, const int y, void *const userdata) {
-		cells[Point(x / cell_width, y / cell_height)].insert(Proxy(userdata, AABB(x, y, 1, 1)));
+	void addPoint(const int x, const int y, void *const userdata,
+			const Crash2D::CollisionFilter &filter = Crash2D::CollisionFilter()) {
+		cells[Point(x / cell_width, y / cell_height)].insert(Proxy(userdata, AABB(x, y, 1, 1), filter));
 	}
 
 	void addRectangle(
-			const int x, const int y, const int width, const int height, void *const userdata) {
+			const int x, const int y, const int width, const int height, void *const userdata,
+			const Crash2D::CollisionFilter &filter = Crash2D::CollisionFilter()) {
 		int xx = x / cell_width, yy = y / cell_height;
 		for (int i = xx; i < ((x + width) / cell_width) + 1; ++i) {
 			for (int ii = yy; ii < ((y + height) / cell_height) + 1; ++ii) {
-				cells[Point(i, ii)].insert(Proxy(userdata, AABB(x, y, width, height)));
+				cells[Point(i, ii)].insert(Proxy(userdata, AABB(x, y, width, height), filter));
 			}
 		}
 	}
 
 	const std::unordered_set<CollisionPair, CollisionPairHash> getCollisionPairs() {
 		std::unordered_set<CollisionPair, CollisionPairHash> collisionPairs;
+		findCollisionPairs(collisionPairs);
+		return collisionPairs;
+	}
+
+	// Finds the pairs without touching the heap once the arena has grown to a frame's needs
+	ArenaCollisionPairs getCollisionPairs(Crash2D::FrameArena &arena) {
+		ArenaCollisionPairs collisionPairs(0, CollisionPairHash(), std::equal_to<CollisionPair>(),
+			Crash2D::ArenaAllocator<CollisionPair>(arena));
+		findCollisionPairs(collisionPairs);
+		return collisionPairs;
+	}
+
+	MemoryUsage getMemoryUsage() const {
+		MemoryUsage usage = { cells.size(), 0, 0, cells.bucket_count(), cells.load_factor(), 0 };
+		usage.bytes = cells.bucket_count() * sizeof(void*) + cells.size() * nodeSize<CellMap::value_type>();
 		for (const auto &cell : cells) {
-			for (auto proxyIt = cell.second.cbegin(); proxyIt != cell.second.cend();) {
-				const auto &proxy = *proxyIt;
-				for (auto otherIt = ++proxyIt; otherIt != cell.second.cend(); ++otherIt) {
-					const auto &other = *otherIt;
-					if (proxy.second.intersectsAABB(other.second))
-						collisionPairs.insert(CollisionPair(proxy.first, other.first));
-				}
-			}
+			usage.proxies += cell.second.size();
+			usage.maxProxies = std::max(usage.maxProxies, cell.second.size());
+			usage.bytes += cell.second.bucket_count() * sizeof(void*) + cell.second.size() * nodeSize<Proxy>();
 		}
-		return collisionPairs;
+		return usage;
 	}
 
 	void clear() {
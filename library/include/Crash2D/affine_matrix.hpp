@@ -0,0 +1,99 @@
+#ifndef CRASH2D_AFFINE_MATRIX_HPP
+#define CRASH2D_AFFINE_MATRIX_HPP
+
+#include <Crash2D/transformation.hpp>
+
+namespace Crash2D
+{
+//!  A class representing a 2D affine transformation as a 2x3 matrix. */
+/*!
+	A point (x, y) maps to (a * x + c * y + tx, b * x + d * y + ty). Unlike Transformation,
+	matrices can be composed, so a chain of nested transformations can be applied to a
+	shape's points in a single pass.
+*/
+class AffineMatrix
+{
+public:
+	Precision_t a; /*!< The x component of the transformed x axis. */
+	Precision_t b; /*!< The y component of the transformed x axis. */
+	Precision_t c; /*!< The x component of the transformed y axis. */
+	Precision_t d; /*!< The y component of the transformed y axis. */
+	Precision_t tx; /*!< The x component of the translation. */
+	Precision_t ty; /*!< The y component of the translation. */
+
+	//! Constructs an identity matrix.
+	/*!
+	*/
+	AffineMatrix();
+
+	//! Constructs a matrix from its six components.
+	/*!
+		\param a The x component of the transformed x axis.
+		\param b The y component of the transformed x axis.
+		\param c The x component of the transformed y axis.
+		\param d The y component of the transformed y axis.
+		\param tx The x component of the translation.
+		\param ty The y component of the translation.
+	*/
+	AffineMatrix(const Precision_t a, const Precision_t b, const Precision_t c, const Precision_t d, const Precision_t tx, const Precision_t ty);
+
+	//! Constructs the matrix equivalent to a transformation.
+	/*!
+		Scales and then rotates about the transformation's pivot, then translates,
+		in the same order as Shape::Transform().
+		\param t The transformation to convert.
+	*/
+	explicit AffineMatrix(const Transformation &t);
+
+	//! Combines this matrix with another and returns the result.
+	/*!
+		\param m The matrix to apply first.
+		\return A matrix that applies m and then this matrix.
+	*/
+	const AffineMatrix Compose(const AffineMatrix &m) const;
+
+	//! Calculates the inverse of this matrix and returns the result.
+	/*!
+		\return The matrix that undoes this matrix, or a zero matrix if this matrix is singular.
+	*/
+	const AffineMatrix Inverse() const;
+
+	//! Calculates the determinant of the linear part of this matrix and returns the result.
+	/*!
+		\return The determinant of this matrix.
+	*/
+	const Precision_t GetDeterminant() const;
+
+	//! Applies this matrix to a point and returns the result.
+	/*!
+		\param p The point to transform.
+		\return The transformed point.
+	*/
+	const Vector2 TransformPoint(const Vector2 &p) const;
+
+	//! Applies this matrix to an array of points.
+	/*!
+		Four points are transformed per step. in and out may be the same array.
+		\param in The points to transform.
+		\param out Receives the transformed points.
+		\param n The number of points.
+	*/
+	void TransformPoints(const Vector2 *in, Vector2 *out, const unsigned n) const;
+
+	//! Applies this matrix to every point in a vector.
+	/*!
+		\param points The points to transform in place.
+	*/
+	void TransformPoints(std::vector<Vector2> &points) const;
+
+	//! Multiplication Operator override, the same as Compose().
+	/*!
+	*/
+	inline const AffineMatrix operator * (const AffineMatrix &m) const
+	{
+		return Compose(m);
+	}
+};
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef CRASH2D_ARENA_HPP
+#define CRASH2D_ARENA_HPP
+
+#include <Crash2D/memory.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace Crash2D
+{
+const size_t ARENA_BLOCK_SIZE = 64 * 1024; /*!< The default size of the blocks an arena draws from the allocator. */
+
+//!  A bump allocator for results that only live until the end of a frame. */
+/*!
+	Allocation moves a pointer through a block, freeing does nothing, and Reset() rewinds
+	every block at once. Blocks are kept across resets, so once the arena has grown to a frame's
+	needs a frame allocates nothing. Blocks come from Allocate() under MEMORY_ARENAS.
+
+	An arena is used by one thread at a time. Everything allocated from it must be
+	destroyed or abandoned before Reset() is called.
+*/
+class FrameArena
+{
+public:
+	//! Constructs an empty arena.
+	/*!
+		\param blockSize The size of each block, allocations larger than it get a block of their own.
+	*/
+	FrameArena(const size_t blockSize = ARENA_BLOCK_SIZE);
+
+	//! Returns every block to the allocator.
+	~FrameArena();
+
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator = (const FrameArena&) = delete;
+
+	//! Allocates memory that stays valid until the next Reset().
+	/*!
+		\param bytes The number of bytes.
+		\param align The alignment, a power of two no larger than alignof(std::max_align_t).
+		\return The memory.
+	*/
+	void* Allocate(const size_t bytes, const size_t align);
+
+	//! Makes all memory of this arena available again, keeping its blocks.
+	void Reset();
+
+	//! Gets the bytes handed out since the last reset.
+	/*!
+		\return The bytes, including alignment padding.
+	*/
+	const size_t GetUsed() const;
+
+	//! Gets the bytes of every block this arena holds.
+	/*!
+		\return The bytes.
+	*/
+	const size_t GetCapacity() const;
+
+protected:
+	//! A block drawn from the allocator.
+	struct Block
+	{
+		char *data; /*!< The memory of the block. */
+		size_t size; /*!< The size of the block. */
+	};
+
+	std::vector<Block> _blocks; /*!< Every block, in the order they are filled. */
+	size_t _blockSize; /*!< The size of new blocks. */
+	size_t _current; /*!< The block being filled. */
+	size_t _offset; /*!< The first free byte of the block being filled. */
+	size_t _used; /*!< The bytes handed out since the last reset, not counting the block being filled. */
+};
+
+//!  A standard library allocator that draws from a FrameArena. */
+/*!
+	Containers using it must be destroyed or abandoned before the arena is reset.
+	Deallocation does nothing, memory returns when the arena is reset.
+*/
+template <typename T>
+class ArenaAllocator
+{
+public:
+	typedef T value_type;
+
+	template <typename U>
+	struct rebind
+	{
+		typedef ArenaAllocator<U> other;
+	};
+
+	//! Constructs an allocator drawing from the given arena.
+	/*!
+		\param arena The arena, which must outlive every container using this allocator.
+	*/
+	ArenaAllocator(FrameArena &arena) : _arena(&arena) {}
+
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U> &a) : _arena(a.GetArena()) {}
+
+	inline T* allocate(const size_t n)
+	{
+		return static_cast<T*>(_arena->Allocate(n * sizeof(T), alignof(T)));
+	}
+
+	inline void deallocate(T*, const size_t)
+	{
+	}
+
+	inline FrameArena* GetArena() const
+	{
+		return _arena;
+	}
+
+	template <typename U>
+	inline bool operator == (const ArenaAllocator<U> &a) const
+	{
+		return (_arena == a.GetArena());
+	}
+
+	template <typename U>
+	inline bool operator != (const ArenaAllocator<U> &a) const
+	{
+		return (_arena != a.GetArena());
+	}
+
+private:
+	FrameArena *_arena; /*!< The arena drawn from. */
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>; /**< A vector drawing from a FrameArena. */
+}
+
+#endif
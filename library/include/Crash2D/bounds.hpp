@@ -0,0 +1,53 @@
+#ifndef CRASH2D_BOUNDS_HPP
+#define CRASH2D_BOUNDS_HPP
+
+#include <Crash2D/vector2.hpp>
+
+namespace Crash2D
+{
+class Shape;
+
+//!  A class representing an axis aligned bounding box. */
+class Bounds
+{
+public:
+	Vector2 min; /*!< The corner with the smallest coordinates. */
+	Vector2 max; /*!< The corner with the largest coordinates. */
+
+	//! Constructs an empty bounding box at the origin.
+	/*!
+	*/
+	Bounds();
+
+	//! Constructs a bounding box from its corners.
+	/*!
+		\param min The corner with the smallest coordinates.
+		\param max The corner with the largest coordinates.
+	*/
+	Bounds(const Vector2 &min, const Vector2 &max);
+
+	//! Constructs the bounding box of a shape.
+	/*!
+		The shape is projected onto the x and y axes.
+		\param s The shape to bound.
+	*/
+	explicit Bounds(const Shape &s);
+
+	//! Checks for overlap between this bounding box and the given bounding box.
+	/*!
+		Boxes that only touch overlap.
+		\param b The bounding box to test against.
+		\return True if the boxes overlap.
+	*/
+	const bool Overlaps(const Bounds &b) const;
+
+	//! Checks if this bounding box contains the given bounding box.
+	/*!
+		\param b The bounding box to check for containment.
+		\return True if b lies within this box.
+	*/
+	const bool Contains(const Bounds &b) const;
+};
+}
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef CRASH2D_BOX_HPP
+#define CRASH2D_BOX_HPP
+
+#include <Crash2D/oriented_box.hpp>
+
+namespace Crash2D
+{
+//!  A class representing an axis-aligned rectangle shape. */
+/*!
+	A box always stays aligned to the x and y axes. Box versus box queries reduce to two interval tests.
+*/
+class Box : public OrientedBox
+{
+public:
+	using OrientedBox::Overlaps;
+	using OrientedBox::GetDisplacement;
+	using OrientedBox::GetCollision;
+
+	//! Constructs an empty box at the origin.
+	/*!
+	*/
+	Box();
+
+	//! Destructor.
+	/*!
+	*/
+	virtual ~Box() = default;
+
+	//! Constructs a box from its center and half extents.
+	/*!
+		\param c The center of the new box.
+		\param e The half width and half height of the new box.
+	*/
+	Box(const Vector2 &c, const Vector2 &e);
+
+	//! Checks if this shape intersects the given shape and returns the result.
+	/*!
+		\param s The shape to check for intersection with this shape.
+		\return Whether this shape intersects the given shape.
+		\sa GetCollision()
+	*/
+	virtual const bool Overlaps(const Shape &s) const override;
+
+	//! Checks if this box intersects the given box and returns the result.
+	/*!
+		\param b The box to check for intersection with this box.
+		\return Whether this box intersects the given box.
+		\sa GetCollision()
+	*/
+	virtual const bool Overlaps(const Box &b) const override;
+
+	//! Gets the minimum vector to be applied to the given shape's position
+	//! in order to seperate it from this shape.
+	/*!
+		\param s A shape intersecting this shape.
+		\return the minimum displacement vector.
+		\sa GetCollision()
+	*/
+	virtual const Vector2 GetDisplacement(const Shape &s) const override;
+
+	//! Gets the minimum vector to be applied to the given box's position
+	//! in order to seperate it from this box.
+	/*!
+		\param b A box intersecting this box.
+		\return the minimum displacement vector.
+		\sa GetCollision()
+	*/
+	virtual const Vector2 GetDisplacement(const Box &b) const override;
+
+	//! Gets the minimum vector to be applied to the given shape's position
+	//! in order to seperate it from this box, and whether the two overlap.
+	/*!
+		\param s The shape to check against this box.
+		\param overlaps Receives the result of Overlaps(s).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Shape &s, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given box's position
+	//! in order to seperate it from this box, and whether the two overlap.
+	/*!
+		\param b The box to check against this box.
+		\param overlaps Receives the result of Overlaps(b).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Box &b, bool &overlaps) const override;
+
+	//! Gets the collision of this shape with the given shape and returns the result.
+	/*!
+		\param s The shape to check for collision with this shape.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Shape &s) const override;
+
+	//! Gets the collision of this box with the given box and returns the result.
+	/*!
+		\param b The box to check for collision with this box.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Box &b) const override;
+
+	//! Applies a transformation to this box.
+	/*!
+		The box is scaled and translated, and its center is rotated about the pivot. The box itself is never
+		rotated, use OrientedBox for that.
+		\param t The transformation to be applied.
+	*/
+	virtual void Transform(const Transformation &t) override;
+
+	//! Method required to be called after updating the geometry of a shape.
+	/*!
+		Rebuilds the box as the bounds of its four points.
+	*/
+	virtual void ReCalc() override;
+
+	//! Clone Method.
+	/*!
+	*/
+	virtual Shape* Clone() override;
+
+protected:
+	//! Finds the minimum displacement of the given box out of this box.
+	/*!
+		\param b The box to test against.
+		\param overlap Receives the signed overlap along the axis of least penetration.
+		\return The minimum displacement vector, or 0,0 if the boxes are separated.
+	*/
+	const Vector2 Separate(const Box &b, Precision_t &overlap) const;
+};
+}
+
+#endif
@@ -0,0 +1,433 @@
+#ifndef CRASH2D_CAPSULE_HPP
+#define CRASH2D_CAPSULE_HPP
+
+#include <Crash2D/shape_impl.hpp>
+
+namespace Crash2D
+{
+//!  A class representing a capsule shape. */
+/*!
+	A capsule is every point within a radius of a segment, its spine. The two points of a capsule are the end
+	points of the spine.
+*/
+class Capsule : public ShapeImpl
+{
+public:
+	using ShapeImpl::GetIntersects;
+	using ShapeImpl::GetCollision;
+
+	//! Constructs a capsule with radius 0 at the origin.
+	/*!
+	*/
+	Capsule();
+
+	//! Destructor.
+	/*!
+	*/
+	virtual ~Capsule() = default;
+
+	//! Constructs a capsule around the segment between the two points.
+	/*!
+		\param a The first end point of the spine.
+		\param b The second end point of the spine.
+		\param r The radius of the new capsule.
+	*/
+	Capsule(const Vector2 &a, const Vector2 &b, const Precision_t r);
+
+	//! Sets the radius of this capsule.
+	/*!
+	*/
+	virtual void SetRadius(const Precision_t r);
+
+	//! Gets the radius of this capsule.
+	/*!
+		\return The radius of this capsule.
+	*/
+	virtual const Precision_t& GetRadius() const;
+
+	//! Gets the axis of this capsule's spine.
+	/*!
+		The axis of the spine is precalculated as the normal perpendicular to the spine.
+		\return The axis of this capsule's spine.
+	*/
+	virtual const Axis& GetAxis() const;
+
+	//! Calculates the nearest point on the spine to the given point.
+	/*!
+		\param p The point given to be used in the calculation.
+		\return The calculated point.
+	*/
+	virtual const Vector2 GetNearestPoint(const Vector2 &p) const;
+
+	//! Gets the distance from the spine of this capsule to the given point and returns the result.
+	/*!
+		\param p The point to get the distance of the spine to.
+		\return The distance of the spine to the given point.
+	*/
+	virtual const Precision_t DistancePoint(const Vector2 &p) const;
+
+	//! Projects the capsule onto the given axis and returns the projection.
+	/*!
+		\param a The axis to project the capsule onto.
+		\return The projection of the capsule onto the axis.
+	*/
+	virtual const Projection Project(const Axis &a) const override;
+
+	//! Projects the shape onto the given axis and returns the projection.
+	/*!
+		\param s The shape to project.
+		\param a The axis to project the shape onto.
+		\return The projection of the shape onto the axis.
+	*/
+	virtual const Projection Project(const Shape &s, const Axis &a) const override;
+
+	//! Checks if this capsule contains the given vector and returns the result.
+	/*!
+		\param v The vector to check for containment in this capsule.
+		\return Whether this capsule contains the given vector.
+	*/
+	virtual const bool Contains(const Vector2 &v) const override;
+
+	//! Checks if this shape contains the given shape and returns the result.
+	/*!
+		\param s The shape to check for containment in this shape.
+		\return Whether this shape contains the given vector.
+	*/
+	virtual const bool Contains(const Shape &s) const override;
+
+	//! Checks if this capsule contains the given segment and returns the result.
+	/*!
+		\param s The segment to check for containment in this capsule.
+		\return Whether this capsule contains the given segment.
+		\sa GetCollision()
+	*/
+	virtual const bool Contains(const Segment &s) const override;
+
+	//! Checks if this capsule contains the given circle and returns the result.
+	/*!
+		This function will not check if the given circle contains this capsule, GetCollision() can be used for that.
+		\param c The circle to check for containment in this capsule.
+		\return Whether this capsule contains the given circle.
+		\sa GetCollision()
+	*/
+	virtual const bool Contains(const Circle &c) const override;
+
+	//! Checks if this capsule contains the given polygon and returns the result.
+	/*!
+		This function will not check if the given polygon contains this capsule, GetCollision() can be used for that.
+		\param p The polygon to check for containment in this capsule.
+		\return Whether this capsule contains the given polygon.
+		\sa GetCollision()
+	*/
+	virtual const bool Contains(const Polygon &p) const override;
+
+	//! Checks if this capsule contains the given capsule and returns the result.
+	/*!
+		This function will not check if the given capsule contains this capsule, GetCollision() can be used for that.
+		\param c The capsule to check for containment in this capsule.
+		\return Whether this capsule contains the given capsule.
+		\sa GetCollision()
+	*/
+	virtual const bool Contains(const Capsule &c) const override;
+
+	//! Checks if this shape is contained inside the given shape and returns the result.
+	/*!
+		\param s The shape to check if this shape is contained inside.
+		\return Whether this shape is contained inside the given shape.
+	*/
+	virtual const bool IsInside(const Shape &s) const override;
+
+	//! Checks if this shape is contained inside the given segment and returns the result.
+	/*!
+		\param s The segment to check if this shape is contained inside.
+		\return Whether this shape is contained inside the given segment.
+	*/
+	virtual const bool IsInside(const Segment &s) const override;
+
+	//! Checks if this shape is contained inside the given circle and returns the result.
+	/*!
+		\param c The circle to check if this shape is contained inside.
+		\return Whether this shape is contained inside the given circle.
+	*/
+	virtual const bool IsInside(const Circle &c) const override;
+
+	//! Checks if this shape is contained inside the given polygon and returns the result.
+	/*!
+		\param p The polygon to check if this shape is contained inside.
+		\return Whether this shape is contained inside the given polygon.
+	*/
+	virtual const bool IsInside(const Polygon &p) const override;
+
+	//! Checks if this shape is contained inside the given capsule and returns the result.
+	/*!
+		\param c The capsule to check if this shape is contained inside.
+		\return Whether this shape is contained inside the given capsule.
+	*/
+	virtual const bool IsInside(const Capsule &c) const override;
+
+	//! Checks if this shape intersects the given shape and returns the result.
+	/*!
+		\param s The shape to check for intersection with this shape.
+		\return Whether this shape intersects the given shape.
+		\sa GetCollision()
+	*/
+	virtual const bool Overlaps(const Shape &s) const override;
+
+	//! Checks if this capsule intersects the given segment and returns the result.
+	/*!
+		\param s The segment to check for intersection with this capsule.
+		\return Whether this capsule intersects the given segment.
+		\sa GetCollision()
+	*/
+	virtual const bool Overlaps(const Segment &s) const override;
+
+	//! Checks if this capsule intersects the given circle and returns the result.
+	/*!
+		\param c The circle to check for intersection with this capsule.
+		\return Whether this capsule intersects the given circle.
+		\sa GetCollision()
+	*/
+	virtual const bool Overlaps(const Circle &c) const override;
+
+	//! Checks if this capsule intersects the given polygon and returns the result.
+	/*!
+		\param p The polygon to check for intersection with this capsule.
+		\return Whether this capsule intersects the given polygon.
+		\sa GetCollision()
+	*/
+	virtual const bool Overlaps(const Polygon &p) const override;
+
+	//! Checks if this capsule intersects the given capsule and returns the result.
+	/*!
+		\param c The capsule to check for intersection with this capsule.
+		\return Whether this capsule intersects the given capsule.
+		\sa GetCollision()
+	*/
+	virtual const bool Overlaps(const Capsule &c) const override;
+
+	//! Gets the intersection points of this shape and the given shape.
+	/*!
+		\param s A shape intersecting this shape.
+		\return list of intersections between this shape and the given shape.
+		\sa GetCollision()
+	*/
+	virtual const std::vector<Vector2> GetIntersects(const Shape &s) const override;
+
+	//! Gets the intersection points of this capsule and the given segment.
+	/*!
+		\param s A segment intersecting this capsule.
+		\return list of intersections between this capsule and the given segment.
+		\sa GetCollision()
+	*/
+	virtual const std::vector<Vector2> GetIntersects(const Segment &s) const override;
+
+	//! Gets the intersection points of this capsule and the given circle.
+	/*!
+		\param c A circle intersecting this capsule.
+		\return list of intersections between this capsule and the given circle.
+		\sa GetCollision()
+	*/
+	virtual const std::vector<Vector2> GetIntersects(const Circle &c) const override;
+
+	//! Gets the intersection points of this capsule and the given polygon.
+	/*!
+		\param p A polygon intersecting this capsule.
+		\return list of intersections between this capsule and the given polygon.
+		\sa GetCollision()
+	*/
+	virtual const std::vector<Vector2> GetIntersects(const Polygon &p) const override;
+
+	//! Gets the intersection points of this capsule and the given capsule.
+	/*!
+		\param c A capsule intersecting this capsule.
+		\return list of intersections between this capsule and the given capsule.
+		\sa GetCollision()
+	*/
+	virtual const std::vector<Vector2> GetIntersects(const Capsule &c) const override;
+
+	//! Gets the minimum vector to be applied to the given shape's position
+	//! in order to seperate it from this shape.
+	/*!
+		\param s A shape intersecting this shape.
+		\return the minimum displacement vector.
+		\sa GetCollision()
+	*/
+	virtual const Vector2 GetDisplacement(const Shape &s) const override;
+
+	//! Gets the minimum vector to be applied to the given segment's position
+	//! in order to seperate it from this capsule.
+	/*!
+		\param s A segment intersecting this capsule.
+		\return the minimum displacement vector.
+		\sa GetCollision()
+	*/
+	virtual const Vector2 GetDisplacement(const Segment &s) const override;
+
+	//! Gets the minimum vector to be applied to the given circle's position
+	//! in order to seperate it from this capsule.
+	/*!
+		\param c A circle intersecting this capsule.
+		\return the minimum displacement vector.
+		\sa GetCollision()
+	*/
+	virtual const Vector2 GetDisplacement(const Circle &c) const override;
+
+	//! Gets the minimum vector to be applied to the given polygon's position
+	//! in order to seperate it from this capsule.
+	/*!
+		\param p A polygon intersecting this capsule.
+		\return the minimum displacement vector.
+		\sa GetCollision()
+	*/
+	virtual const Vector2 GetDisplacement(const Polygon &p) const override;
+
+	//! Gets the minimum vector to be applied to the given capsule's position
+	//! in order to seperate it from this capsule.
+	/*!
+		\param c A capsule intersecting this capsule.
+		\return the minimum displacement vector.
+		\sa GetCollision()
+	*/
+	virtual const Vector2 GetDisplacement(const Capsule &c) const override;
+
+	//! Gets the minimum vector to be applied to the given shape's position
+	//! in order to seperate it from this capsule, and whether the two overlap.
+	/*!
+		\param s The shape to check against this capsule.
+		\param overlaps Receives the result of Overlaps(s).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Shape &s, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given segment's position
+	//! in order to seperate it from this capsule, and whether the two overlap.
+	/*!
+		\param s The segment to check against this capsule.
+		\param overlaps Receives the result of Overlaps(s).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Segment &s, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given circle's position
+	//! in order to seperate it from this capsule, and whether the two overlap.
+	/*!
+		\param c The circle to check against this capsule.
+		\param overlaps Receives the result of Overlaps(c).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Circle &c, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given polygon's position
+	//! in order to seperate it from this capsule, and whether the two overlap.
+	/*!
+		\param p The polygon to check against this capsule.
+		\param overlaps Receives the result of Overlaps(p).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Polygon &p, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given capsule's position
+	//! in order to seperate it from this capsule, and whether the two overlap.
+	/*!
+		\param c The capsule to check against this capsule.
+		\param overlaps Receives the result of Overlaps(c).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Capsule &c, bool &overlaps) const override;
+
+	//! Gets the collision of this shape with the given shape and returns the result.
+	/*!
+		\param s The shape to check for collision with this shape.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Shape &s) const override;
+
+	//! Gets the collision of this capsule with the given segment and returns the result.
+	/*!
+		\param s The segment to check for collision with this capsule.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Segment &s) const override;
+
+	//! Gets the collision of this capsule with the given circle and returns the result.
+	/*!
+		\param c The circle to check for collision with this capsule.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Circle &c) const override;
+
+	//! Gets the collision of this capsule with the given polygon and returns the result.
+	/*!
+		\param p The polygon to check for collision with this capsule.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Polygon &p) const override;
+
+	//! Gets the collision of this capsule with the given capsule and returns the result.
+	/*!
+		\param c The capsule to check for collision with this capsule.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Capsule &c) const override;
+
+	//! Applies a transformation to this capsule.
+	/*!
+		The radius is scaled by the larger magnitude of the two scale factors, so a mirroring
+		scale keeps it positive and a non-uniform scale still covers the stretched capsule.
+		\param t The transformation to be applied.
+	*/
+	virtual void Transform(const Transformation &t) override;
+
+	//! Method required to be called after updating the geometry of a shape.
+	/*!
+	*/
+	virtual void ReCalc() override;
+
+	//! Clone Method.
+	/*!
+	*/
+	virtual Shape* Clone() override;
+
+protected:
+	//! Finds the closest points between the spine of this capsule and the segment "ab".
+	/*!
+		\param a The first point of the segment.
+		\param b The second point of the segment.
+		\param pA Receives the closest point on the spine.
+		\param pB Receives the closest point on the segment.
+	*/
+	void ClosestPoints(const Vector2 &a, const Vector2 &b, Vector2 &pA, Vector2 &pB) const;
+
+	//! Finds the minimum displacement of a rounded segment "ab" out of this capsule.
+	/*!
+		\param a The first point of the segment.
+		\param b The second point of the segment.
+		\param r The radius around the segment, 0 for a plain segment.
+		\param overlap Receives the penetration depth, 0 if the shapes are separated.
+		\return The minimum displacement vector, or 0,0 if the shapes are separated.
+	*/
+	const Vector2 Separate(const Vector2 &a, const Vector2 &b, const Precision_t r, Precision_t &overlap) const;
+
+	//! Gets the separating axes of this capsule against the given polygon.
+	/*!
+		\param p The polygon to collect axes for.
+		\return The polygon's axes, the spine's axis and the axes from each end point to the polygon.
+	*/
+	const AxesVec GetAxes(const Polygon &p) const;
+
+	Precision_t _radius; /*!< The radius of this capsule. */
+	Axis _axis; /*!< The axis of this capsule's spine. */
+};
+}
+
+#endif
@@ -10,6 +10,9 @@ namespace Crash2D
 class Circle : public ShapeImpl
 {
 public:
+	using ShapeImpl::GetIntersects;
+	using ShapeImpl::GetCollision;
+
 	//! Constructs a circle with radius 0.
 	/*!
 	*/
@@ -94,6 +97,15 @@ public:
 	*/
 	virtual const bool Contains(const Polygon &p) const override;
 
+	//! Checks if this circle contains the given capsule and returns the result.
+	/*!
+		This function will not check if the given capsule contains this circle, GetCollision() can be used for that.
+		\param c The capsule to check for containment in this circle.
+		\return Whether this circle contains the given capsule.
+		\sa GetCollision()
+	*/
+	virtual const bool Contains(const Capsule &c) const override;
+
 	//! Checks if this shape is contained inside the given segment and returns the result.
 	/*!
 		\param s The shape to check if this shape is contained inside.
@@ -122,6 +134,13 @@ public:
 	*/
 	virtual const bool IsInside(const Polygon &p) const override;
 
+	//! Checks if this shape is contained inside the given capsule and returns the result.
+	/*!
+		\param c The capsule to check if this shape is contained inside.
+		\return Whether this shape is contained inside the given capsule.
+	*/
+	virtual const bool IsInside(const Capsule &c) const override;
+
 	//! Checks if this shape intersects the given shape and returns the result.
 	/*!
 		\param s The shape to check for intersection with this shape.
@@ -154,6 +173,14 @@ public:
 	*/
 	virtual const bool Overlaps(const Polygon &p) const override;
 
+	//! Checks if this circle intersects the given capsule and returns the result.
+	/*!
+		\param c The capsule to check for intersection with this circle.
+		\return Whether this circle intersects the given capsule.
+		\sa GetCollision()
+	*/
+	virtual const bool Overlaps(const Capsule &c) const override;
+
 	//! Gets the intersection points of this shape and the given shape.
 	/*!
 		\param s A segment intersecting this shape.
@@ -186,6 +213,31 @@ public:
 	*/
 	virtual const std::vector<Vector2> GetIntersects(const Polygon &p) const override;
 
+	//! Gets the intersection points of this circle and the given capsule.
+	/*!
+		\param c A capsule intersecting this circle.
+		\return list of intersections between this circle and the given capsule.
+		\sa GetCollision()
+	*/
+	virtual const std::vector<Vector2> GetIntersects(const Capsule &c) const override;
+
+	//! Gets the intersection points of this circle and the given shape into caller provided storage.
+	/*!
+		\param s A shape intersecting this circle.
+		\param intersects Cleared, then receives the intersections between this circle and the given shape.
+		\sa GetCollision()
+	*/
+	virtual void GetIntersects(const Shape &s, ArenaVector<Vector2> &intersects) const override;
+
+	//! Gets the intersection points of this circle and the given circle into caller provided storage.
+	/*!
+		Makes no heap allocations once the arena of the buffer has grown.
+		\param c A circle intersecting this circle.
+		\param intersects Cleared, then receives the intersections between the two circles.
+		\sa GetCollision()
+	*/
+	virtual void GetIntersects(const Circle &c, ArenaVector<Vector2> &intersects) const override;
+
 	//! Gets the minimum vector to be applied to the given shape's position
 	//! in order to seperate it from this shape.
 	/*!
@@ -222,6 +274,65 @@ public:
 	*/
 	virtual const Vector2 GetDisplacement(const Polygon &p) const override;
 
+	//! Gets the minimum vector to be applied to the given capsule's position
+	//! in order to seperate it from this circle.
+	/*!
+		\param c A capsule intersecting this circle.
+		\return the minimum displacement vector.
+		\sa GetCollision()
+	*/
+	virtual const Vector2 GetDisplacement(const Capsule &c) const override;
+
+	//! Gets the minimum vector to be applied to the given shape's position
+	//! in order to seperate it from this circle, and whether the two overlap.
+	/*!
+		\param s The shape to check against this circle.
+		\param overlaps Receives the result of Overlaps(s).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Shape &s, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given segment's position
+	//! in order to seperate it from this circle, and whether the two overlap.
+	/*!
+		\param s The segment to check against this circle.
+		\param overlaps Receives the result of Overlaps(s).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Segment &s, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given circle's position
+	//! in order to seperate it from this circle, and whether the two overlap.
+	/*!
+		\param c The circle to check against this circle.
+		\param overlaps Receives the result of Overlaps(c).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Circle &c, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given polygon's position
+	//! in order to seperate it from this circle, and whether the two overlap.
+	/*!
+		\param p The polygon to check against this circle.
+		\param overlaps Receives the result of Overlaps(p).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Polygon &p, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given capsule's position
+	//! in order to seperate it from this circle, and whether the two overlap.
+	/*!
+		\param c The capsule to check against this circle.
+		\param overlaps Receives the result of Overlaps(c).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Capsule &c, bool &overlaps) const override;
+
 	//! Gets the collision of this shape with the given shape and returns the result.
 	/*!
 		\param s The shape to check for collision with this shape.
@@ -256,6 +367,33 @@ public:
 	*/
 	virtual const Collision GetCollision(const Polygon &p) const override;
 
+	//! Gets the collision of this shape with the given capsule and returns the result.
+	/*!
+		\param c The capsule to check for collision with this shape.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Capsule &c) const override;
+
+	//! Gets the collision of this shape with the given shape, writing the intersection points into caller provided storage.
+	/*!
+		\param s The shape to check for collision with this shape.
+		\param intersects Cleared, then receives the intersection points of the two shapes.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Shape &s, ArenaVector<Vector2> &intersects) const override;
+
+	//! Gets the collision of this circle with the given circle, writing the intersection points into caller provided storage.
+	/*!
+		Makes no heap allocations once the arena of the buffer has grown.
+		\param c The circle to check for collision with this circle.
+		\param intersects Cleared, then receives the intersection points of the two circles.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Circle &c, ArenaVector<Vector2> &intersects) const override;
+
 	//! Applies a transformation to this shape..
 	/*!
 		\param t The transformation to be applied.
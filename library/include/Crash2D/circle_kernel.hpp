@@ -0,0 +1,59 @@
+#ifndef CRASH2D_CIRCLE_KERNEL_HPP
+#define CRASH2D_CIRCLE_KERNEL_HPP
+
+#include <Crash2D/vector2.hpp>
+
+namespace Crash2D
+{
+//!  Circles laid out as separate arrays of center coordinates and radii. */
+/*!
+	The arrays are owned by the caller and must each hold at least count entries.
+*/
+struct CircleBatch
+{
+	const Precision_t *x; /*!< The x coordinate of each center. */
+	const Precision_t *y; /*!< The y coordinate of each center. */
+	const Precision_t *radius; /*!< The radius of each circle. */
+	unsigned count; /*!< The number of circles. */
+};
+
+//!  Output arrays written by the batched circle kernels, one entry per tested pair. */
+/*!
+	The arrays are owned by the caller. For overlapping pairs, normal is the unit vector along
+	which the second circle should move and depth is how far it should move, so normal * depth
+	is the minimum displacement. Pairs that do not overlap get a zero depth and a zero normal.
+*/
+struct CircleContacts
+{
+	unsigned char *overlaps; /*!< Set to 1 if the pair overlaps, otherwise 0. */
+	Precision_t *depth; /*!< The penetration depth, the sum of the radii less the distance between the centers. */
+	Precision_t *normalX; /*!< The x component of the unit separating direction. */
+	Precision_t *normalY; /*!< The y component of the unit separating direction. */
+};
+
+//! Tests a list of circle pairs for overlap.
+/*!
+	Pairs are rejected on squared distance first. The square root and division only run for
+	groups of four pairs that contain an overlap, and no trigonometry is used. Overlap agrees
+	with Circle::Overlaps(), so touching circles overlap. Circles with the same center are
+	separated along the x axis.
+	\param c The circles.
+	\param first The index in c of the first circle of each pair.
+	\param second The index in c of the second circle of each pair.
+	\param n The number of pairs.
+	\param out Receives one result per pair.
+*/
+void CollideCircles(const CircleBatch &c, const unsigned *first, const unsigned *second, const unsigned n, CircleContacts &out);
+
+//! Tests one circle against every circle in a batch.
+/*!
+	Results are laid out like the pair version, with the given circle first in every pair.
+	\param center The center of the single circle.
+	\param radius The radius of the single circle.
+	\param c The circles to test against.
+	\param out Receives one result per circle in c.
+*/
+void CollideCircles(const Vector2 &center, const Precision_t radius, const CircleBatch &c, CircleContacts &out);
+}
+
+#endif
@@ -19,13 +19,13 @@ public:
 	//! Constructs a collision with the given displacement.
 	/*!
 		\param dI Whether the two shapes intersect.
-		\param i Intersection points of the two shapes.
+		\param i Intersection points of the two shapes, moved into the collision.
 		\param aCb Whether shape A contains shape B.
 		\param bCa Whether shape B contains shape A.
 		\param o Overlap of the two shapes
 		\param t The minimum displacement vector, returns 0,0 if there is no collision.
 	*/
-	Collision(bool dI, const std::vector<Vector2> i, bool aCb, bool bCa, const Precision_t o, const Vector2 t);
+	Collision(bool dI, std::vector<Vector2> i, bool aCb, bool bCa, const Precision_t o, const Vector2 t);
 
 	//! Gets whether the two shapes intersect.
 	/*!
@@ -45,6 +45,12 @@ public:
 	*/
 	const std::vector<Vector2>& GetIntersects() const;
 
+	//! Gets the heap memory this collision holds.
+	/*!
+		\return The bytes reserved for the intersection points.
+	*/
+	const size_t GetMemoryUsage() const;
+
 	//! Gets whether shape A contains shape B.
 	/*!
 		\return Whether shape A contains shape B.
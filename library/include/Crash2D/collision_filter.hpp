@@ -0,0 +1,53 @@
+#ifndef CRASH2D_COLLISION_FILTER_HPP
+#define CRASH2D_COLLISION_FILTER_HPP
+
+#include <cstdint>
+
+namespace Crash2D
+{
+//!  A set of rules deciding which pairs of shapes are allowed to collide. */
+/*!
+	Two filters in the same nonzero group always collide if the group is positive and never
+	collide if it is negative. Otherwise each filter's category must be in the other's mask.
+*/
+struct CollisionFilter
+{
+	uint32_t category; /*!< The bits describing what this shape is. */
+	uint32_t mask; /*!< The categories this shape collides with. */
+	int32_t group; /*!< The group of this shape, or zero for none. */
+
+	//! Constructs a filter.
+	/*!
+		The defaults collide with everything.
+		\param category The bits describing what the shape is.
+		\param mask The categories the shape collides with.
+		\param group The group of the shape, or zero for none.
+	*/
+	CollisionFilter(const uint32_t category = 1, const uint32_t mask = 0xFFFFFFFF, const int32_t group = 0)
+		: category(category), mask(mask), group(group) {}
+
+	//! Checks if a shape with this filter may collide with a shape with the given filter.
+	/*!
+		\param f The filter of the other shape.
+		\return True if the pair should be tested.
+	*/
+	inline const bool Accepts(const CollisionFilter &f) const
+	{
+		if (group != 0 && group == f.group)
+			return (group > 0);
+
+		return ((category & f.mask) != 0 && (f.category & mask) != 0);
+	}
+
+	inline bool operator == (const CollisionFilter &f) const
+	{
+		return (category == f.category && mask == f.mask && group == f.group);
+	}
+	inline bool operator != (const CollisionFilter &f) const
+	{
+		return !(*this == f);
+	}
+};
+}
+
+#endif
@@ -0,0 +1,394 @@
+#ifndef CRASH2D_COLLISION_WORLD_HPP
+#define CRASH2D_COLLISION_WORLD_HPP
+
+#include <Crash2D/shape.hpp>
+#include <Crash2D/transformation.hpp>
+#include <Crash2D/sweep_broadphase.hpp>
+#include <Crash2D/scheduler.hpp>
+#include <Crash2D/memory.hpp>
+
+#include <memory>
+#include <cstdint>
+
+namespace Crash2D
+{
+class Recorder;
+
+const unsigned NARROWPHASE_CHUNK = 64; /*!< The number of candidate pairs handed to a worker at a time by the parallel narrowphase. */
+
+//!  A reference to a shape owned by a CollisionWorld. */
+/*!
+	A handle stays safe to use after its shape is removed, the world simply reports it as invalid.
+*/
+struct ShapeHandle
+{
+	unsigned index; /*!< The slot of the shape in the world. */
+	unsigned generation; /*!< The generation of the slot when the shape was added. */
+
+	inline bool operator == (const ShapeHandle &h) const
+	{
+		return (index == h.index && generation == h.generation);
+	}
+	inline bool operator != (const ShapeHandle &h) const
+	{
+		return !(*this == h);
+	}
+};
+
+//!  A pair of overlapping shapes found by CollisionWorld::Step(). */
+struct Contact
+{
+	ShapeHandle a; /*!< The first shape of the pair. */
+	ShapeHandle b; /*!< The second shape of the pair. */
+	Vector2 displacement; /*!< The minimum vector to apply to b to separate it from a. */
+};
+
+//!  How a shape in a CollisionWorld is expected to move. */
+enum MotionType
+{
+	MOTION_STATIC, /*!< The shape is level geometry, never paired with other static or sleeping shapes. */
+	MOTION_DYNAMIC /*!< The shape moves, and can be put to sleep while at rest. */
+};
+
+//!  The kinds of change to a pair of shapes reported by CollisionWorld::Step(). */
+enum ContactEventType
+{
+	CONTACT_BEGIN, /*!< The shapes started overlapping this step. */
+	CONTACT_PERSIST, /*!< The shapes overlapped last step and still do. */
+	CONTACT_END /*!< The shapes overlapped last step but no longer do, or one of them was removed. */
+};
+
+//!  A change to a pair of shapes found by CollisionWorld::Step(). */
+struct ContactEvent
+{
+	ContactEventType type; /*!< The kind of change. */
+	Contact contact; /*!< The pair, with the displacement of this step, or of the last step the shapes overlapped for CONTACT_END. */
+};
+
+//!  A class owning a set of shapes and finding every overlapping pair. */
+/*!
+	Each Step() refreshes the bounds of shapes that moved, finds candidate pairs with a
+	SweepBroadphase and tests them with the shapes' own collision routines. The results
+	are written to one contiguous contact buffer, ordered by the shapes' slots.
+
+	Candidate pairs and their narrowphase results are cached between steps. A pair whose
+	shapes both kept still reuses its cached result instead of being tested again, and
+	comparing the cache with the new pairs yields begin, persist and end events.
+
+	Static shapes and sleeping dynamic shapes are never paired with each other, so only
+	pairs with at least one awake shape are found and tested. Contacts between them that
+	already existed are kept from the cache and keep persisting. A dynamic shape wakes
+	when it is moved, or when a moving shape starts or keeps touching it.
+
+	Given the same sequence of calls, Step() produces bit-identical contacts on every run and
+	for any scheduler or worker count: proxies are identified by slot rather than address,
+	candidate pairs are sorted, and parallel results are stored per pair. The results
+	also match across machines when the library is built with CRASH2D_DETERMINISTIC, which
+	requires IEEE single precision arithmetic (SSE2 on x86), no -ffast-math and no
+	CRASH2D_FAST_MATH, and disables fused multiply-adds and 32 bit NEON. Transformations
+	with a rotation go through std::sin and std::cos, so all machines must also share a
+	C runtime, or set rotations through Polygon::SetTransform() with precomputed matrices.
+*/
+class CollisionWorld
+{
+public:
+	//! Constructs an empty world.
+	/*!
+	*/
+	CollisionWorld();
+
+	//! Adds a shape to this world.
+	/*!
+		The world takes ownership of the shape. Dynamic shapes start awake.
+		\param s The shape to add, allocated with new.
+		\param type How the shape is expected to move.
+		\param filter Which other shapes it may collide with.
+		\return The handle of the shape.
+	*/
+	ShapeHandle Add(Shape *s, const MotionType type = MOTION_DYNAMIC, const CollisionFilter &filter = CollisionFilter());
+
+	//! Removes a shape from this world and destroys it.
+	/*!
+		\param h The handle of the shape, ignored if it is no longer valid.
+	*/
+	void Remove(const ShapeHandle &h);
+
+	//! Checks if a handle refers to a shape in this world.
+	/*!
+		\param h The handle to check.
+		\return True if the shape exists.
+	*/
+	const bool IsValid(const ShapeHandle &h) const;
+
+	//! Gets the shape a handle refers to.
+	/*!
+		Call MarkMoved() after changing the shape directly.
+		\param h The handle of the shape.
+		\return The shape, or nullptr if the handle is no longer valid.
+	*/
+	Shape* Get(const ShapeHandle &h) const;
+
+	//! Gets the number of shapes in this world.
+	/*!
+		\return The number of shapes.
+	*/
+	const unsigned GetShapeCount() const;
+
+	//! Gets how a shape is expected to move.
+	/*!
+		\param h The handle of the shape.
+		\return The motion type of the shape, or MOTION_STATIC if the handle is no longer valid.
+	*/
+	const MotionType GetMotionType(const ShapeHandle &h) const;
+
+	//! Sets which other shapes a shape may collide with.
+	/*!
+		Pairs the filters reject are dropped by the broadphase. A dynamic shape is woken so
+		newly accepted pairs with sleeping shapes are found.
+		\param h The handle of the shape, ignored if it is invalid.
+		\param f The new filter.
+	*/
+	void SetFilter(const ShapeHandle &h, const CollisionFilter &f);
+
+	//! Gets which other shapes a shape may collide with.
+	/*!
+		\param h The handle of the shape.
+		\return The filter of the shape, or a filter that collides with nothing if the handle is no longer valid.
+	*/
+	const CollisionFilter& GetFilter(const ShapeHandle &h) const;
+
+	//! Wakes a dynamic shape so its pairs with static and sleeping shapes are found again.
+	/*!
+		\param h The handle of the shape, ignored if it is invalid or static.
+	*/
+	void Wake(const ShapeHandle &h);
+
+	//! Puts a dynamic shape to sleep until it is moved or touched by a moving shape.
+	/*!
+		\param h The handle of the shape, ignored if it is invalid or static.
+	*/
+	void Sleep(const ShapeHandle &h);
+
+	//! Checks if a shape is awake.
+	/*!
+		\param h The handle of the shape.
+		\return True if the shape is valid, dynamic and awake.
+	*/
+	const bool IsAwake(const ShapeHandle &h) const;
+
+	//! Sets how many steps a dynamic shape stays awake without moving before it falls asleep.
+	/*!
+		\param steps The number of steps, or zero to only sleep when Sleep() is called.
+	*/
+	void SetSleepDelay(const unsigned steps);
+
+	//! Gets how many steps a dynamic shape stays awake without moving before it falls asleep.
+	/*!
+		\return The number of steps, or zero if shapes only sleep when Sleep() is called.
+	*/
+	const unsigned GetSleepDelay() const;
+
+	//! Applies a transformation to a shape and schedules its bounds to be refreshed.
+	/*!
+		\param h The handle of the shape.
+		\param t The transformation to apply.
+	*/
+	void Transform(const ShapeHandle &h, const Transformation &t);
+
+	//! Schedules the bounds of a shape to be refreshed after it was changed through Get().
+	/*!
+		A sleeping shape is woken.
+		\param h The handle of the shape.
+	*/
+	void MarkMoved(const ShapeHandle &h);
+
+	//! Finds every overlapping pair of shapes.
+	/*!
+		\return The number of contacts found.
+		\sa GetContacts()
+	*/
+	const unsigned Step();
+
+	//! Gets the contacts found by the last Step().
+	/*!
+		\return The contacts.
+	*/
+	const std::vector<Contact>& GetContacts() const;
+
+	//! Gets the contacts that began, persisted or ended during the last Step().
+	/*!
+		Events are ordered by the shapes' slots. An end event may refer to a shape that has
+		since been removed.
+		\return The events.
+	*/
+	const std::vector<ContactEvent>& GetEvents() const;
+
+	//! Gets the number of candidate pairs the broadphase found in the last Step().
+	/*!
+		\return The number of pairs with at least one awake shape, accepting filters and overlapping bounds.
+	*/
+	const unsigned GetPairCount() const;
+
+	//! Gets the number of candidate pairs the last Step() ran the narrowphase on.
+	/*!
+		\return The number of pairs tested, the rest reused their cached results.
+	*/
+	const unsigned GetTestedCount() const;
+
+	//! Calculates a hash of the contacts found by the last Step().
+	/*!
+		The hash covers the handles and the exact bits of every displacement, in order,
+		so two worlds can be checked for identical results by comparing hashes.
+		\return The 64 bit FNV-1a hash of the contacts.
+	*/
+	const uint64_t GetContactHash() const;
+
+	//! Gets the broadphase used by this world.
+	/*!
+		\return The broadphase.
+	*/
+	const SweepBroadphase& GetBroadphase() const;
+
+	//! Sets the scheduler the narrowphase runs on.
+	/*!
+		Pairs to test are split into chunks of NARROWPHASE_CHUNK and each result is written
+		to its pair's own cache entry, so the result is the same as without a scheduler. Shapes are only read
+		during the narrowphase, but every shape changed through Get() must be passed to
+		MarkMoved() so its cached geometry is refreshed before the workers start.
+		\param s The scheduler, not owned, or nullptr to run on the calling thread.
+	*/
+	void SetScheduler(Scheduler *s);
+
+	//! Gets the scheduler the narrowphase runs on.
+	/*!
+		\return The scheduler, or nullptr if the narrowphase runs on the calling thread.
+	*/
+	Scheduler* GetScheduler() const;
+
+	//! Sets the recorder every change to this world and the results of every step are written to.
+	/*!
+		A recording can only be replayed into a world that hands out the same handles,
+		so a recorder can only be attached before the first shape is added.
+		\param r The recorder, not owned, or nullptr to stop recording.
+		\return False if shapes were already added, in which case nothing changes.
+	*/
+	const bool SetRecorder(Recorder *r);
+
+	//! Gets the recorder this world writes to.
+	/*!
+		\return The recorder, or nullptr if this world is not recorded.
+	*/
+	Recorder* GetRecorder() const;
+
+protected:
+	//! A shape and the bookkeeping for its slot.
+	struct Slot
+	{
+		std::unique_ptr<Shape> shape; /*!< The shape, empty if the slot is free. */
+		unsigned generation; /*!< Incremented every time the slot is freed. */
+		bool moved; /*!< Whether the bounds need refreshing. */
+		unsigned movedStep; /*!< The last step that refreshed the bounds. */
+		unsigned activeStep; /*!< The last step the shape moved or was woken. */
+		MotionType type; /*!< How the shape is expected to move. */
+		bool awake; /*!< Whether the shape is dynamic and awake. */
+	};
+
+	//! A candidate pair and its narrowphase result, kept between steps.
+	struct CachedPair
+	{
+		ProxyPair pair; /*!< The slots of the shapes. */
+		Contact contact; /*!< The handles of the shapes and the last displacement found. */
+		bool touching; /*!< Whether the shapes overlapped. */
+	};
+
+	//! Gets the handle of the shape in the given slot.
+	/*!
+		\param index The slot.
+		\return The handle.
+	*/
+	const ShapeHandle GetHandle(const unsigned index) const;
+
+	//! Queues the shape in the given slot for a bounds refresh and wakes it.
+	/*!
+		\param index The slot, which must hold a shape.
+	*/
+	void SetMoved(const unsigned index);
+
+	//! Refreshes the bounds of every shape that moved since the last step.
+	/*!
+		Moved static shapes are woken in the broadphase for this step, so they are paired with sleeping shapes.
+	*/
+	void UpdateBounds();
+
+	//! Puts the static shapes woken by UpdateBounds() back to sleep and drops their pairs with other static shapes.
+	/*!
+	*/
+	void SettleStatic();
+
+	//! Wakes the shape in the given slot or puts it to sleep.
+	/*!
+		\param index The slot, which must hold a dynamic shape.
+		\param awake True to wake the shape, false to put it to sleep.
+	*/
+	void SetAwake(const unsigned index, const bool awake);
+
+	//! Builds the cache entries for this step's candidate pairs.
+	/*!
+		Entries whose shapes kept still copy the previous result, the others are queued for testing.
+	*/
+	void UpdateCache();
+
+	//! Keeps a previous cache entry the broadphase no longer reports if both shapes are resting against each other.
+	/*!
+		\param old The previous entry.
+	*/
+	void KeepResting(const CachedPair &old);
+
+	//! Wakes every sleeping shape touched in a pair tested this step.
+	/*!
+	*/
+	void WakeTouching();
+
+	//! Puts every dynamic shape that has not moved for the sleep delay to sleep.
+	/*!
+	*/
+	void SleepResting();
+
+	//! Tests one candidate pair.
+	/*!
+		\param p The candidate pair.
+		\param c Receives the contact if the shapes overlap.
+		\return True if the shapes overlap.
+	*/
+	const bool Collide(const ProxyPair &p, Contact &c) const;
+
+	//! Tests every queued pair on the scheduler.
+	/*!
+	*/
+	void CollideParallel();
+
+	//! Compares the previous cache with the new one to fill the contacts and events.
+	/*!
+	*/
+	void Report();
+
+	TaggedVector<Slot, MEMORY_WORLD> _slots; /*!< The shapes, indexed by slot. */
+	TaggedVector<unsigned, MEMORY_WORLD> _free; /*!< Slots available for reuse. */
+	TaggedVector<unsigned, MEMORY_WORLD> _moved; /*!< Slots whose bounds need refreshing. */
+	TaggedVector<unsigned, MEMORY_WORLD> _movedStatic; /*!< Static slots awake in the broadphase for this step only. */
+	SweepBroadphase _broadphase; /*!< The broadphase, with one proxy per slot in use. */
+	std::vector<ProxyPair> _pairs; /*!< The candidate pairs of the last step. */
+	TaggedVector<CachedPair, MEMORY_WORLD> _cache; /*!< The candidate pairs of the last step and their results. */
+	TaggedVector<CachedPair, MEMORY_WORLD> _previous; /*!< The cache of the step before, used for events. */
+	TaggedVector<unsigned, MEMORY_WORLD> _tests; /*!< The cache entries that need the narrowphase this step. */
+	std::vector<Contact> _contacts; /*!< The contacts of the last step. */
+	std::vector<ContactEvent> _events; /*!< The events of the last step. */
+	Scheduler *_scheduler; /*!< The scheduler the narrowphase runs on, or nullptr. */
+	Recorder *_recorder; /*!< The recorder changes are written to, or nullptr. */
+	unsigned _count; /*!< The number of shapes. */
+	unsigned _step; /*!< The number of steps taken. */
+	unsigned _sleepDelay; /*!< The number of steps before a still shape falls asleep, or zero. */
+};
+}
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef CRASH2D_COUNTERS_HPP
+#define CRASH2D_COUNTERS_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace Crash2D
+{
+//! The events counted by the hot path instrumentation.
+enum Counter
+{
+	COUNTER_DISPLACEMENTS, /*!< Calls to CalcDisplacement or the separating axis kernel. */
+	COUNTER_OVERLAPS, /*!< Calls to GetOverlap. */
+	COUNTER_AXES, /*!< Axes tested by the separating axis queries above. */
+	COUNTER_EARLY_OUTS, /*!< Separating axis queries that stopped at a separating axis. */
+	COUNTER_PROJECTIONS, /*!< Shapes or point sets projected onto an axis. */
+	COUNTER_EDGE_TESTS, /*!< Edge pairs tested by GetIntersects. */
+	COUNTER_CELL_VISITS, /*!< Broadphase cells visited while finding pairs. */
+	COUNTER_BOUNDS_TESTS, /*!< Broadphase bounding box overlap tests. */
+	COUNTER_COUNT /*!< The number of counters. */
+};
+
+//!  A snapshot of the instrumentation counters. */
+/*!
+	The counters only run when the library and everything including its headers are built
+	with CRASH2D_COUNTERS defined, otherwise every count compiles away and snapshots are zero.
+	Each thread counts into its own block, so counting never contends between threads.
+*/
+struct Counters
+{
+	uint64_t values[COUNTER_COUNT]; /*!< The value of each counter. */
+
+	//! Constructs a snapshot with every counter at zero.
+	Counters();
+
+	//! Gets the name of a counter.
+	/*!
+		\param c The counter.
+		\return The name of the counter, in lower case.
+	*/
+	static const char* GetName(const Counter c);
+
+	inline const uint64_t operator [] (const Counter c) const
+	{
+		return values[c];
+	}
+
+	//! Gets the counts between an earlier snapshot and this one.
+	const Counters operator - (const Counters &c) const;
+
+	//! Sums two snapshots.
+	const Counters operator + (const Counters &c) const;
+};
+
+//! Checks if the library was built with the counters.
+/*!
+	\return True if CRASH2D_COUNTERS was defined when the library was built.
+*/
+const bool CountersEnabled();
+
+//! Gets the counts of every thread added together.
+/*!
+	Counts made by threads that have since exited are included.
+	Counts made while the snapshot is taken may or may not be included.
+	\return The totals since the last reset.
+*/
+const Counters GetCounters();
+
+//! Gets the counts of the calling thread.
+/*!
+	\return The calling thread's counts since the last reset.
+*/
+const Counters GetThreadCounters();
+
+//! Sets every counter of every thread to zero.
+/*!
+	Counts made by other threads while resetting may survive, so reset between frames.
+*/
+void ResetCounters();
+
+#ifdef CRASH2D_COUNTERS
+
+//!  The counters of one thread. */
+/*!
+	Only the owning thread writes its block, other threads read it while taking snapshots.
+*/
+struct CounterBlock
+{
+	std::atomic<uint64_t> values[COUNTER_COUNT]; /*!< The value of each counter. */
+
+	//! Constructs a block at zero and registers it for snapshots.
+	CounterBlock();
+
+	//! Adds the block's counts to the totals of exited threads and unregisters it.
+	~CounterBlock();
+
+	//! Adds to a counter.
+	/*!
+		\param c The counter.
+		\param n The amount to add.
+	*/
+	inline void Add(const Counter c, const uint64_t n)
+	{
+		// Only this thread writes, so a plain load and store is enough and needs no locked instruction
+		values[c].store(values[c].load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+	}
+};
+
+extern thread_local CounterBlock threadCounters; /*!< The calling thread's counters. */
+
+#define CRASH2D_COUNT(c, n) ::Crash2D::threadCounters.Add(::Crash2D::c, (n))
+
+#else
+
+#define CRASH2D_COUNT(c, n) ((void)0)
+
+#endif
+}
+
+#endif
@@ -0,0 +1,264 @@
+#ifndef CRASH2D_EDGE_TABLE_HPP
+#define CRASH2D_EDGE_TABLE_HPP
+
+#include <Crash2D/vector2.hpp>
+#include <Crash2D/memory.hpp>
+
+#include <cstddef>
+
+namespace Crash2D
+{
+class Segment;
+
+//!  A class storing the sides of a polygon as flat arrays. */
+/*!
+	Each side is stored as its start point, direction, unit normal and inverse length,
+	one array per component. The arrays share a single block, so a table makes one allocation
+	as it grows and no Segment objects are allocated.
+*/
+class EdgeTable
+{
+public:
+	//! Constructs an empty table.
+	/*!
+	*/
+	EdgeTable();
+
+	//! Removes all sides from this table.
+	/*!
+	*/
+	void Clear();
+
+	//! Reserves room for the given number of sides.
+	/*!
+		\param n The number of sides.
+	*/
+	void Reserve(const unsigned n);
+
+	//! Adds the side running from a to b.
+	/*!
+		\param a The start of the side.
+		\param b The end of the side.
+	*/
+	void Add(const Vector2 &a, const Vector2 &b);
+
+	//! Gets the number of sides in this table.
+	/*!
+		\return The number of sides in this table.
+	*/
+	const unsigned GetSize() const;
+
+	//! Gets the heap memory this table holds.
+	/*!
+		\return The bytes reserved for the sides.
+	*/
+	const size_t GetMemoryUsage() const;
+
+	//! Gets the start point of the side at the given index.
+	/*!
+		\param i The index of the side.
+		\return The start point of the side.
+	*/
+	const Vector2 GetStart(const unsigned i) const;
+
+	//! Gets the end point of the side at the given index.
+	/*!
+		\param i The index of the side.
+		\return The end point of the side.
+	*/
+	const Vector2 GetEnd(const unsigned i) const;
+
+	//! Gets the direction of the side at the given index, that is, its end minus its start.
+	/*!
+		\param i The index of the side.
+		\return The direction of the side.
+	*/
+	const Vector2 GetDirection(const unsigned i) const;
+
+	//! Gets the unit normal of the side at the given index.
+	/*!
+		This matches the axis of the equivalent Segment.
+		\param i The index of the side.
+		\return The unit normal of the side.
+	*/
+	const Axis GetNormal(const unsigned i) const;
+
+	//! Gets the inverse length of the side at the given index.
+	/*!
+		\param i The index of the side.
+		\return One over the length of the side.
+	*/
+	const Precision_t GetInverseLength(const unsigned i) const;
+
+	//! Builds a segment for the side at the given index.
+	/*!
+		\param i The index of the side.
+		\return The side as a segment.
+	*/
+	const Segment GetSide(const unsigned i) const;
+
+	//! Gets the distance from the given point to the line through the side at the given index.
+	/*!
+		Matches Segment::DistancePoint().
+		\param i The index of the side.
+		\param p The point to measure from.
+		\return The distance from the point to the side's line.
+	*/
+	const Precision_t DistancePoint(const unsigned i, const Vector2 &p) const;
+
+	//! Intersects the side at the given index with a side of another table.
+	/*!
+		Matches Segment::GetIntersects(const Segment&) without building either segment.
+		\param i The index of the side in this table.
+		\param t The other table.
+		\param j The index of the side in the other table.
+		\param out Receives the intersection point.
+		\return Whether the sides intersect.
+	*/
+	const bool Intersect(const unsigned i, const EdgeTable &t, const unsigned j, Vector2 &out) const;
+
+private:
+	//! The arrays of the block, in order.
+	enum Column
+	{
+		START_X, /*!< The x coordinate of each side's start. */
+		START_Y, /*!< The y coordinate of each side's start. */
+		DIR_X, /*!< The x component of each side's direction. */
+		DIR_Y, /*!< The y component of each side's direction. */
+		NORMAL_X, /*!< The x component of each side's unit normal. */
+		NORMAL_Y, /*!< The y component of each side's unit normal. */
+		INV_LENGTH, /*!< The inverse length of each side. */
+		COLUMN_COUNT /*!< The number of arrays. */
+	};
+
+	//! Gets one of the arrays.
+	inline Precision_t* Get(const Column c)
+	{
+		return _block.data() + c * _capacity;
+	}
+
+	//! Gets one of the arrays.
+	inline const Precision_t* Get(const Column c) const
+	{
+		return _block.data() + c * _capacity;
+	}
+
+	//! Moves the arrays to a larger block.
+	/*!
+		\param capacity The number of sides the new block holds.
+	*/
+	void Grow(const unsigned capacity);
+
+	TaggedVector<Precision_t, MEMORY_SHAPES> _block; /*!< Every array, each _capacity values long. */
+	unsigned _size; /*!< The number of sides. */
+	unsigned _capacity; /*!< The number of sides the block holds. */
+};
+
+//!  A lightweight read-only view of the sides of a polygon. */
+/*!
+	Indexing or iterating the view builds Segment objects on demand from an EdgeTable.
+	The view is invalidated when the polygon it came from is changed or destroyed.
+*/
+class SideView
+{
+public:
+	//!  A forward iterator over the sides of a SideView. */
+	class Iterator
+	{
+	public:
+		//! Constructs an iterator.
+		/*!
+			\param t The table being iterated.
+			\param i The index of the current side.
+		*/
+		Iterator(const EdgeTable *t, const unsigned i) : _table(t), _index(i) {}
+
+		//! Builds the segment for the current side.
+		/*!
+			\return The current side.
+		*/
+		const Segment operator * () const;
+
+		inline Iterator & operator ++ ()
+		{
+			++_index;
+			return *this;
+		}
+		inline bool operator == (const Iterator & it) const
+		{
+			return (_table == it._table && _index == it._index);
+		}
+		inline bool operator != (const Iterator & it) const
+		{
+			return !(*this == it);
+		}
+
+	private:
+		const EdgeTable *_table; /*!< The table being iterated. */
+		unsigned _index; /*!< The index of the current side. */
+	};
+
+	//! Constructs a view of the given table.
+	/*!
+		\param t The table to view.
+	*/
+	SideView(const EdgeTable &t) : _table(&t) {}
+
+	//! Gets the number of sides.
+	/*!
+		\return The number of sides.
+	*/
+	std::size_t size() const
+	{
+		return _table->GetSize();
+	}
+
+	//! Checks whether there are no sides.
+	/*!
+		\return Whether there are no sides.
+	*/
+	bool empty() const
+	{
+		return (size() == 0);
+	}
+
+	//! Builds the segment for the side at the given index.
+	/*!
+		\param i The index of the side.
+		\return The side as a segment.
+	*/
+	const Segment operator [] (const unsigned i) const;
+
+	//! Gets an iterator to the first side.
+	/*!
+		\return An iterator to the first side.
+	*/
+	Iterator begin() const
+	{
+		return Iterator(_table, 0);
+	}
+
+	//! Gets an iterator past the last side.
+	/*!
+		\return An iterator past the last side.
+	*/
+	Iterator end() const
+	{
+		return Iterator(_table, _table->GetSize());
+	}
+
+	//! Gets the table this view reads from.
+	/*!
+		\return The underlying edge table.
+	*/
+	const EdgeTable& GetEdges() const
+	{
+		return *_table;
+	}
+
+private:
+	const EdgeTable *_table; /*!< The table this view reads from. */
+};
+}
+
+#endif
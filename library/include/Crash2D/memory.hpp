@@ -0,0 +1,153 @@
+#ifndef CRASH2D_MEMORY_HPP
+#define CRASH2D_MEMORY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Crash2D
+{
+//! The parts of the library heap memory is attributed to.
+enum MemoryTag
+{
+	MEMORY_SHAPES, /*!< Sides and kernel point copies of shapes. */
+	MEMORY_BROADPHASE, /*!< Cells, proxies and sorted lists of the broadphases. */
+	MEMORY_WORLD, /*!< Slots, pair caches and work lists of collision worlds. */
+	MEMORY_ARENAS, /*!< Blocks of frame arenas. */
+	MEMORY_TAG_COUNT /*!< The number of tags. */
+};
+
+//!  An interface for the allocator the library's tagged containers draw from. */
+/*!
+	Install one with SetAllocator() to route the memory of every subsystem through an engine's own heap,
+	or to track it in more detail. Both methods may be called from any thread at once.
+*/
+class Allocator
+{
+public:
+	virtual ~Allocator() = default;
+
+	//! Allocates memory.
+	/*!
+		\param bytes The number of bytes, never zero.
+		\param tag The subsystem the memory is for.
+		\return Memory aligned for any fundamental type. Failures must throw std::bad_alloc, as containers expect.
+	*/
+	virtual void* Allocate(const size_t bytes, const MemoryTag tag) = 0;
+
+	//! Frees memory returned by Allocate().
+	/*!
+		\param p The memory.
+		\param bytes The number of bytes it was allocated with.
+		\param tag The subsystem it was allocated for.
+	*/
+	virtual void Deallocate(void *p, const size_t bytes, const MemoryTag tag) = 0;
+};
+
+//!  A snapshot of the memory held through the tagged containers. */
+struct MemoryStats
+{
+	uint64_t bytes[MEMORY_TAG_COUNT]; /*!< The bytes currently held by each subsystem. */
+	uint64_t peak[MEMORY_TAG_COUNT]; /*!< The most bytes each subsystem held at once. */
+	uint64_t allocations[MEMORY_TAG_COUNT]; /*!< The number of allocations each subsystem made. */
+
+	//! Constructs a snapshot with everything at zero.
+	MemoryStats();
+
+	//! Gets the name of a tag.
+	/*!
+		\param t The tag.
+		\return The name of the tag, in lower case.
+	*/
+	static const char* GetName(const MemoryTag t);
+
+	//! Gets the bytes held by every subsystem together.
+	/*!
+		\return The sum of bytes.
+	*/
+	const uint64_t GetTotal() const;
+};
+
+//! Sets the allocator every tagged container draws from.
+/*!
+	Memory must be freed by the allocator that allocated it, so the allocator can only change while
+	no tagged memory is held, typically before the first shape or broadphase is built.
+	\param a The allocator, not owned, or nullptr for operator new and delete.
+	\return False if tagged memory is held, in which case nothing changes.
+*/
+const bool SetAllocator(Allocator *a);
+
+//! Gets the allocator every tagged container draws from.
+/*!
+	\return The allocator set with SetAllocator(), or nullptr if operator new and delete are used.
+*/
+Allocator* GetAllocator();
+
+//! Gets the memory held through the tagged containers.
+/*!
+	\return The bytes, peaks and allocation counts of every subsystem.
+*/
+const MemoryStats GetMemoryStats();
+
+//! Allocates memory for a subsystem through the current allocator and counts it.
+/*!
+	\param bytes The number of bytes.
+	\param tag The subsystem the memory is for.
+	\return The memory.
+*/
+void* Allocate(const size_t bytes, const MemoryTag tag);
+
+//! Frees memory returned by Allocate().
+/*!
+	\param p The memory.
+	\param bytes The number of bytes it was allocated with.
+	\param tag The subsystem it was allocated for.
+*/
+void Deallocate(void *p, const size_t bytes, const MemoryTag tag);
+
+//!  A standard library allocator that draws from Allocate() with a fixed tag. */
+template <typename T, MemoryTag Tag>
+class TaggedAllocator
+{
+public:
+	typedef T value_type;
+
+	template <typename U>
+	struct rebind
+	{
+		typedef TaggedAllocator<U, Tag> other;
+	};
+
+	TaggedAllocator() = default;
+
+	template <typename U>
+	TaggedAllocator(const TaggedAllocator<U, Tag>&) {}
+
+	inline T* allocate(const size_t n)
+	{
+		return static_cast<T*>(Allocate(n * sizeof(T), Tag));
+	}
+
+	inline void deallocate(T *p, const size_t n)
+	{
+		Deallocate(p, n * sizeof(T), Tag);
+	}
+
+	template <typename U>
+	inline bool operator == (const TaggedAllocator<U, Tag>&) const
+	{
+		return true;
+	}
+
+	template <typename U>
+	inline bool operator != (const TaggedAllocator<U, Tag>&) const
+	{
+		return false;
+	}
+};
+
+template <typename T, MemoryTag Tag>
+using TaggedVector = std::vector<T, TaggedAllocator<T, Tag>>; /**< A vector whose memory is attributed to a subsystem. */
+}
+
+#endif
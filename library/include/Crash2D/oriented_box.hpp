@@ -0,0 +1,281 @@
+#ifndef CRASH2D_ORIENTED_BOX_HPP
+#define CRASH2D_ORIENTED_BOX_HPP
+
+#include <Crash2D/polygon.hpp>
+
+namespace Crash2D
+{
+//!  A class representing a rotated rectangle shape. */
+/*!
+	An oriented box is a four sided polygon whose two axes and half extents are known up front, so projections
+	are computed in closed form instead of visiting every vertex.
+*/
+class OrientedBox : public Polygon
+{
+public:
+	using Polygon::Contains;
+	using Polygon::Overlaps;
+	using Polygon::GetDisplacement;
+	using Polygon::GetCollision;
+
+	//! Constructs an empty oriented box at the origin.
+	/*!
+	*/
+	OrientedBox();
+
+	//! Destructor.
+	/*!
+	*/
+	virtual ~OrientedBox() = default;
+
+	//! Constructs an oriented box from its center, half extents and rotation.
+	/*!
+		\param c The center of the new box.
+		\param e The half width and half height of the new box.
+		\param r The rotation of the new box in degrees.
+	*/
+	OrientedBox(const Vector2 &c, const Vector2 &e, const Precision_t r = 0);
+
+	//! Gets the half extents of this box.
+	/*!
+		\return The half width and half height of this box.
+	*/
+	virtual const Vector2& GetHalfExtents() const;
+
+	//! Converts a point into the local coordinates of this box.
+	/*!
+		\param p The point to convert.
+		\return The point relative to the center of this box, expressed along its two axes.
+	*/
+	virtual const Vector2 ToLocal(const Vector2 &p) const;
+
+	//! Gets the point of this box closest to the given point.
+	/*!
+		\param p The point given to be used in the calculation.
+		\return The closest point on or inside this box.
+	*/
+	virtual const Vector2 GetNearestPoint(const Vector2 &p) const;
+
+	//! Projects this box onto the given axis and returns the result.
+	/*!
+		\param a The axis to project this box onto.
+		\return The projection of this box onto the given axis.
+	*/
+	virtual const Projection Project(const Axis &a) const override;
+
+	//! Checks if this box contains the given vector and returns the result.
+	/*!
+		\param v The vector to check for containment in this box.
+		\return Whether this box contains the given vector.
+	*/
+	virtual const bool Contains(const Vector2 &v) const override;
+
+	//! Checks if this box contains the given circle and returns the result.
+	/*!
+		\param c The circle to check for containment in this box.
+		\return Whether this box contains the given circle.
+		\sa GetCollision()
+	*/
+	virtual const bool Contains(const Circle &c) const override;
+
+	//! Checks if this shape intersects the given shape and returns the result.
+	/*!
+		\param s The shape to check for intersection with this shape.
+		\return Whether this shape intersects the given shape.
+		\sa GetCollision()
+	*/
+	virtual const bool Overlaps(const Shape &s) const override;
+
+	//! Checks if this box intersects the given circle and returns the result.
+	/*!
+		\param c The circle to check for intersection with this box.
+		\return Whether this box intersects the given circle.
+		\sa GetCollision()
+	*/
+	virtual const bool Overlaps(const Circle &c) const override;
+
+	//! Checks if this box intersects the given oriented box and returns the result.
+	/*!
+		\param b The oriented box to check for intersection with this box.
+		\return Whether this box intersects the given oriented box.
+		\sa GetCollision()
+	*/
+	virtual const bool Overlaps(const OrientedBox &b) const override;
+
+	//! Checks if this box intersects the given box and returns the result.
+	/*!
+		\param b The box to check for intersection with this box.
+		\return Whether this box intersects the given box.
+		\sa GetCollision()
+	*/
+	virtual const bool Overlaps(const Box &b) const override;
+
+	//! Gets the minimum vector to be applied to the given shape's position
+	//! in order to seperate it from this shape.
+	/*!
+		\param s A shape intersecting this shape.
+		\return the minimum displacement vector.
+		\sa GetCollision()
+	*/
+	virtual const Vector2 GetDisplacement(const Shape &s) const override;
+
+	//! Gets the minimum vector to be applied to the given circle's position
+	//! in order to seperate it from this box.
+	/*!
+		\param c A circle intersecting this box.
+		\return the minimum displacement vector.
+		\sa GetCollision()
+	*/
+	virtual const Vector2 GetDisplacement(const Circle &c) const override;
+
+	//! Gets the minimum vector to be applied to the given oriented box's position
+	//! in order to seperate it from this box.
+	/*!
+		\param b An oriented box intersecting this box.
+		\return the minimum displacement vector.
+		\sa GetCollision()
+	*/
+	virtual const Vector2 GetDisplacement(const OrientedBox &b) const override;
+
+	//! Gets the minimum vector to be applied to the given box's position
+	//! in order to seperate it from this box.
+	/*!
+		\param b A box intersecting this box.
+		\return the minimum displacement vector.
+		\sa GetCollision()
+	*/
+	virtual const Vector2 GetDisplacement(const Box &b) const override;
+
+	//! Gets the minimum vector to be applied to the given shape's position
+	//! in order to seperate it from this oriented box, and whether the two overlap.
+	/*!
+		\param s The shape to check against this oriented box.
+		\param overlaps Receives the result of Overlaps(s).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Shape &s, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given circle's position
+	//! in order to seperate it from this oriented box, and whether the two overlap.
+	/*!
+		\param c The circle to check against this oriented box.
+		\param overlaps Receives the result of Overlaps(c).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Circle &c, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given oriented box's position
+	//! in order to seperate it from this oriented box, and whether the two overlap.
+	/*!
+		\param b The oriented box to check against this oriented box.
+		\param overlaps Receives the result of Overlaps(b).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const OrientedBox &b, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given box's position
+	//! in order to seperate it from this oriented box, and whether the two overlap.
+	/*!
+		\param b The box to check against this oriented box.
+		\param overlaps Receives the result of Overlaps(b).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Box &b, bool &overlaps) const override;
+
+	//! Gets the collision of this shape with the given shape and returns the result.
+	/*!
+		\param s The shape to check for collision with this shape.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Shape &s) const override;
+
+	//! Gets the collision of this box with the given circle and returns the result.
+	/*!
+		\param c The circle to check for collision with this box.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Circle &c) const override;
+
+	//! Gets the collision of this box with the given oriented box and returns the result.
+	/*!
+		\param b The oriented box to check for collision with this box.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const OrientedBox &b) const override;
+
+	//! Gets the collision of this box with the given box and returns the result.
+	/*!
+		\param b The box to check for collision with this box.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Box &b) const override;
+
+	//! Method required to be called after updating the geometry of a shape.
+	/*!
+		Rebuilds the center, axes and half extents from the four corner points.
+	*/
+	virtual void ReCalc() override;
+
+	//! Sets the center, axes and half extents of this box as they are, keeping its corner points.
+	/*!
+		Unlike ReCalc() nothing is derived from the points, so a box can be restored bit for bit.
+		\param c The center of the box.
+		\param e The half width and half height of the box.
+		\param u The first axis of the box.
+		\param v The second axis of the box.
+		\sa ReCalc()
+	*/
+	void SetFrame(const Vector2 &c, const Vector2 &e, const Axis &u, const Axis &v);
+
+	//! Keeps this box in world space.
+	/*!
+		A box is transformed in constant time through its center and axes, so it never defers its world geometry.
+		\param local Ignored.
+	*/
+	virtual void SetLocalSpace(const bool local) override;
+
+	//! Clone Method.
+	/*!
+	*/
+	virtual Shape* Clone() override;
+
+protected:
+	//! Rebuilds the four corner points from the center, axes and half extents.
+	/*!
+	*/
+	void UpdatePoints();
+
+	//! Rebuilds the sides and the projection point copy from the four corner points.
+	/*!
+	*/
+	void UpdateSides();
+
+	//! Finds the minimum displacement of the given box out of this box over both boxes' axes.
+	/*!
+		\param b The box to test against.
+		\param overlap Receives the signed overlap along the axis of least penetration.
+		\return The minimum displacement vector, or 0,0 if the boxes are separated.
+	*/
+	const Vector2 Separate(const OrientedBox &b, Precision_t &overlap) const;
+
+	//! Finds the minimum displacement of the given circle out of this box.
+	/*!
+		\param c The circle to test against.
+		\param overlap Receives the penetration depth, 0 if the shapes are separated.
+		\return The minimum displacement vector, or 0,0 if the shapes are separated.
+	*/
+	const Vector2 Separate(const Circle &c, Precision_t &overlap) const;
+
+	Vector2 _halfExtents; /*!< The half width and half height of this box. */
+};
+}
+
+#endif
@@ -2,13 +2,24 @@
 #define CRASH2D_POLYGON_HPP
 
 #include <Crash2D/shape_impl.hpp>
+#include <Crash2D/edge_table.hpp>
+#include <Crash2D/projection_kernel.hpp>
+#include <Crash2D/affine_matrix.hpp>
 
 namespace Crash2D
 {
+const unsigned SWEEP_THRESHOLD = 8; /*!< Combined side count above which polygon intersection uses a sweep instead of testing every pair of sides. */
+
 //!  A class representing an n-sided polygon shape. */
 class Polygon : public ShapeImpl
 {
+	// Shared geometry hands out the kernel layout of its local polygon instead of keeping a copy
+	friend class PolygonGeometry;
+
 public:
+	using ShapeImpl::GetIntersects;
+	using ShapeImpl::GetCollision;
+
 	//! Constructs a default polygon.
 	/*!
 		This polygon's points should be added through the base Shape class's interface.
@@ -30,10 +41,110 @@ public:
 
 	//! Gets the sides this polygon is composed of.
 	/*!
-		The number of sides of a polygon will always be one less than the number of points.
+		The sides are returned as a view that builds each Segment when it is accessed.
+		The view is invalidated by ReCalc() or Transform().
 		\return The sides this polygon is composed of.
+		\sa GetEdges()
+	*/
+	virtual const SideView GetSides() const;
+
+	//! Gets the flat table of sides this polygon is composed of.
+	/*!
+		\return The sides of this polygon.
+	*/
+	const EdgeTable& GetEdges() const;
+
+	//! Gets the center of this polygon in world space.
+	/*!
+		\return The center of this polygon.
+	*/
+	virtual const Vector2& GetCenter() const override;
+
+	//! Sets the number of points in this polygon.
+	/*!
+		In local space this resizes the local geometry.
+		\param c The number of points in this polygon.
+	*/
+	virtual void SetPointCount(const unsigned &c) override;
+
+	//! Sets the point of this polygon at the given index to the new point.
+	/*!
+		In local space this sets a local point, ReCalc() must still be called afterwards.
+		\param i The index of the point.
+		\param p The new point to replace the old point with.
+	*/
+	virtual void SetPoint(const unsigned &i, const Vector2 &p) override;
+
+	//! Gets the point of this polygon at the given index in world space.
+	/*!
+		\param i The index of the point.
+		\return The point of this polygon at the given index.
+	*/
+	virtual const Vector2& GetPoint(const unsigned &i) const override;
+
+	//! Gets the points this polygon is composed of in world space.
+	/*!
+		\return The points this polygon is composed of.
+	*/
+	virtual const std::vector<Vector2>& GetPoints() const override;
+
+	//! Gets the heap memory this polygon holds.
+	/*!
+		\return The bytes reserved for the points, sides, axes and kernel copy of the points, in world and local space.
+	*/
+	virtual const size_t GetMemoryUsage() const override;
+
+	//! Switches this polygon between world space and local space.
+	/*!
+		In local space the points are kept as fixed local geometry and Transform() only updates
+		the local to world transform. World points, axes and sides are rebuilt on the first query
+		after a change, and the axes are transformed from the local axes rather than rebuilt.
+		Entering local space keeps the current points as the local geometry with an identity
+		transform. Leaving it keeps the current world points.
+
+		The rebuild happens inside const queries without synchronization, so a polygon changed
+		in local space must not be queried from several threads at once until it is rebuilt.
+		Call Refresh() after the last change to share it between threads.
+		\param local Whether this polygon should keep local geometry.
+		\sa Refresh()
+	*/
+	virtual void SetLocalSpace(const bool local);
+
+	//! Checks if this polygon keeps local geometry.
+	/*!
+		\return True if this polygon is in local space.
+		\sa SetLocalSpace()
+	*/
+	const bool IsLocalSpace() const;
+
+	//! Sets the transform from local space to world space.
+	/*!
+		Enters local space first if needed. Has no effect on shapes that always stay in world space.
+		The world geometry is rebuilt by the next query, which is not safe to make from several
+		threads at once, see SetLocalSpace().
+		\param m The new local to world transform.
+		\sa SetLocalSpace(), Refresh()
 	*/
-	virtual const std::vector<Segment>& GetSides() const;
+	void SetTransform(const AffineMatrix &m);
+
+	//! Rebuilds the world points, axes and sides now if a change in local space left them out of date.
+	/*!
+		Afterwards const queries change nothing, so they may be made from several threads at once.
+		\sa SetLocalSpace()
+	*/
+	void Refresh();
+
+	//! Gets the transform from local space to world space.
+	/*!
+		\return The local to world transform, or the identity outside local space.
+	*/
+	const AffineMatrix& GetTransform() const;
+
+	//! Gets the local points this polygon is composed of.
+	/*!
+		\return The local points, or the world points outside local space.
+	*/
+	const std::vector<Vector2>& GetLocalPoints() const;
 
 	//! Gets the neareset vertex of this polygon to the given point and returns the result.
 	/*!
@@ -44,6 +155,7 @@ public:
 
 	//! Projects this polygon onto the given axis and returns the result.
 	/*!
+		Reads the copy of the points made by ReCalc().
 		\param a The axis to project this polygon onto.
 		\return The projection of this polygon onto the given axis.
 	*/
@@ -97,6 +209,15 @@ public:
 	*/
 	virtual const bool Contains(const Polygon &p) const override;
 
+	//! Checks if this polygon contains the given capsule and returns the result.
+	/*!
+		This function will not check if the given capsule contains this polygon, GetCollision() can be used for that.
+		\param c The capsule to check for containment in this polygon.
+		\return Whether this polygon contains the given capsule.
+		\sa GetCollision()
+	*/
+	virtual const bool Contains(const Capsule &c) const override;
+
 	//! Checks if this shape is contained inside the given segment and returns the result.
 	/*!
 		\param s The shape to check if this shape is contained inside.
@@ -125,6 +246,13 @@ public:
 	*/
 	virtual const bool IsInside(const Polygon &p) const override;
 
+	//! Checks if this shape is contained inside the given capsule and returns the result.
+	/*!
+		\param c The capsule to check if this shape is contained inside.
+		\return Whether this shape is contained inside the given capsule.
+	*/
+	virtual const bool IsInside(const Capsule &c) const override;
+
 	//! Checks if this shape intersects the given shape and returns the result.
 	/*!
 		\param s The shape to check for intersection with this shape.
@@ -157,6 +285,14 @@ public:
 	*/
 	virtual const bool Overlaps(const Polygon &p) const override;
 
+	//! Checks if this polygon intersects the given capsule and returns the result.
+	/*!
+		\param c The capsule to check for intersection with this polygon.
+		\return Whether this polygon intersects the given capsule.
+		\sa GetCollision()
+	*/
+	virtual const bool Overlaps(const Capsule &c) const override;
+
 	//! Gets the intersection points of this shape and the given shape.
 	/*!
 		\param s A segment intersecting this shape.
@@ -189,6 +325,31 @@ public:
 	*/
 	virtual const std::vector<Vector2> GetIntersects(const Polygon &p) const override;
 
+	//! Gets the intersection points of this polygon and the given capsule.
+	/*!
+		\param c A capsule intersecting this polygon.
+		\return list of intersections between this polygon and the given capsule.
+		\sa GetCollision()
+	*/
+	virtual const std::vector<Vector2> GetIntersects(const Capsule &c) const override;
+
+	//! Gets the intersection points of this polygon and the given shape into caller provided storage.
+	/*!
+		\param s A shape intersecting this polygon.
+		\param intersects Cleared, then receives the intersections between this polygon and the given shape.
+		\sa GetCollision()
+	*/
+	virtual void GetIntersects(const Shape &s, ArenaVector<Vector2> &intersects) const override;
+
+	//! Gets the intersection points of this polygon and the given polygon into caller provided storage.
+	/*!
+		Makes no heap allocations once the arena of the buffer has grown.
+		\param p A polygon intersecting this polygon.
+		\param intersects Cleared, then receives the intersections between the two polygons.
+		\sa GetCollision()
+	*/
+	virtual void GetIntersects(const Polygon &p, ArenaVector<Vector2> &intersects) const override;
+
 	//! Gets the minimum vector to be applied to the given shape's position
 	//! in order to seperate it from this shape.
 	/*!
@@ -225,6 +386,65 @@ public:
 	*/
 	virtual const Vector2 GetDisplacement(const Polygon &p) const override;
 
+	//! Gets the minimum vector to be applied to the given capsule's position
+	//! in order to seperate it from this polygon.
+	/*!
+		\param c A capsule intersecting this polygon.
+		\return the minimum displacement vector.
+		\sa GetCollision()
+	*/
+	virtual const Vector2 GetDisplacement(const Capsule &c) const override;
+
+	//! Gets the minimum vector to be applied to the given shape's position
+	//! in order to seperate it from this polygon, and whether the two overlap.
+	/*!
+		\param s The shape to check against this polygon.
+		\param overlaps Receives the result of Overlaps(s).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Shape &s, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given segment's position
+	//! in order to seperate it from this polygon, and whether the two overlap.
+	/*!
+		\param s The segment to check against this polygon.
+		\param overlaps Receives the result of Overlaps(s).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Segment &s, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given circle's position
+	//! in order to seperate it from this polygon, and whether the two overlap.
+	/*!
+		\param c The circle to check against this polygon.
+		\param overlaps Receives the result of Overlaps(c).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Circle &c, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given polygon's position
+	//! in order to seperate it from this polygon, and whether the two overlap.
+	/*!
+		\param p The polygon to check against this polygon.
+		\param overlaps Receives the result of Overlaps(p).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Polygon &p, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given capsule's position
+	//! in order to seperate it from this polygon, and whether the two overlap.
+	/*!
+		\param c The capsule to check against this polygon.
+		\param overlaps Receives the result of Overlaps(c).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Capsule &c, bool &overlaps) const override;
+
 	//! Gets the collision of this shape with the given shape and returns the result.
 	/*!
 		\param s The shape to check for collision with this shape.
@@ -259,8 +479,36 @@ public:
 	*/
 	virtual const Collision GetCollision(const Polygon &p) const override;
 
+	//! Gets the collision of this shape with the given capsule and returns the result.
+	/*!
+		\param c The capsule to check for collision with this shape.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Capsule &c) const override;
+
+	//! Gets the collision of this shape with the given shape, writing the intersection points into caller provided storage.
+	/*!
+		\param s The shape to check for collision with this shape.
+		\param intersects Cleared, then receives the intersection points of the two shapes.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Shape &s, ArenaVector<Vector2> &intersects) const override;
+
+	//! Gets the collision of this polygon with the given polygon, writing the intersection points into caller provided storage.
+	/*!
+		Makes no heap allocations once the arena of the buffer has grown.
+		\param p The polygon to check for collision with this polygon.
+		\param intersects Cleared, then receives the intersection points of the two polygons.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Polygon &p, ArenaVector<Vector2> &intersects) const override;
+
 	//! Applies a transformation to this shape..
 	/*!
+		In local space the transformation is only composed onto the local to world transform.
 		\param t The transformation to be applied.
 	*/
 	virtual void Transform(const Transformation &t) override;
@@ -276,6 +524,17 @@ public:
 	virtual Shape* Clone() override;
 
 protected:
+	//! Rebuilds the world points, axes and sides from the local geometry if the transform changed.
+	/*!
+	*/
+	void UpdateWorld() const;
+
+	//! Gets the points of this polygon laid out for the projection kernels.
+	/*!
+		\return The points of this polygon.
+	*/
+	const PointArray& GetVertices() const;
+
 	//! Checks if triangle "abc" contains the point "p".
 	/*!
 		\param p The point to check for containment within the triangle.
@@ -285,8 +544,46 @@ protected:
 	*/
 	const bool TriangleContains(const Vector2 &p, const Vector2 &a, const Vector2 &b, const Vector2 &c) const;
 
-	AxesVec _axes; /*!< The axes of this polygon. */
-	std::vector<Segment> _side; /*!< The sides of this polygon. */
+	//! Gets the axes of this polygon and the given polygon with parallel axes removed.
+	/*!
+		\param p The other polygon of the pair.
+		\return The separating axes to test for this pair.
+	*/
+	const AxesVec MergeAxes(const Polygon &p) const;
+
+	//! Gets the axes of this polygon and the given polygon with parallel axes removed, into arena backed storage.
+	/*!
+		\param p The other polygon of the pair.
+		\param axes Cleared, then receives the separating axes to test for this pair.
+	*/
+	void MergeAxes(const Polygon &p, ArenaVector<Axis> &axes) const;
+
+	//! Gets the intersection points of this polygon and the given polygon by testing every pair of sides.
+	/*!
+		\param p A polygon intersecting this polygon.
+		\return list of intersections between this polygon and the given polygon.
+	*/
+	const std::vector<Vector2> GetIntersectsBrute(const Polygon &p) const;
+
+	//! Gets the intersection points of this polygon and the given polygon using a sweep along the x axis.
+	/*!
+		Only pairs of sides whose bounding boxes overlap are tested. The result matches GetIntersectsBrute(),
+		including the order of the points.
+		\param p A polygon intersecting this polygon.
+		\return list of intersections between this polygon and the given polygon.
+	*/
+	const std::vector<Vector2> GetIntersectsSweep(const Polygon &p) const;
+
+	mutable AxesVec _axes; /*!< The axes of this polygon. */
+	mutable EdgeTable _edges; /*!< The sides of this polygon. */
+	mutable PointArray _vertices; /*!< The points of this polygon laid out for the projection kernels. */
+
+	bool _local; /*!< Whether this polygon keeps local geometry. */
+	mutable bool _dirty; /*!< Whether the world geometry is out of date with the transform. */
+	std::vector<Vector2> _localPoints; /*!< The points of this polygon in local space. */
+	AxesVec _localAxes; /*!< The axes of this polygon in local space. */
+	Vector2 _localCenter; /*!< The center of this polygon in local space. */
+	AffineMatrix _transform; /*!< The transform from local space to world space. */
 };
 }
 
@@ -0,0 +1,160 @@
+#ifndef CRASH2D_POLYGON_INSTANCE_HPP
+#define CRASH2D_POLYGON_INSTANCE_HPP
+
+#include <Crash2D/polygon.hpp>
+
+#include <memory>
+
+namespace Crash2D
+{
+//!  A class holding the immutable local-space geometry of a polygon, shared by many instances. */
+/*!
+	The sides, axes, center and projection layout are computed once on construction.
+*/
+class PolygonGeometry
+{
+public:
+	//! Constructs the geometry of a polygon with the given local points.
+	/*!
+		\param points The points of the polygon in local space.
+	*/
+	PolygonGeometry(const std::vector<Vector2> &points);
+
+	//! Gets the geometry as a local-space polygon.
+	/*!
+		\return The local-space polygon.
+	*/
+	const Polygon& GetPolygon() const;
+
+	//! Gets the local points of the geometry.
+	/*!
+		\return The local points.
+	*/
+	const std::vector<Vector2>& GetPoints() const;
+
+	//! Gets the local axes of the geometry with parallel axes removed.
+	/*!
+		\return The local axes.
+	*/
+	const AxesVec& GetAxes() const;
+
+	//! Gets the local center of the geometry.
+	/*!
+		\return The local center.
+	*/
+	const Vector2& GetCenter() const;
+
+	//! Gets the local points laid out for the projection kernels.
+	/*!
+		\return The local points.
+	*/
+	const PointArray& GetVertices() const;
+
+private:
+	Polygon _polygon; /*!< The local-space polygon, holding the points, sides, axes and kernel layout. */
+};
+
+using GeometryPtr = std::shared_ptr<const PolygonGeometry>; /**< An alias representing shared polygon geometry. */
+
+//!  A class representing a polygon as shared geometry plus its own transform. */
+/*!
+	An instance holds only a reference to its geometry and a transform, so it is cheap to copy.
+	Pair tests run in the local space of this instance, transforming only the other instance's points.
+*/
+class PolygonInstance
+{
+public:
+	//! Constructs an instance of the given geometry with an identity transform.
+	/*!
+		\param g The shared geometry.
+	*/
+	PolygonInstance(const GeometryPtr &g);
+
+	//! Constructs an instance of the given geometry with the given transform.
+	/*!
+		\param g The shared geometry.
+		\param m The transform from local space to world space.
+	*/
+	PolygonInstance(const GeometryPtr &g, const AffineMatrix &m);
+
+	//! Gets the shared geometry of this instance.
+	/*!
+		\return The shared geometry.
+	*/
+	const GeometryPtr& GetGeometry() const;
+
+	//! Gets the transform from local space to world space.
+	/*!
+		\return The transform of this instance.
+	*/
+	const AffineMatrix& GetTransform() const;
+
+	//! Sets the transform from local space to world space.
+	/*!
+		\param m The new transform.
+	*/
+	void SetTransform(const AffineMatrix &m);
+
+	//! Applies a transformation on top of the current transform.
+	/*!
+		\param t The transformation to be applied.
+	*/
+	void Transform(const Transformation &t);
+
+	//! Gets the center of this instance in world space.
+	/*!
+		\return The center of this instance.
+	*/
+	const Vector2 GetCenter() const;
+
+	//! Projects this instance onto the given world axis and returns the result.
+	/*!
+		The axis is mapped into local space, so no points are transformed.
+		\param a The axis to project onto.
+		\return The projection of this instance onto the axis.
+	*/
+	const Projection Project(const Axis &a) const;
+
+	//! Checks if this instance contains the given world point.
+	/*!
+		\param v The point to check.
+		\return True if the point is inside this instance.
+	*/
+	const bool Contains(const Vector2 &v) const;
+
+	//! Checks if this instance overlaps the given instance.
+	/*!
+		\param p The instance to check for overlap.
+		\return True if the instances overlap.
+	*/
+	const bool Overlaps(const PolygonInstance &p) const;
+
+	//! Gets the minimum vector to apply to the given instance to separate it from this instance.
+	/*!
+		The vector is minimal when this instance's transform has no shear or non-uniform scale.
+		\param p The instance to separate.
+		\return The displacement in world space, or zero if the instances do not overlap.
+	*/
+	const Vector2 GetDisplacement(const PolygonInstance &p) const;
+
+	//! Builds a standalone polygon with this instance's world geometry.
+	/*!
+		The polygon is returned in local space with this instance's transform.
+		\return The polygon.
+	*/
+	const Polygon ToPolygon() const;
+
+protected:
+	//! Runs the separating axis test against the given instance in this instance's local space.
+	/*!
+		\param p The other instance.
+		\return The local-space displacement to apply to p, or zero if the instances do not overlap.
+	*/
+	const Vector2 Separate(const PolygonInstance &p) const;
+
+	GeometryPtr _geometry; /*!< The shared geometry. */
+	AffineMatrix _transform; /*!< The transform from local space to world space. */
+};
+}
+
+#endif
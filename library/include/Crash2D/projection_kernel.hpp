@@ -0,0 +1,102 @@
+#ifndef CRASH2D_PROJECTION_KERNEL_HPP
+#define CRASH2D_PROJECTION_KERNEL_HPP
+
+#include <Crash2D/projection.hpp>
+#include <Crash2D/memory.hpp>
+
+namespace Crash2D
+{
+//!  A copy of a shape's points split into separate x and y arrays. */
+/*!
+	The arrays are padded to a multiple of Simd::WIDTH by repeating the last point,
+	which leaves every projection unchanged.
+*/
+class PointArray
+{
+public:
+	//! Constructs an empty point array.
+	/*!
+	*/
+	PointArray();
+
+	//! Replaces the contents of this array with the given points.
+	/*!
+		\param points The points to copy.
+	*/
+	void Assign(const std::vector<Vector2> &points);
+
+	//! Gets the number of points, not counting padding.
+	/*!
+		\return The number of points.
+	*/
+	const unsigned GetSize() const;
+
+	//! Gets the heap memory this array holds.
+	/*!
+		\return The bytes reserved for the coordinates, including padding.
+	*/
+	const size_t GetMemoryUsage() const;
+
+	//! Gets the padded x coordinates.
+	/*!
+		\return The x coordinates.
+	*/
+	const Precision_t* GetX() const;
+
+	//! Gets the padded y coordinates.
+	/*!
+		\return The y coordinates.
+	*/
+	const Precision_t* GetY() const;
+
+private:
+	TaggedVector<Precision_t, MEMORY_SHAPES> _block; /*!< The padded x coordinates followed by the padded y coordinates. */
+	unsigned _size; /*!< The number of points, not counting padding. */
+	unsigned _padded; /*!< The number of points, counting padding. */
+};
+
+//! Projects the given points onto an axis and returns the result.
+/*!
+	Four points are projected per step.
+	\param p The points to project.
+	\param a The axis to project onto.
+	\return The projection of the points onto the axis.
+*/
+const Projection ProjectPoints(const PointArray &p, const Axis &a);
+
+//! Projects the given points onto several axes.
+/*!
+	Four axes are projected per step, so this suits shapes with few points.
+	\param p The points to project.
+	\param axes The axes to project onto.
+	\param n The number of axes.
+	\param out Receives one projection per axis.
+*/
+void ProjectPoints(const PointArray &p, const Axis *axes, const unsigned n, Projection *out);
+
+//! Runs the separating axis test for two point sets over every given axis in one pass.
+/*!
+	Gives the same results as ShapeImpl::CalcDisplacement() and ShapeImpl::GetOverlap()
+	with shape a and shape b.
+	\param axes The axes to test.
+	\param a The points of the first shape.
+	\param b The points of the second shape.
+	\param overlap Receives the smallest overlap, or zero if the shapes are separated.
+	\return The minimum vector to apply to b to separate it from a, or zero if the shapes are separated.
+*/
+const Vector2 SeparatePoints(const AxesVec &axes, const PointArray &a, const PointArray &b, Precision_t &overlap);
+
+//! Runs the separating axis test for two point sets over an array of axes in one pass.
+/*!
+	\param axes The axes to test.
+	\param n The number of axes.
+	\param a The points of the first shape.
+	\param b The points of the second shape.
+	\param overlap Receives the smallest overlap, or zero if the shapes are separated.
+	\return The minimum vector to apply to b to separate it from a, or zero if the shapes are separated.
+	\sa SeparatePoints(const AxesVec&, const PointArray&, const PointArray&, Precision_t&)
+*/
+const Vector2 SeparatePoints(const Axis *axes, const unsigned n, const PointArray &a, const PointArray &b, Precision_t &overlap);
+}
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef CRASH2D_RECORDER_HPP
+#define CRASH2D_RECORDER_HPP
+
+#include <Crash2D/collision_world.hpp>
+
+#include <cstdint>
+#include <ostream>
+
+namespace Crash2D
+{
+const uint32_t RECORDING_MAGIC = 0x52443243; /*!< The first four bytes of a recording, "C2DR". */
+const uint32_t RECORDING_VERSION = 1; /*!< The version of the recording format written. */
+const uint32_t RECORDING_MAX_POINTS = 1 << 20; /*!< The most points a recorded polygon may have, larger counts mean a corrupt recording. */
+
+//! The calls stored in a recording.
+enum RecordOp
+{
+	RECORD_ADD, /*!< A shape was added. */
+	RECORD_REMOVE, /*!< A shape was removed. */
+	RECORD_TRANSFORM, /*!< A shape was transformed through the world. */
+	RECORD_RESHAPE, /*!< A shape was changed directly and marked as moved. */
+	RECORD_FILTER, /*!< A shape's filter was changed. */
+	RECORD_WAKE, /*!< A shape was woken. */
+	RECORD_SLEEP, /*!< A shape was put to sleep. */
+	RECORD_SLEEP_DELAY, /*!< The sleep delay was changed. */
+	RECORD_STEP /*!< The world was stepped, with the results. */
+};
+
+//! The kinds of shape a recording can hold.
+enum RecordShape
+{
+	RECORD_CIRCLE,
+	RECORD_SEGMENT,
+	RECORD_CAPSULE,
+	RECORD_POLYGON,
+	RECORD_ORIENTED_BOX,
+	RECORD_BOX,
+	RECORD_UNSUPPORTED /*!< A shape that could not be recorded, nothing follows it. */
+};
+
+//!  Writes every change made to a CollisionWorld and the results of each step to a binary stream. */
+/*!
+	Attach it with CollisionWorld::SetRecorder(). Shapes are stored whole when they are added or
+	changed directly, transformations through CollisionWorld::Transform() are stored as the
+	transformation. Each step stores the number of contacts and CollisionWorld::GetContactHash(),
+	so a Replayer can check that a build still finds the same contacts.
+
+	Values are written in the byte order of the machine, so recordings move between machines
+	of the same endianness. Shapes other than Circle, Segment, Capsule, Polygon, OrientedBox
+	and Box cannot be recorded. In their place the recorder writes RECORD_UNSUPPORTED, which a
+	Replayer rejects, and it writes nothing more.
+*/
+class Recorder
+{
+public:
+	//! Constructs a recorder and writes the recording header.
+	/*!
+		\param out The stream to write to, opened in binary mode, which must outlive the recorder.
+	*/
+	Recorder(std::ostream &out);
+
+	//! Checks if everything so far was recorded.
+	/*!
+		\return False if a write failed or a shape could not be recorded.
+	*/
+	const bool IsGood() const;
+
+	//! Records a shape being added.
+	/*!
+		\param h The handle the world gave the shape.
+		\param s The shape.
+		\param type How the shape moves.
+		\param filter The filter of the shape.
+	*/
+	void Add(const ShapeHandle &h, const Shape &s, const MotionType type, const CollisionFilter &filter);
+
+	//! Records a shape being removed.
+	/*!
+		\param h The handle of the shape.
+	*/
+	void Remove(const ShapeHandle &h);
+
+	//! Records a shape being transformed.
+	/*!
+		\param h The handle of the shape.
+		\param t The transformation.
+	*/
+	void Transform(const ShapeHandle &h, const Transformation &t);
+
+	//! Records the current geometry of a shape that was changed directly.
+	/*!
+		\param h The handle of the shape.
+		\param s The shape.
+	*/
+	void Reshape(const ShapeHandle &h, const Shape &s);
+
+	//! Records a shape's filter being changed.
+	/*!
+		\param h The handle of the shape.
+		\param filter The new filter.
+	*/
+	void SetFilter(const ShapeHandle &h, const CollisionFilter &filter);
+
+	//! Records a shape being woken or put to sleep.
+	/*!
+		\param h The handle of the shape.
+		\param awake True if it was woken.
+	*/
+	void SetAwake(const ShapeHandle &h, const bool awake);
+
+	//! Records the sleep delay being changed.
+	/*!
+		\param steps The new delay.
+	*/
+	void SetSleepDelay(const unsigned steps);
+
+	//! Records a step and its results.
+	/*!
+		\param contacts The number of contacts found.
+		\param hash The hash of the contacts found.
+	*/
+	void Step(const unsigned contacts, const uint64_t hash);
+
+protected:
+	//! Writes the bytes of a value, unless a shape could not be recorded.
+	template <typename T>
+	void Write(const T &v)
+	{
+		if (!_good)
+			return;
+
+		_out.write(reinterpret_cast<const char*>(&v), sizeof(T));
+	}
+
+	//! Writes an operation code and a handle.
+	void WriteOp(const RecordOp op, const ShapeHandle &h);
+
+	//! Writes a vector.
+	void WriteVector(const Vector2 &v);
+
+	//! Writes the kind and geometry of a shape.
+	void WriteShape(const Shape &s);
+
+	std::ostream &_out; /*!< The stream written to. */
+	bool _good; /*!< Whether every shape so far could be recorded. */
+};
+}
+
+#endif
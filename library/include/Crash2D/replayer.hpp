@@ -0,0 +1,93 @@
+#ifndef CRASH2D_REPLAYER_HPP
+#define CRASH2D_REPLAYER_HPP
+
+#include <Crash2D/recorder.hpp>
+
+#include <istream>
+#include <string>
+
+namespace Crash2D
+{
+//!  The outcome of one replayed step. */
+struct ReplayStep
+{
+	unsigned contacts; /*!< The number of contacts found by this build. */
+	unsigned expectedContacts; /*!< The number of contacts in the recording. */
+	uint64_t hash; /*!< The hash of the contacts found by this build. */
+	uint64_t expectedHash; /*!< The hash of the contacts in the recording. */
+	double seconds; /*!< The time CollisionWorld::Step() took. */
+
+	//! Checks if this build found the recorded contacts.
+	/*!
+		\return True if the counts and hashes match.
+	*/
+	inline const bool Matches() const
+	{
+		return (contacts == expectedContacts && hash == expectedHash);
+	}
+};
+
+//!  Replays a recording written by a Recorder into a CollisionWorld, one step at a time. */
+/*!
+	The world must be empty and never have held a shape, so it hands out the handles
+	the recording refers to.
+*/
+class Replayer
+{
+public:
+	//! Constructs a replayer and reads the recording header.
+	/*!
+		\param in The stream to read from, opened in binary mode, which must outlive the replayer.
+	*/
+	Replayer(std::istream &in);
+
+	//! Applies the recorded calls up to and including the next step.
+	/*!
+		\param world The world to replay into.
+		\param step Receives the results of the step.
+		\return False at the end of the recording or on an error.
+	*/
+	const bool Next(CollisionWorld &world, ReplayStep &step);
+
+	//! Gets the error that stopped the replay.
+	/*!
+		\return A description of the error, empty if there was none.
+	*/
+	const std::string& GetError() const;
+
+protected:
+	//! Reads the bytes of a value.
+	template <typename T>
+	const bool Read(T &v)
+	{
+		return static_cast<bool>(_in.read(reinterpret_cast<char*>(&v), sizeof(T)));
+	}
+
+	//! Reads a vector.
+	const bool ReadVector(Vector2 &v);
+
+	//! Reads a handle and checks that it is valid in the world.
+	const bool ReadHandle(const CollisionWorld &world, ShapeHandle &h);
+
+	//! Reads a filter.
+	const bool ReadFilter(CollisionFilter &f);
+
+	//! Reads the kind and geometry of a shape.
+	/*!
+		\return The new shape, or nullptr on an error.
+	*/
+	Shape* ReadShape();
+
+	//! Stops the replay with an error.
+	/*!
+		\param error The description of the error.
+		\return False.
+	*/
+	const bool Fail(const std::string &error);
+
+	std::istream &_in; /*!< The stream read from. */
+	std::string _error; /*!< The error that stopped the replay. */
+};
+}
+
+#endif
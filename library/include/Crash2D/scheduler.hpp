@@ -0,0 +1,40 @@
+#ifndef CRASH2D_SCHEDULER_HPP
+#define CRASH2D_SCHEDULER_HPP
+
+#include <functional>
+
+namespace Crash2D
+{
+//!  An interface for running a batch of independent tasks across workers. */
+/*!
+	Implement this to run the library's parallel stages on an existing job system.
+	\sa ThreadPool
+*/
+class Scheduler
+{
+public:
+	using Task = std::function<void(const unsigned task, const unsigned worker)>; /**< A task, called with its index and the index of the worker running it. */
+
+	//! Destructor.
+	/*!
+	*/
+	virtual ~Scheduler() = default;
+
+	//! Gets the number of workers tasks may run on.
+	/*!
+		\return The number of workers.
+	*/
+	virtual const unsigned GetWorkerCount() const = 0;
+
+	//! Runs a batch of tasks and waits for all of them to finish.
+	/*!
+		The task must be called exactly once for every index below count, each time with a
+		worker index below GetWorkerCount(). Calls with the same worker index must not overlap.
+		\param count The number of tasks.
+		\param task The task to run.
+	*/
+	virtual void Run(const unsigned count, const Task &task) = 0;
+};
+}
+
+#endif
@@ -9,6 +9,9 @@ namespace Crash2D
 class Segment : public ShapeImpl
 {
 public:
+	using ShapeImpl::GetIntersects;
+	using ShapeImpl::GetCollision;
+
 	//! Constructs a default segment.
 	/*!
 		This segment's points should be added through the base Shape class's interface.
@@ -150,6 +153,15 @@ public:
 	*/
 	virtual const bool Contains(const Polygon &p) const override;
 
+	//! Checks if this segment contains the given capsule and returns the result.
+	/*!
+		This function will not check if the given capsule contains this segment, GetCollision() can be used for that.
+		\param c The capsule to check for containment in this segment.
+		\return Whether this segment contains the given capsule.
+		\sa GetCollision()
+	*/
+	virtual const bool Contains(const Capsule &c) const override;
+
 	//! Checks if this shape is contained inside the given segment and returns the result.
 	/*!
 		\param s The shape to check if this shape is contained inside.
@@ -178,6 +190,13 @@ public:
 	*/
 	virtual const bool IsInside(const Polygon &p) const override;
 
+	//! Checks if this shape is contained inside the given capsule and returns the result.
+	/*!
+		\param c The capsule to check if this shape is contained inside.
+		\return Whether this shape is contained inside the given capsule.
+	*/
+	virtual const bool IsInside(const Capsule &c) const override;
+
 	//! Checks if this shape intersects the given shape and returns the result.
 	/*!
 		\param s The shape to check for intersection with this shape.
@@ -210,6 +229,14 @@ public:
 	*/
 	virtual const bool Overlaps(const Polygon &p) const override;
 
+	//! Checks if this segment intersects the given capsule and returns the result.
+	/*!
+		\param c The capsule to check for intersection with this segment.
+		\return Whether this segment intersects the given capsule.
+		\sa GetCollision()
+	*/
+	virtual const bool Overlaps(const Capsule &c) const override;
+
 	//! Gets the intersection points of this shape and the given shape.
 	/*!
 		\param s A segment intersecting this shape.
@@ -242,6 +269,14 @@ public:
 	*/
 	virtual const std::vector<Vector2> GetIntersects(const Polygon &p) const override;
 
+	//! Gets the intersection points of this segment and the given capsule.
+	/*!
+		\param c A capsule intersecting this segment.
+		\return list of intersections between this segment and the given capsule.
+		\sa GetCollision()
+	*/
+	virtual const std::vector<Vector2> GetIntersects(const Capsule &c) const override;
+
 	//! Gets the minimum vector to be applied to the given shape's position
 	//! in order to seperate it from this shape.
 	/*!
@@ -278,6 +313,65 @@ public:
 	*/
 	virtual const Vector2 GetDisplacement(const Polygon &p) const override;
 
+	//! Gets the minimum vector to be applied to the given capsule's position
+	//! in order to seperate it from this segment.
+	/*!
+		\param c A capsule intersecting this segment.
+		\return the minimum displacement vector.
+		\sa GetCollision()
+	*/
+	virtual const Vector2 GetDisplacement(const Capsule &c) const override;
+
+	//! Gets the minimum vector to be applied to the given shape's position
+	//! in order to seperate it from this segment, and whether the two overlap.
+	/*!
+		\param s The shape to check against this segment.
+		\param overlaps Receives the result of Overlaps(s).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Shape &s, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given segment's position
+	//! in order to seperate it from this segment, and whether the two overlap.
+	/*!
+		\param s The segment to check against this segment.
+		\param overlaps Receives the result of Overlaps(s).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Segment &s, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given circle's position
+	//! in order to seperate it from this segment, and whether the two overlap.
+	/*!
+		\param c The circle to check against this segment.
+		\param overlaps Receives the result of Overlaps(c).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Circle &c, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given polygon's position
+	//! in order to seperate it from this segment, and whether the two overlap.
+	/*!
+		\param p The polygon to check against this segment.
+		\param overlaps Receives the result of Overlaps(p).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Polygon &p, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given capsule's position
+	//! in order to seperate it from this segment, and whether the two overlap.
+	/*!
+		\param c The capsule to check against this segment.
+		\param overlaps Receives the result of Overlaps(c).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Capsule &c, bool &overlaps) const override;
+
 	//! Gets the collision of this shape with the given shape and returns the result.
 	/*!
 		\param s The shape to check for collision with this shape.
@@ -312,6 +406,14 @@ public:
 	*/
 	virtual const Collision GetCollision(const Polygon &p) const override;
 
+	//! Gets the collision of this shape with the given capsule and returns the result.
+	/*!
+		\param c The capsule to check for collision with this shape.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Capsule &c) const override;
+
 	//! Applies a transformation to this shape..
 	/*!
 		\param t The transformation to be applied.
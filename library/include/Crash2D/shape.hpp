@@ -3,6 +3,9 @@
 
 #include <Crash2D/vector2.hpp>
 #include <Crash2D/transformation.hpp>
+#include <Crash2D/arena.hpp>
+
+#include <cstddef>
 
 namespace Crash2D
 {
@@ -12,6 +15,9 @@ class Collision;
 class Circle;
 class Polygon;
 class Segment;
+class OrientedBox;
+class Box;
+class Capsule;
 
 //!  A class representing an abstract geometric shape. */
 class Shape
@@ -61,6 +67,12 @@ public:
 	*/
 	virtual const std::vector<Vector2>& GetPoints() const = 0;
 
+	//! Gets the heap memory this shape holds.
+	/*!
+		\return The bytes reserved for the points, sides, axes and other storage this shape owns, not counting the shape itself.
+	*/
+	virtual const size_t GetMemoryUsage() const = 0;
+
 	//! Projects the circle onto the given axis and returns the projection.
 	/*!
 		\param a The axis to project the circle onto.
@@ -109,6 +121,15 @@ public:
 	*/
 	virtual const bool Contains(const Polygon &p) const = 0;
 
+	//! Checks if this shape contains the given capsule and returns the result.
+	/*!
+		This function will not check if the given capsule contains this shape, GetCollision() can be used for that.
+		\param c The capsule to check for containment in this shape.
+		\return Whether this shape contains the given capsule.
+		\sa GetCollision()
+	*/
+	virtual const bool Contains(const Capsule &c) const = 0;
+
 	//! Checks if this shape is contained inside the given segment and returns the result.
 	/*!
 		\param s The shape to check if this shape is contained inside.
@@ -137,6 +158,13 @@ public:
 	*/
 	virtual const bool IsInside(const Polygon &p) const = 0;
 
+	//! Checks if this shape is contained inside the given capsule and returns the result.
+	/*!
+		\param c The capsule to check if this shape is contained inside.
+		\return Whether this shape is contained inside the given capsule.
+	*/
+	virtual const bool IsInside(const Capsule &c) const = 0;
+
 	//! Checks if this shape intersects the given shape and returns the result.
 	/*!
 		\param s The shape to check for intersection with this shape.
@@ -168,6 +196,30 @@ public:
 		\sa GetCollision()
 	*/
 	virtual const bool Overlaps(const Polygon &p) const = 0;
+
+	//! Checks if this shape intersects the given oriented box and returns the result.
+	/*!
+		\param b The oriented box to check for intersection with this shape.
+		\return Whether this shape intersects the given oriented box.
+		\sa GetCollision()
+	*/
+	virtual const bool Overlaps(const OrientedBox &b) const = 0;
+
+	//! Checks if this shape intersects the given box and returns the result.
+	/*!
+		\param b The box to check for intersection with this shape.
+		\return Whether this shape intersects the given box.
+		\sa GetCollision()
+	*/
+	virtual const bool Overlaps(const Box &b) const = 0;
+
+	//! Checks if this shape intersects the given capsule and returns the result.
+	/*!
+		\param c The capsule to check for intersection with this shape.
+		\return Whether this shape intersects the given capsule.
+		\sa GetCollision()
+	*/
+	virtual const bool Overlaps(const Capsule &c) const = 0;
 	
 		//! Method used to caculate the overlap of two shapes
 	/*!
@@ -209,6 +261,57 @@ public:
 	*/
 	virtual const std::vector<Vector2> GetIntersects(const Polygon &p) const = 0;
 
+	//! Gets the intersection points of this shape and the given capsule.
+	/*!
+		\param c A capsule intersecting this shape.
+		\return list of intersections between this shape and the given capsule.
+		\sa GetCollision()
+	*/
+	virtual const std::vector<Vector2> GetIntersects(const Capsule &c) const = 0;
+
+	//! Gets the intersection points of this shape and the given shape into caller provided storage.
+	/*!
+		Gives the same points as GetIntersects(const Shape&). Pairs of circles and pairs of polygons
+		write straight into the buffer, so once its arena has grown they make no heap allocations.
+		Other pairs are computed on the heap and copied.
+		\param s A shape intersecting this shape.
+		\param intersects Cleared, then receives the intersections between this shape and the given shape.
+		\sa GetCollision()
+	*/
+	virtual void GetIntersects(const Shape &s, ArenaVector<Vector2> &intersects) const = 0;
+
+	//! Gets the intersection points of this shape and the given segment into caller provided storage.
+	/*!
+		\param s A segment intersecting this shape.
+		\param intersects Cleared, then receives the intersections between this shape and the given segment.
+		\sa GetCollision()
+	*/
+	virtual void GetIntersects(const Segment &s, ArenaVector<Vector2> &intersects) const = 0;
+
+	//! Gets the intersection points of this shape and the given circle into caller provided storage.
+	/*!
+		\param c A circle intersecting this shape.
+		\param intersects Cleared, then receives the intersections between this shape and the given circle.
+		\sa GetCollision()
+	*/
+	virtual void GetIntersects(const Circle &c, ArenaVector<Vector2> &intersects) const = 0;
+
+	//! Gets the intersection points of this shape and the given polygon into caller provided storage.
+	/*!
+		\param p A polygon intersecting this shape.
+		\param intersects Cleared, then receives the intersections between this shape and the given polygon.
+		\sa GetCollision()
+	*/
+	virtual void GetIntersects(const Polygon &p, ArenaVector<Vector2> &intersects) const = 0;
+
+	//! Gets the intersection points of this shape and the given capsule into caller provided storage.
+	/*!
+		\param c A capsule intersecting this shape.
+		\param intersects Cleared, then receives the intersections between this shape and the given capsule.
+		\sa GetCollision()
+	*/
+	virtual void GetIntersects(const Capsule &c, ArenaVector<Vector2> &intersects) const = 0;
+
 	//! Gets the minimum vector to be applied to the given shape's position
 	//! in order to seperate it from this shape.
 	/*!
@@ -245,6 +348,104 @@ public:
 	*/
 	virtual const Vector2 GetDisplacement(const Polygon &p) const = 0;
 
+	//! Gets the minimum vector to be applied to the given oriented box's position
+	//! in order to seperate it from this shape.
+	/*!
+		\param b An oriented box intersecting this shape.
+		\return the minimum displacement vector.
+		\sa GetCollision()
+	*/
+	virtual const Vector2 GetDisplacement(const OrientedBox &b) const = 0;
+
+	//! Gets the minimum vector to be applied to the given box's position
+	//! in order to seperate it from this shape.
+	/*!
+		\param b A box intersecting this shape.
+		\return the minimum displacement vector.
+		\sa GetCollision()
+	*/
+	virtual const Vector2 GetDisplacement(const Box &b) const = 0;
+
+	//! Gets the minimum vector to be applied to the given capsule's position
+	//! in order to seperate it from this shape.
+	/*!
+		\param c A capsule intersecting this shape.
+		\return the minimum displacement vector.
+		\sa GetCollision()
+	*/
+	virtual const Vector2 GetDisplacement(const Capsule &c) const = 0;
+
+	//! Gets the minimum vector to be applied to the given shape's position
+	//! in order to seperate it from this shape, and whether the two overlap.
+	/*!
+		Unlike Overlaps() followed by GetDisplacement(), this separates the shapes only once.
+		\param s The shape to check against this shape.
+		\param overlaps Receives the result of Overlaps(s).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Shape &s, bool &overlaps) const = 0;
+
+	//! Gets the minimum vector to be applied to the given segment's position
+	//! in order to seperate it from this shape, and whether the two overlap.
+	/*!
+		\param s The segment to check against this shape.
+		\param overlaps Receives the result of Overlaps(s).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Segment &s, bool &overlaps) const = 0;
+
+	//! Gets the minimum vector to be applied to the given circle's position
+	//! in order to seperate it from this shape, and whether the two overlap.
+	/*!
+		\param c The circle to check against this shape.
+		\param overlaps Receives the result of Overlaps(c).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Circle &c, bool &overlaps) const = 0;
+
+	//! Gets the minimum vector to be applied to the given polygon's position
+	//! in order to seperate it from this shape, and whether the two overlap.
+	/*!
+		\param p The polygon to check against this shape.
+		\param overlaps Receives the result of Overlaps(p).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Polygon &p, bool &overlaps) const = 0;
+
+	//! Gets the minimum vector to be applied to the given oriented box's position
+	//! in order to seperate it from this shape, and whether the two overlap.
+	/*!
+		\param b The oriented box to check against this shape.
+		\param overlaps Receives the result of Overlaps(b).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const OrientedBox &b, bool &overlaps) const = 0;
+
+	//! Gets the minimum vector to be applied to the given box's position
+	//! in order to seperate it from this shape, and whether the two overlap.
+	/*!
+		\param b The box to check against this shape.
+		\param overlaps Receives the result of Overlaps(b).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Box &b, bool &overlaps) const = 0;
+
+	//! Gets the minimum vector to be applied to the given capsule's position
+	//! in order to seperate it from this shape, and whether the two overlap.
+	/*!
+		\param c The capsule to check against this shape.
+		\param overlaps Receives the result of Overlaps(c).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Capsule &c, bool &overlaps) const = 0;
+
 	//! Gets the collision of this shape with the given shape and returns the result.
 	/*!
 		\param s The shape to check for collision with this shape.
@@ -279,6 +480,78 @@ public:
 	*/
 	virtual const Collision GetCollision(const Polygon &p) const = 0;
 
+	//! Gets the collision of this shape with the given oriented box and returns the result.
+	/*!
+		\param b The oriented box to check for collision with this shape.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const OrientedBox &b) const = 0;
+
+	//! Gets the collision of this shape with the given box and returns the result.
+	/*!
+		\param b The box to check for collision with this shape.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Box &b) const = 0;
+
+	//! Gets the collision of this shape with the given capsule and returns the result.
+	/*!
+		\param c The capsule to check for collision with this shape.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Capsule &c) const = 0;
+
+	//! Gets the collision of this shape with the given shape, writing the intersection points into caller provided storage.
+	/*!
+		The returned collision holds no intersection points of its own, everything else matches
+		GetCollision(const Shape&). Pairs of circles and pairs of polygons make no heap allocations
+		once the buffer's arena has grown, other pairs are computed on the heap and copied.
+		\param s The shape to check for collision with this shape.
+		\param intersects Cleared, then receives the intersection points of the two shapes.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Shape &s, ArenaVector<Vector2> &intersects) const = 0;
+
+	//! Gets the collision of this shape with the given segment, writing the intersection points into caller provided storage.
+	/*!
+		\param s The segment to check for collision with this shape.
+		\param intersects Cleared, then receives the intersection points of the two shapes.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Segment &s, ArenaVector<Vector2> &intersects) const = 0;
+
+	//! Gets the collision of this shape with the given circle, writing the intersection points into caller provided storage.
+	/*!
+		\param c The circle to check for collision with this shape.
+		\param intersects Cleared, then receives the intersection points of the two shapes.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Circle &c, ArenaVector<Vector2> &intersects) const = 0;
+
+	//! Gets the collision of this shape with the given polygon, writing the intersection points into caller provided storage.
+	/*!
+		\param p The polygon to check for collision with this shape.
+		\param intersects Cleared, then receives the intersection points of the two shapes.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Polygon &p, ArenaVector<Vector2> &intersects) const = 0;
+
+	//! Gets the collision of this shape with the given capsule, writing the intersection points into caller provided storage.
+	/*!
+		\param c The capsule to check for collision with this shape.
+		\param intersects Cleared, then receives the intersection points of the two shapes.
+		\return The collision result including the minimum displacement vector.
+		\sa Contains()
+	*/
+	virtual const Collision GetCollision(const Capsule &c, ArenaVector<Vector2> &intersects) const = 0;
+
 	//! Projects the shape onto the given axis and returns the projection.
 	/*!
 		\param s The shape to project.
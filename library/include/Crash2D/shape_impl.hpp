@@ -59,6 +59,12 @@ public:
 	*/
 	virtual const std::vector<Vector2>& GetPoints() const override;
 
+	//! Gets the heap memory this shape holds.
+	/*!
+		\return The bytes reserved for the points of this shape.
+	*/
+	virtual const size_t GetMemoryUsage() const override;
+
 	//! Method used to caculate the overlap of two shapes
 	/*!
 		\param axes Axes used in calculations.
@@ -74,8 +80,236 @@ public:
 		\param b Shape b;
 	*/
 	virtual const Vector2 CalcDisplacement(const AxesVec &axes, const Shape &a, const Shape &b) const;
+
+	//! Removes axes parallel to an earlier axis in the given list.
+	/*!
+		Axes are sorted on a canonical direction key so parallel axes end up next to each other,
+		which makes this O(n log n). The first occurrence of each direction is kept and the
+		relative order of the remaining axes is preserved.
+		\param axes The unit axes to deduplicate.
+	*/
+	static void RemoveParallelAxes(AxesVec &axes);
+
+	//! Removes axes parallel to an earlier axis in the given list, with scratch space from the list's arena.
+	/*!
+		\param axes The unit axes to deduplicate.
+		\sa RemoveParallelAxes(AxesVec&)
+	*/
+	static void RemoveParallelAxes(ArenaVector<Axis> &axes);
 	
 
+	//! Checks if this shape intersects the given oriented box and returns the result.
+	/*!
+		Shapes without a dedicated kernel treat the box as a polygon.
+		\param b The oriented box to check for intersection with this shape.
+		\return Whether this shape intersects the given oriented box.
+	*/
+	virtual const bool Overlaps(const OrientedBox &b) const override;
+
+	//! Checks if this shape intersects the given box and returns the result.
+	/*!
+		Shapes without a dedicated kernel treat the box as a polygon.
+		\param b The box to check for intersection with this shape.
+		\return Whether this shape intersects the given box.
+	*/
+	virtual const bool Overlaps(const Box &b) const override;
+
+	//! Gets the minimum vector to be applied to the given oriented box's position
+	//! in order to seperate it from this shape.
+	/*!
+		Shapes without a dedicated kernel treat the box as a polygon.
+		\param b An oriented box intersecting this shape.
+		\return the minimum displacement vector.
+	*/
+	virtual const Vector2 GetDisplacement(const OrientedBox &b) const override;
+
+	//! Gets the minimum vector to be applied to the given box's position
+	//! in order to seperate it from this shape.
+	/*!
+		Shapes without a dedicated kernel treat the box as a polygon.
+		\param b A box intersecting this shape.
+		\return the minimum displacement vector.
+	*/
+	virtual const Vector2 GetDisplacement(const Box &b) const override;
+
+	//! Gets the minimum vector to be applied to the given shape's position
+	//! in order to seperate it from this shape, and whether the two overlap.
+	/*!
+		Shapes without a fused kernel test Overlaps() and then GetDisplacement().
+		\param s The shape to check against this shape.
+		\param overlaps Receives the result of Overlaps(s).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Shape &s, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given segment's position
+	//! in order to seperate it from this shape, and whether the two overlap.
+	/*!
+		Shapes without a fused kernel test Overlaps() and then GetDisplacement().
+		\param s The segment to check against this shape.
+		\param overlaps Receives the result of Overlaps(s).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Segment &s, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given circle's position
+	//! in order to seperate it from this shape, and whether the two overlap.
+	/*!
+		Shapes without a fused kernel test Overlaps() and then GetDisplacement().
+		\param c The circle to check against this shape.
+		\param overlaps Receives the result of Overlaps(c).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Circle &c, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given polygon's position
+	//! in order to seperate it from this shape, and whether the two overlap.
+	/*!
+		Shapes without a fused kernel test Overlaps() and then GetDisplacement().
+		\param p The polygon to check against this shape.
+		\param overlaps Receives the result of Overlaps(p).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Polygon &p, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given oriented box's position
+	//! in order to seperate it from this shape, and whether the two overlap.
+	/*!
+		Shapes without a dedicated kernel treat the box as a polygon.
+		\param b The oriented box to check against this shape.
+		\param overlaps Receives the result of Overlaps(b).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const OrientedBox &b, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given box's position
+	//! in order to seperate it from this shape, and whether the two overlap.
+	/*!
+		Shapes without a dedicated kernel treat the box as a polygon.
+		\param b The box to check against this shape.
+		\param overlaps Receives the result of Overlaps(b).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Box &b, bool &overlaps) const override;
+
+	//! Gets the minimum vector to be applied to the given capsule's position
+	//! in order to seperate it from this shape, and whether the two overlap.
+	/*!
+		Shapes without a fused kernel test Overlaps() and then GetDisplacement().
+		\param c The capsule to check against this shape.
+		\param overlaps Receives the result of Overlaps(c).
+		\return the minimum displacement vector, zero when the two do not overlap.
+		\sa Overlaps(), GetDisplacement()
+	*/
+	virtual const Vector2 GetDisplacement(const Capsule &c, bool &overlaps) const override;
+
+	//! Gets the collision of this shape with the given oriented box and returns the result.
+	/*!
+		Shapes without a dedicated kernel treat the box as a polygon.
+		\param b The oriented box to check for collision with this shape.
+		\return The collision result including the minimum displacement vector.
+	*/
+	virtual const Collision GetCollision(const OrientedBox &b) const override;
+
+	//! Gets the collision of this shape with the given box and returns the result.
+	/*!
+		Shapes without a dedicated kernel treat the box as a polygon.
+		\param b The box to check for collision with this shape.
+		\return The collision result including the minimum displacement vector.
+	*/
+	virtual const Collision GetCollision(const Box &b) const override;
+
+	//! Gets the intersection points of this shape and the given shape into caller provided storage.
+	/*!
+		Shapes without a dedicated kernel copy the result of GetIntersects(const Shape&).
+		\param s A shape intersecting this shape.
+		\param intersects Cleared, then receives the intersections between this shape and the given shape.
+	*/
+	virtual void GetIntersects(const Shape &s, ArenaVector<Vector2> &intersects) const override;
+
+	//! Gets the intersection points of this shape and the given segment into caller provided storage.
+	/*!
+		Shapes without a dedicated kernel copy the result of GetIntersects(const Segment&).
+		\param s A segment intersecting this shape.
+		\param intersects Cleared, then receives the intersections between this shape and the given segment.
+	*/
+	virtual void GetIntersects(const Segment &s, ArenaVector<Vector2> &intersects) const override;
+
+	//! Gets the intersection points of this shape and the given circle into caller provided storage.
+	/*!
+		Shapes without a dedicated kernel copy the result of GetIntersects(const Circle&).
+		\param c A circle intersecting this shape.
+		\param intersects Cleared, then receives the intersections between this shape and the given circle.
+	*/
+	virtual void GetIntersects(const Circle &c, ArenaVector<Vector2> &intersects) const override;
+
+	//! Gets the intersection points of this shape and the given polygon into caller provided storage.
+	/*!
+		Shapes without a dedicated kernel copy the result of GetIntersects(const Polygon&).
+		\param p A polygon intersecting this shape.
+		\param intersects Cleared, then receives the intersections between this shape and the given polygon.
+	*/
+	virtual void GetIntersects(const Polygon &p, ArenaVector<Vector2> &intersects) const override;
+
+	//! Gets the intersection points of this shape and the given capsule into caller provided storage.
+	/*!
+		Shapes without a dedicated kernel copy the result of GetIntersects(const Capsule&).
+		\param c A capsule intersecting this shape.
+		\param intersects Cleared, then receives the intersections between this shape and the given capsule.
+	*/
+	virtual void GetIntersects(const Capsule &c, ArenaVector<Vector2> &intersects) const override;
+
+	//! Gets the collision of this shape with the given shape, writing the intersection points into caller provided storage.
+	/*!
+		Shapes without a dedicated kernel move the points of GetCollision(const Shape&) into the buffer.
+		\param s The shape to check for collision with this shape.
+		\param intersects Cleared, then receives the intersection points of the two shapes.
+		\return The collision result including the minimum displacement vector.
+	*/
+	virtual const Collision GetCollision(const Shape &s, ArenaVector<Vector2> &intersects) const override;
+
+	//! Gets the collision of this shape with the given segment, writing the intersection points into caller provided storage.
+	/*!
+		Shapes without a dedicated kernel move the points of GetCollision(const Segment&) into the buffer.
+		\param s The segment to check for collision with this shape.
+		\param intersects Cleared, then receives the intersection points of the two shapes.
+		\return The collision result including the minimum displacement vector.
+	*/
+	virtual const Collision GetCollision(const Segment &s, ArenaVector<Vector2> &intersects) const override;
+
+	//! Gets the collision of this shape with the given circle, writing the intersection points into caller provided storage.
+	/*!
+		Shapes without a dedicated kernel move the points of GetCollision(const Circle&) into the buffer.
+		\param c The circle to check for collision with this shape.
+		\param intersects Cleared, then receives the intersection points of the two shapes.
+		\return The collision result including the minimum displacement vector.
+	*/
+	virtual const Collision GetCollision(const Circle &c, ArenaVector<Vector2> &intersects) const override;
+
+	//! Gets the collision of this shape with the given polygon, writing the intersection points into caller provided storage.
+	/*!
+		Shapes without a dedicated kernel move the points of GetCollision(const Polygon&) into the buffer.
+		\param p The polygon to check for collision with this shape.
+		\param intersects Cleared, then receives the intersection points of the two shapes.
+		\return The collision result including the minimum displacement vector.
+	*/
+	virtual const Collision GetCollision(const Polygon &p, ArenaVector<Vector2> &intersects) const override;
+
+	//! Gets the collision of this shape with the given capsule, writing the intersection points into caller provided storage.
+	/*!
+		Shapes without a dedicated kernel move the points of GetCollision(const Capsule&) into the buffer.
+		\param c The capsule to check for collision with this shape.
+		\param intersects Cleared, then receives the intersection points of the two shapes.
+		\return The collision result including the minimum displacement vector.
+	*/
+	virtual const Collision GetCollision(const Capsule &c, ArenaVector<Vector2> &intersects) const override;
+
 	//! Applies a transformation to this shape..
 	/*!
 		\param t The transformation to be applied.
@@ -89,8 +323,8 @@ public:
 
 protected:
 
-	std::vector<Vector2> _points; /*!< The points this shape is composed of. */
-	Vector2 _center; /*!< The center of this shape. */
+	mutable std::vector<Vector2> _points; /*!< The points this shape is composed of, mutable so shapes with deferred world geometry can refresh them. */
+	mutable Vector2 _center; /*!< The center of this shape. */
 };
 }
 
@@ -0,0 +1,303 @@
+#ifndef CRASH2D_SHAPE_POOL_HPP
+#define CRASH2D_SHAPE_POOL_HPP
+
+#include <Crash2D/shape.hpp>
+#include <Crash2D/memory.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace Crash2D
+{
+const unsigned POOL_SLAB_SIZE = 256; /*!< The default number of shapes in each slab a pool allocates. */
+
+//!  A reference to a shape owned by a ShapePool. */
+/*!
+	A handle stays safe to use after its shape is destroyed, the pool simply reports it as invalid.
+*/
+struct PoolHandle
+{
+	unsigned index; /*!< The slot of the shape in the pool. */
+	unsigned generation; /*!< The generation of the slot when the shape was created. */
+
+	inline bool operator == (const PoolHandle &h) const
+	{
+		return (index == h.index && generation == h.generation);
+	}
+	inline bool operator != (const PoolHandle &h) const
+	{
+		return !(*this == h);
+	}
+};
+
+//!  A pool that builds shapes in slabs, one per shape type, and hands out handles to them. */
+/*!
+	Each type of shape gets slabs of POOL_SLAB_SIZE shapes side by side. Destroyed shapes go on a free
+	list threaded through their own memory, so creating and destroying shapes at a steady rate stops
+	touching the heap for the shapes themselves once the slabs have grown. Slabs come from Allocate()
+	under MEMORY_SHAPES and are only returned when the pool is destroyed.
+
+	Handles are checked on use, so a stale handle is reported invalid rather than reaching a reused slot.
+	A pool is used by one thread at a time.
+*/
+class ShapePool
+{
+public:
+	//! Constructs an empty pool.
+	/*!
+		\param slabSize The number of shapes in each slab.
+	*/
+	ShapePool(const unsigned slabSize = POOL_SLAB_SIZE);
+
+	//! Destroys every shape still in the pool and returns the slabs.
+	~ShapePool();
+
+	ShapePool(const ShapePool&) = delete;
+	ShapePool& operator = (const ShapePool&) = delete;
+
+	//! Builds a shape in the pool.
+	/*!
+		If the constructor throws, the memory goes back on the free list and the exception is passed on.
+		\param args The arguments of the shape's constructor.
+		\return The handle of the new shape.
+	*/
+	template <typename T, typename... Args>
+	PoolHandle Create(Args&&... args)
+	{
+		static_assert(alignof(T) <= alignof(std::max_align_t), "Slabs are only aligned for fundamental types");
+
+		Slab<T> &slab = GetSlab<T>();
+		void *memory = slab.Take();
+		T *shape = nullptr;
+
+		try
+		{
+			shape = new (memory) T(std::forward<Args>(args)...);
+			return Insert(shape, shape, &slab);
+		}
+		catch (...)
+		{
+			// A shape that was built but got no slot is destroyed as well
+			if (shape)
+				slab.Destroy(shape);
+
+			else
+				slab.Give(memory);
+
+			throw;
+		}
+	}
+
+	//! Copies a shape into the pool.
+	/*!
+		\param s The shape to copy, a Circle, Segment, Capsule, Polygon, OrientedBox or Box.
+		\param h Receives the handle of the copy.
+		\return False if the shape is of another type, in which case nothing is created.
+	*/
+	const bool Clone(const Shape &s, PoolHandle &h);
+
+	//! Destroys a shape and puts its memory on the free list of its type.
+	/*!
+		\param h The handle of the shape, ignored if it is no longer valid.
+	*/
+	void Destroy(const PoolHandle &h);
+
+	//! Checks if a handle refers to a shape in this pool.
+	/*!
+		\param h The handle to check.
+		\return True if the shape has not been destroyed.
+	*/
+	const bool IsValid(const PoolHandle &h) const;
+
+	//! Gets a shape.
+	/*!
+		\param h The handle of the shape.
+		\return The shape, or nullptr if the handle is no longer valid.
+	*/
+	Shape* Get(const PoolHandle &h) const;
+
+	//! Gets the number of shapes in this pool.
+	/*!
+		\return The number of shapes.
+	*/
+	const unsigned GetCount() const;
+
+	//! Gets the heap memory this pool holds.
+	/*!
+		\return The bytes of the slabs and of the storage the shapes in them own.
+	*/
+	const size_t GetMemoryUsage() const;
+
+protected:
+	//! The slabs of one shape type, seen without the type.
+	class SlabBase
+	{
+	public:
+		virtual ~SlabBase() = default;
+
+		//! Destroys a shape and puts its memory on the free list.
+		virtual void Destroy(void *p) = 0;
+
+		//! Gets the bytes of the slabs.
+		virtual const size_t GetSize() const = 0;
+	};
+
+	//! The slabs of one shape type, with a free list threaded through the unused entries.
+	template <typename T>
+	class Slab : public SlabBase
+	{
+	public:
+		Slab(const unsigned size) : _size(size), _free(nullptr) {}
+
+		virtual ~Slab()
+		{
+			for (auto && s : _slabs)
+				Deallocate(s, _size * sizeof(T), MEMORY_SHAPES);
+		}
+
+		//! Takes memory for one shape off the free list, adding a slab if it is empty.
+		void* Take()
+		{
+			if (!_free)
+				Grow();
+
+			Entry *e = _free;
+			_free = e->next;
+
+			return e;
+		}
+
+		//! Puts memory taken for a shape that was never built back on the free list.
+		void Give(void *p)
+		{
+			Entry *e = static_cast<Entry*>(p);
+			e->next = _free;
+			_free = e;
+		}
+
+		virtual void Destroy(void *p) override
+		{
+			static_cast<T*>(p)->~T();
+			Give(p);
+		}
+
+		virtual const size_t GetSize() const override
+		{
+			return _slabs.size() * _size * sizeof(T);
+		}
+
+	private:
+		//! An unused entry, overlaying the memory of a shape.
+		union Entry
+		{
+			Entry *next; /*!< The next unused entry. */
+			typename std::aligned_storage<sizeof(T), alignof(T)>::type storage; /*!< The memory of a shape. */
+		};
+
+		//! Adds a slab and puts its entries on the free list, first entry first.
+		void Grow()
+		{
+			// The entry is made first, so no slab is lost if growing the list throws
+			_slabs.push_back(nullptr);
+
+			try
+			{
+				_slabs.back() = static_cast<Entry*>(Allocate(_size * sizeof(Entry), MEMORY_SHAPES));
+			}
+
+			catch (...)
+			{
+				_slabs.pop_back();
+				throw;
+			}
+
+			Entry *slab = _slabs.back();
+
+			for (unsigned i = _size; i > 0; i--)
+			{
+				slab[i - 1].next = _free;
+				_free = &slab[i - 1];
+			}
+		}
+
+		static_assert(sizeof(Entry) == sizeof(T), "A shape is always larger than a pointer");
+
+		unsigned _size; /*!< The number of shapes in each slab. */
+		std::vector<Entry*> _slabs; /*!< Every slab. */
+		Entry *_free; /*!< The first unused entry. */
+	};
+
+	//! A shape and the bookkeeping for its slot.
+	struct Slot
+	{
+		Shape *shape; /*!< The shape, or nullptr if the slot is free. */
+		void *object; /*!< The start of the shape's memory in its slab. */
+		SlabBase *slab; /*!< The slabs the shape lives in. */
+		unsigned generation; /*!< Bumped every time the shape in the slot is destroyed. */
+	};
+
+	typedef PoolHandle (*Cloner)(ShapePool &pool, const void *s); /**< Copies a whole shape object of a known type into a pool. */
+
+	//! Copies a whole shape object into a pool.
+	/*!
+		\param pool The pool.
+		\param s The most derived object of the shape, which must be a T.
+		\return The handle of the copy.
+	*/
+	template <typename T>
+	static PoolHandle CloneAs(ShapePool &pool, const void *s)
+	{
+		return pool.Create<T>(*static_cast<const T*>(s));
+	}
+
+	//! Gets a number for a new shape type.
+	static const unsigned NextType();
+
+	//! Gets the number of a shape type, the same in every pool.
+	template <typename T>
+	static const unsigned GetType()
+	{
+		static const unsigned type = NextType();
+
+		return type;
+	}
+
+	//! Gets the slabs of a shape type, creating them on first use.
+	template <typename T>
+	Slab<T>& GetSlab()
+	{
+		const unsigned type = GetType<T>();
+
+		if (type >= _slabs.size())
+			_slabs.resize(type + 1);
+
+		if (!_slabs[type])
+			_slabs[type].reset(new Slab<T>(_slabSize));
+
+		return static_cast<Slab<T>&>(*_slabs[type]);
+	}
+
+	//! Gives a new shape a slot.
+	/*!
+		\param s The shape.
+		\param object The start of the shape's memory in its slab.
+		\param slab The slabs the shape lives in.
+		\return The handle of the shape.
+	*/
+	PoolHandle Insert(Shape *s, void *object, SlabBase *slab);
+
+	std::vector<std::unique_ptr<SlabBase>> _slabs; /*!< The slabs of every shape type used, indexed by GetType(). */
+	std::vector<std::pair<const std::type_info*, Cloner>> _cloners; /*!< The types Clone() has resolved. */
+	std::vector<Slot> _slots; /*!< The shapes, indexed by slot. */
+	std::vector<unsigned> _free; /*!< Slots available for reuse. */
+	unsigned _slabSize; /*!< The number of shapes in each slab. */
+	unsigned _count; /*!< The number of shapes. */
+};
+}
+
+#endif
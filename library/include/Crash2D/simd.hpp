@@ -0,0 +1,207 @@
+#ifndef CRASH2D_SIMD_HPP
+#define CRASH2D_SIMD_HPP
+
+#include <Crash2D/vector2.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+// Pick the widest float lane type the target guarantees, define CRASH2D_NO_SIMD to force the scalar path.
+// 32 bit NEON flushes denormals and estimates division, so CRASH2D_DETERMINISTIC only keeps it on AArch64.
+#if !defined(CRASH2D_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define CRASH2D_SIMD_SSE2
+#include <emmintrin.h>
+#elif !defined(CRASH2D_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__)) && (!defined(CRASH2D_DETERMINISTIC) || defined(__aarch64__))
+#define CRASH2D_SIMD_NEON
+#include <arm_neon.h>
+#else
+#define CRASH2D_SIMD_SCALAR
+#endif
+
+namespace Crash2D
+{
+//!  A minimal portable abstraction over four float lanes. */
+/*!
+	Backed by SSE2 on x86, NEON on ARM, and a plain array elsewhere. Every backend
+	performs the same IEEE operations per lane, so results match the scalar code exactly.
+*/
+namespace Simd
+{
+const unsigned WIDTH = 4; /*!< The number of lanes in a Float4. */
+
+#if defined(CRASH2D_SIMD_SSE2)
+static_assert(sizeof(Precision_t) == sizeof(float), "SSE2 kernels require Precision_t to be float");
+
+typedef __m128 Float4;
+
+inline Float4 Set1(const Precision_t v) { return _mm_set1_ps(v); }
+inline Float4 Load(const Precision_t *p) { return _mm_loadu_ps(p); }
+inline void Store(Precision_t *p, const Float4 v) { _mm_storeu_ps(p, v); }
+inline Float4 Add(const Float4 a, const Float4 b) { return _mm_add_ps(a, b); }
+inline Float4 Sub(const Float4 a, const Float4 b) { return _mm_sub_ps(a, b); }
+inline Float4 Mul(const Float4 a, const Float4 b) { return _mm_mul_ps(a, b); }
+inline Float4 Min(const Float4 a, const Float4 b) { return _mm_min_ps(a, b); }
+inline Float4 Max(const Float4 a, const Float4 b) { return _mm_max_ps(a, b); }
+inline Float4 Div(const Float4 a, const Float4 b) { return _mm_div_ps(a, b); }
+inline Float4 Sqrt(const Float4 a) { return _mm_sqrt_ps(a); }
+
+typedef __m128 Mask4;
+
+inline Mask4 LessEqual(const Float4 a, const Float4 b) { return _mm_cmple_ps(a, b); }
+inline Mask4 Greater(const Float4 a, const Float4 b) { return _mm_cmpgt_ps(a, b); }
+inline Float4 Select(const Mask4 m, const Float4 a, const Float4 b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+inline unsigned ToBits(const Mask4 m) { return _mm_movemask_ps(m); }
+
+//! Loads four interleaved (x, y) pairs and splits them into x and y lanes.
+inline void LoadPairs(const Precision_t *p, Float4 &x, Float4 &y)
+{
+	const __m128 lo = _mm_loadu_ps(p);
+	const __m128 hi = _mm_loadu_ps(p + 4);
+
+	x = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+	y = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+//! Interleaves x and y lanes into four (x, y) pairs and stores them.
+inline void StorePairs(Precision_t *p, const Float4 x, const Float4 y)
+{
+	_mm_storeu_ps(p, _mm_unpacklo_ps(x, y));
+	_mm_storeu_ps(p + 4, _mm_unpackhi_ps(x, y));
+}
+
+#elif defined(CRASH2D_SIMD_NEON)
+static_assert(sizeof(Precision_t) == sizeof(float), "NEON kernels require Precision_t to be float");
+
+typedef float32x4_t Float4;
+
+inline Float4 Set1(const Precision_t v) { return vdupq_n_f32(v); }
+inline Float4 Load(const Precision_t *p) { return vld1q_f32(p); }
+inline void Store(Precision_t *p, const Float4 v) { vst1q_f32(p, v); }
+inline Float4 Add(const Float4 a, const Float4 b) { return vaddq_f32(a, b); }
+inline Float4 Sub(const Float4 a, const Float4 b) { return vsubq_f32(a, b); }
+inline Float4 Mul(const Float4 a, const Float4 b) { return vmulq_f32(a, b); }
+inline Float4 Min(const Float4 a, const Float4 b) { return vminq_f32(a, b); }
+inline Float4 Max(const Float4 a, const Float4 b) { return vmaxq_f32(a, b); }
+
+#if defined(__aarch64__)
+inline Float4 Div(const Float4 a, const Float4 b) { return vdivq_f32(a, b); }
+inline Float4 Sqrt(const Float4 a) { return vsqrtq_f32(a); }
+#else
+inline Float4 Div(const Float4 a, const Float4 b)
+{
+	float x[4], y[4];
+	vst1q_f32(x, a);
+	vst1q_f32(y, b);
+
+	for (unsigned i = 0; i < 4; i++)
+		x[i] /= y[i];
+
+	return vld1q_f32(x);
+}
+inline Float4 Sqrt(const Float4 a)
+{
+	float x[4];
+	vst1q_f32(x, a);
+
+	for (unsigned i = 0; i < 4; i++)
+		x[i] = std::sqrt(x[i]);
+
+	return vld1q_f32(x);
+}
+#endif
+
+typedef uint32x4_t Mask4;
+
+inline Mask4 LessEqual(const Float4 a, const Float4 b) { return vcleq_f32(a, b); }
+inline Mask4 Greater(const Float4 a, const Float4 b) { return vcgtq_f32(a, b); }
+inline Float4 Select(const Mask4 m, const Float4 a, const Float4 b) { return vbslq_f32(m, a, b); }
+inline unsigned ToBits(const Mask4 m)
+{
+	return (vgetq_lane_u32(m, 0) & 1) | (vgetq_lane_u32(m, 1) & 2) | (vgetq_lane_u32(m, 2) & 4) | (vgetq_lane_u32(m, 3) & 8);
+}
+
+//! Loads four interleaved (x, y) pairs and splits them into x and y lanes.
+inline void LoadPairs(const Precision_t *p, Float4 &x, Float4 &y)
+{
+	const float32x4x2_t v = vld2q_f32(p);
+
+	x = v.val[0];
+	y = v.val[1];
+}
+
+//! Interleaves x and y lanes into four (x, y) pairs and stores them.
+inline void StorePairs(Precision_t *p, const Float4 x, const Float4 y)
+{
+	float32x4x2_t v;
+	v.val[0] = x;
+	v.val[1] = y;
+
+	vst2q_f32(p, v);
+}
+
+#else
+struct Float4
+{
+	Precision_t v[WIDTH];
+};
+
+inline Float4 Set1(const Precision_t v) { return Float4{{ v, v, v, v }}; }
+inline Float4 Load(const Precision_t *p) { return Float4{{ p[0], p[1], p[2], p[3] }}; }
+inline void Store(Precision_t *p, const Float4 a) { std::copy(a.v, a.v + WIDTH, p); }
+inline Float4 Add(const Float4 a, const Float4 b) { return Float4{{ a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] }}; }
+inline Float4 Sub(const Float4 a, const Float4 b) { return Float4{{ a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] }}; }
+inline Float4 Mul(const Float4 a, const Float4 b) { return Float4{{ a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] }}; }
+inline Float4 Min(const Float4 a, const Float4 b) { return Float4{{ std::min(a.v[0], b.v[0]), std::min(a.v[1], b.v[1]), std::min(a.v[2], b.v[2]), std::min(a.v[3], b.v[3]) }}; }
+inline Float4 Max(const Float4 a, const Float4 b) { return Float4{{ std::max(a.v[0], b.v[0]), std::max(a.v[1], b.v[1]), std::max(a.v[2], b.v[2]), std::max(a.v[3], b.v[3]) }}; }
+inline Float4 Div(const Float4 a, const Float4 b) { return Float4{{ a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3] }}; }
+inline Float4 Sqrt(const Float4 a) { return Float4{{ std::sqrt(a.v[0]), std::sqrt(a.v[1]), std::sqrt(a.v[2]), std::sqrt(a.v[3]) }}; }
+
+struct Mask4
+{
+	bool v[WIDTH];
+};
+
+inline Mask4 LessEqual(const Float4 a, const Float4 b) { return Mask4{{ a.v[0] <= b.v[0], a.v[1] <= b.v[1], a.v[2] <= b.v[2], a.v[3] <= b.v[3] }}; }
+inline Mask4 Greater(const Float4 a, const Float4 b) { return Mask4{{ a.v[0] > b.v[0], a.v[1] > b.v[1], a.v[2] > b.v[2], a.v[3] > b.v[3] }}; }
+inline Float4 Select(const Mask4 m, const Float4 a, const Float4 b) { return Float4{{ m.v[0] ? a.v[0] : b.v[0], m.v[1] ? a.v[1] : b.v[1], m.v[2] ? a.v[2] : b.v[2], m.v[3] ? a.v[3] : b.v[3] }}; }
+inline unsigned ToBits(const Mask4 m) { return (m.v[0] ? 1 : 0) | (m.v[1] ? 2 : 0) | (m.v[2] ? 4 : 0) | (m.v[3] ? 8 : 0); }
+
+//! Loads four interleaved (x, y) pairs and splits them into x and y lanes.
+inline void LoadPairs(const Precision_t *p, Float4 &x, Float4 &y)
+{
+	x = Float4{{ p[0], p[2], p[4], p[6] }};
+	y = Float4{{ p[1], p[3], p[5], p[7] }};
+}
+
+//! Interleaves x and y lanes into four (x, y) pairs and stores them.
+inline void StorePairs(Precision_t *p, const Float4 x, const Float4 y)
+{
+	for (unsigned i = 0; i < WIDTH; i++)
+	{
+		p[2 * i] = x.v[i];
+		p[2 * i + 1] = y.v[i];
+	}
+}
+#endif
+
+//! Gets the smallest of the four lanes.
+inline Precision_t ReduceMin(const Float4 a)
+{
+	Precision_t v[WIDTH];
+	Store(v, a);
+
+	return std::min(std::min(v[0], v[1]), std::min(v[2], v[3]));
+}
+
+//! Gets the largest of the four lanes.
+inline Precision_t ReduceMax(const Float4 a)
+{
+	Precision_t v[WIDTH];
+	Store(v, a);
+
+	return std::max(std::max(v[0], v[1]), std::max(v[2], v[3]));
+}
+}
+}
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef CRASH2D_SWEEP_BROADPHASE_HPP
+#define CRASH2D_SWEEP_BROADPHASE_HPP
+
+#include <Crash2D/bounds.hpp>
+#include <Crash2D/collision_filter.hpp>
+#include <Crash2D/counters.hpp>
+#include <Crash2D/memory.hpp>
+
+#include <algorithm>
+
+namespace Crash2D
+{
+const unsigned SWEEP_SORT_MOVES = 8; /*!< The average moves per proxy after which SweepBroadphase stops its insertion sort and sorts from scratch. */
+
+//!  A pair of proxies whose bounding boxes overlap. */
+struct ProxyPair
+{
+	unsigned first; /*!< The smaller id of the pair. */
+	unsigned second; /*!< The larger id of the pair. */
+
+	inline bool operator == (const ProxyPair &p) const
+	{
+		return (first == p.first && second == p.second);
+	}
+	inline bool operator < (const ProxyPair &p) const
+	{
+		return (first < p.first || (first == p.first && second < p.second));
+	}
+};
+
+//!  A class finding overlapping bounding boxes by sorting them along the x axis and sweeping. */
+/*!
+	Proxies are identified by small caller chosen ids. The sort order is kept between calls
+	to FindPairs(), so objects that move a little each frame are re-sorted in close to linear time.
+
+	Proxies are either awake or asleep. Static and resting objects should be put to sleep:
+	sleeping proxies are kept in their own sorted list and are only paired with awake ones,
+	so pairs between them cost nothing. Removing a proxy or moving it between the lists takes
+	constant time, the lists drop the ids that left them on the next call to FindPairs().
+
+	Each proxy also has a CollisionFilter, checked during the sweep so rejected pairs are
+	never written out.
+*/
+class SweepBroadphase
+{
+public:
+	//! Constructs an empty broadphase.
+	/*!
+	*/
+	SweepBroadphase();
+
+	//! Adds a proxy with the given id and bounds.
+	/*!
+		\param id The id of the proxy, which must not already be in use.
+		\param b The bounds of the proxy.
+		\param awake False to add the proxy asleep.
+	*/
+	void Insert(const unsigned id, const Bounds &b, const bool awake = true);
+
+	//! Sets the bounds of a proxy.
+	/*!
+		\param id The id of the proxy.
+		\param b The new bounds of the proxy.
+	*/
+	void Update(const unsigned id, const Bounds &b);
+
+	//! Removes a proxy.
+	/*!
+		\param id The id of the proxy.
+	*/
+	void Remove(const unsigned id);
+
+	//! Removes every proxy.
+	/*!
+	*/
+	void Clear();
+
+	//! Checks if a proxy with the given id exists.
+	/*!
+		\param id The id to check.
+		\return True if the proxy exists.
+	*/
+	const bool Contains(const unsigned id) const;
+
+	//! Gets the bounds of a proxy.
+	/*!
+		\param id The id of the proxy.
+		\return The bounds of the proxy.
+	*/
+	const Bounds& GetBounds(const unsigned id) const;
+
+	//! Wakes a proxy or puts it to sleep.
+	/*!
+		\param id The id of the proxy.
+		\param awake True to wake the proxy, false to put it to sleep.
+	*/
+	void SetAwake(const unsigned id, const bool awake);
+
+	//! Checks if a proxy is awake.
+	/*!
+		\param id The id of the proxy.
+		\return True if the proxy is awake.
+	*/
+	const bool IsAwake(const unsigned id) const;
+
+	//! Sets the collision filter of a proxy.
+	/*!
+		\param id The id of the proxy.
+		\param f The new filter.
+	*/
+	void SetFilter(const unsigned id, const CollisionFilter &f);
+
+	//! Gets the collision filter of a proxy.
+	/*!
+		\param id The id of the proxy.
+		\return The filter of the proxy.
+	*/
+	const CollisionFilter& GetFilter(const unsigned id) const;
+
+	//! Gets the number of proxies.
+	/*!
+		\return The number of proxies.
+	*/
+	const unsigned GetSize() const;
+
+	//! Finds every pair of proxies whose bounds overlap, whose filters accept each other and of which at least one is awake.
+	/*!
+		\param pairs Receives the pairs, sorted by id so the result does not depend on the sort order.
+	*/
+	void FindPairs(std::vector<ProxyPair> &pairs);
+
+protected:
+	//! The lists an id has an entry in, which may be stale until the next FindPairs().
+	enum Listed
+	{
+		LISTED_AWAKE = 1, /*!< The id has an entry in the awake list. */
+		LISTED_SLEEPING = 2 /*!< The id has an entry in the sleeping list. */
+	};
+
+	//! Makes sure a proxy has an entry in the awake or the sleeping list.
+	/*!
+		\param id The id of the proxy.
+		\param awake True for the awake list, false for the sleeping one.
+	*/
+	void List(const unsigned id, const bool awake);
+
+	//! Drops the entries of proxies that were removed or moved to the other list.
+	/*!
+		\param order The list.
+		\param awake True if it is the awake list.
+	*/
+	void Compact(TaggedVector<unsigned, MEMORY_BROADPHASE> &order, const bool awake);
+
+	//! Re-sorts a list of proxies by the left edge of their bounds.
+	/*!
+		Linear for an almost sorted list, and O(n log n) otherwise.
+		\param order The ids to sort.
+	*/
+	void Sort(TaggedVector<unsigned, MEMORY_BROADPHASE> &order);
+
+	//! Checks if one proxy comes before another in the sort order.
+	/*!
+		\param a The id of the first proxy.
+		\param b The id of the second proxy.
+		\return True if a starts further left than b, or at the same place with a smaller id.
+	*/
+	inline const bool Before(const unsigned a, const unsigned b) const
+	{
+		const Precision_t ax = _bounds[a].min.x;
+		const Precision_t bx = _bounds[b].min.x;
+
+		return (ax < bx || (ax == bx && a < b));
+	}
+
+	//! Adds the pair of two proxies to the output if their filters accept each other and their bounds overlap on the y axis.
+	/*!
+		\param a The id of the first proxy.
+		\param b The id of the second proxy.
+		\param pairs The output pairs.
+	*/
+	inline void AddIfOverlapping(const unsigned a, const unsigned b, std::vector<ProxyPair> &pairs) const
+	{
+		const Bounds &bA = _bounds[a];
+		const Bounds &bB = _bounds[b];
+
+		CRASH2D_COUNT(COUNTER_BOUNDS_TESTS, 1);
+
+		if (bA.min.y <= bB.max.y && bB.min.y <= bA.max.y && _filters[a].Accepts(_filters[b]))
+			pairs.push_back({ std::min(a, b), std::max(a, b) });
+	}
+
+	TaggedVector<Bounds, MEMORY_BROADPHASE> _bounds; /*!< The bounds of each proxy, indexed by id. */
+	TaggedVector<unsigned char, MEMORY_BROADPHASE> _active; /*!< Whether each id is in use. */
+	TaggedVector<unsigned char, MEMORY_BROADPHASE> _awake; /*!< Whether each id is awake. */
+	TaggedVector<unsigned char, MEMORY_BROADPHASE> _listed; /*!< The Listed flags of each id. */
+	TaggedVector<CollisionFilter, MEMORY_BROADPHASE> _filters; /*!< The filter of each proxy, indexed by id. */
+	TaggedVector<unsigned, MEMORY_BROADPHASE> _order; /*!< The awake ids, sorted by the left edge of their bounds. */
+	TaggedVector<unsigned, MEMORY_BROADPHASE> _sleeping; /*!< The sleeping ids, sorted by the left edge of their bounds. */
+	unsigned _count; /*!< The number of proxies. */
+	bool _stale; /*!< Whether either list may hold entries to drop. */
+};
+}
+
+#endif
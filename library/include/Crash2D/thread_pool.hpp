@@ -0,0 +1,75 @@
+#ifndef CRASH2D_THREAD_POOL_HPP
+#define CRASH2D_THREAD_POOL_HPP
+
+#include <Crash2D/scheduler.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Crash2D
+{
+//!  A work-stealing Scheduler backed by its own threads. */
+/*!
+	Each batch is split into one contiguous block of tasks per worker. A worker that runs
+	out of tasks steals from the back of another worker's block. The thread calling Run()
+	works as worker zero.
+*/
+class ThreadPool : public Scheduler
+{
+public:
+	//! Constructs a pool with the given number of workers.
+	/*!
+		\param workers The number of workers including the calling thread, at least one.
+	*/
+	explicit ThreadPool(const unsigned workers = std::thread::hardware_concurrency());
+
+	//! Destructor, stops and joins the threads.
+	/*!
+	*/
+	virtual ~ThreadPool();
+
+	virtual const unsigned GetWorkerCount() const override;
+
+	virtual void Run(const unsigned count, const Task &task) override;
+
+protected:
+	//! The tasks queued on one worker.
+	struct Queue
+	{
+		std::mutex mutex; /*!< Guards the tasks. */
+		std::deque<unsigned> tasks; /*!< The indices of the queued tasks. */
+	};
+
+	//! Waits for batches and works on them until the pool stops.
+	/*!
+		\param worker The index of the worker.
+	*/
+	void WorkerLoop(const unsigned worker);
+
+	//! Runs one task from the worker's own queue, or one stolen from another queue.
+	/*!
+		\param worker The index of the worker.
+		\return False if every queue is empty.
+	*/
+	const bool RunOne(const unsigned worker);
+
+	std::vector<std::thread> _threads; /*!< The threads of workers one and up. */
+	std::vector<std::unique_ptr<Queue>> _queues; /*!< One queue per worker. */
+
+	std::mutex _mutex; /*!< Guards the batch state below. */
+	std::condition_variable _wake; /*!< Signalled when a batch starts or the pool stops. */
+	std::condition_variable _done; /*!< Signalled when the last task of a batch finishes. */
+
+	const Task *_task; /*!< The task of the current batch. */
+	std::atomic<unsigned> _pending; /*!< The number of tasks of the current batch still to finish. */
+	unsigned _batch; /*!< Incremented every time a batch starts. */
+	bool _stop; /*!< Whether the threads should exit. */
+};
+}
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef CRASH2D_TRACE_HPP
+#define CRASH2D_TRACE_HPP
+
+#include <cstdint>
+#include <ostream>
+
+namespace Crash2D
+{
+const unsigned TRACE_CAPACITY = 1 << 16; /*!< The number of spans each thread keeps, older ones are overwritten. */
+
+//!  A timed span of work recorded by a thread. */
+struct TraceEvent
+{
+	const char *name; /*!< The name of the span, a string literal. */
+	uint64_t start; /*!< The start time in nanoseconds since tracing began. */
+	uint64_t duration; /*!< The length of the span in nanoseconds. */
+};
+
+//!  Records the time between its construction and destruction as a span of the calling thread. */
+/*!
+	Spans are only recorded when the library is built with CRASH2D_TRACE defined, use the
+	CRASH2D_ZONE and CRASH2D_QUERY_ZONE macros so zones compile away otherwise.
+	Each thread writes its spans to its own ring buffer without locking.
+*/
+class TraceZone
+{
+public:
+	//! Starts a span.
+	/*!
+		\param name The name of the span, which must outlive the trace, usually a string literal.
+		\param enabled Whether to record the span.
+	*/
+	TraceZone(const char *name, const bool enabled = true);
+
+	//! Ends the span and records it.
+	~TraceZone();
+
+	TraceZone(const TraceZone&) = delete;
+	TraceZone& operator = (const TraceZone&) = delete;
+
+protected:
+	const char *_name; /*!< The name of the span, or null if it is not recorded. */
+	uint64_t _start; /*!< The start time in nanoseconds since tracing began. */
+};
+
+//! Checks if the library was built with tracing.
+/*!
+	\return True if CRASH2D_TRACE was defined when the library was built.
+*/
+const bool TracingEnabled();
+
+//! Sets whether individual shape queries are traced as well as the pipeline phases.
+/*!
+	Query spans are short and numerous, so they are off by default.
+	\param enabled Whether to record query spans.
+*/
+void SetQueryTracing(const bool enabled);
+
+//! Checks if individual shape queries are traced.
+/*!
+	\return True if query spans are recorded.
+*/
+const bool GetQueryTracing();
+
+//! Writes the spans of every thread as Chrome trace JSON.
+/*!
+	The output loads in chrome://tracing and Perfetto, one track per thread.
+	Threads must not record while the trace is written, so write it between steps.
+	\param out The stream to write to.
+*/
+void WriteTrace(std::ostream &out);
+
+//! Discards the spans of every thread.
+/*!
+	Threads must not record while the trace is cleared.
+*/
+void ClearTrace();
+
+#define CRASH2D_TRACE_JOIN2(a, b) a##b
+#define CRASH2D_TRACE_JOIN(a, b) CRASH2D_TRACE_JOIN2(a, b)
+
+#ifdef CRASH2D_TRACE
+
+#define CRASH2D_ZONE(name) ::Crash2D::TraceZone CRASH2D_TRACE_JOIN(crash2dZone, __LINE__)(name)
+#define CRASH2D_QUERY_ZONE(name) ::Crash2D::TraceZone CRASH2D_TRACE_JOIN(crash2dZone, __LINE__)(name, ::Crash2D::GetQueryTracing())
+
+#else
+
+#define CRASH2D_ZONE(name) ((void)0)
+#define CRASH2D_QUERY_ZONE(name) ((void)0)
+
+#endif
+}
+
+#endif
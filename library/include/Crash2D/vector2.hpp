@@ -7,9 +7,20 @@ namespace Crash2D
 {
 using Precision_t = float;
 const Precision_t EPS = 1e-12;
+const Precision_t CMP_TOLERANCE = 0.1; /*!< The absolute tolerance used by AreEqual(). */
+const Precision_t PARALLEL_TOLERANCE = 1e-4; /*!< The largest cross product of two unit axes that are treated as parallel. */
 
 bool AreEqual(Precision_t a, Precision_t b);
 
+//! Calculates one over the square root of the given value.
+/*!
+	Exact by default. Defining CRASH2D_FAST_MATH when building the library swaps in the
+	hardware estimate refined by one Newton step, accurate to roughly 1e-6 relative error.
+	\param v The value, which must be positive.
+	\return One over the square root of v.
+*/
+Precision_t InverseSqrt(Precision_t v);
+
 //!  A class representing a two-dimensional vector. */
 class Vector2
 {
@@ -0,0 +1,111 @@
+#include <Crash2D/affine_matrix.hpp>
+#include <Crash2D/simd.hpp>
+
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265359
+#endif
+
+namespace Crash2D
+{
+static_assert(sizeof(Vector2) == 2 * sizeof(Precision_t), "Points are read as packed (x, y) pairs");
+
+AffineMatrix::AffineMatrix() : a(1), b(0), c(0), d(1), tx(0), ty(0)
+{
+}
+
+AffineMatrix::AffineMatrix(const Precision_t a, const Precision_t b, const Precision_t c, const Precision_t d, const Precision_t tx, const Precision_t ty)
+	: a(a), b(b), c(c), d(d), tx(tx), ty(ty)
+{
+}
+
+AffineMatrix::AffineMatrix(const Transformation &t)
+{
+	const Precision_t radians = (t.GetRotation() * M_PI) / 180;
+	const Precision_t s = std::sin(radians);
+	const Precision_t co = std::cos(radians);
+
+	const Vector2 &scale = t.GetScale();
+	const Vector2 &pivot = t.GetPivot();
+
+	// Rotation times scale
+	a = co * scale.x;
+	b = s * scale.x;
+	c = -s * scale.y;
+	d = co * scale.y;
+
+	// Both happen about the pivot, then the translation applies
+	tx = pivot.x - (a * pivot.x + c * pivot.y) + t.GetTranslation().x;
+	ty = pivot.y - (b * pivot.x + d * pivot.y) + t.GetTranslation().y;
+}
+
+const AffineMatrix AffineMatrix::Compose(const AffineMatrix &m) const
+{
+	return AffineMatrix(
+		a * m.a + c * m.b,
+		b * m.a + d * m.b,
+		a * m.c + c * m.d,
+		b * m.c + d * m.d,
+		a * m.tx + c * m.ty + tx,
+		b * m.tx + d * m.ty + ty);
+}
+
+const AffineMatrix AffineMatrix::Inverse() const
+{
+	const Precision_t det = GetDeterminant();
+
+	if (det == 0)
+		return AffineMatrix(0, 0, 0, 0, 0, 0);
+
+	const Precision_t inv = 1 / det;
+
+	const Precision_t ia = d * inv;
+	const Precision_t ib = -b * inv;
+	const Precision_t ic = -c * inv;
+	const Precision_t id = a * inv;
+
+	return AffineMatrix(ia, ib, ic, id, -(ia * tx + ic * ty), -(ib * tx + id * ty));
+}
+
+const Precision_t AffineMatrix::GetDeterminant() const
+{
+	return a * d - b * c;
+}
+
+const Vector2 AffineMatrix::TransformPoint(const Vector2 &p) const
+{
+	return Vector2(a * p.x + c * p.y + tx, b * p.x + d * p.y + ty);
+}
+
+void AffineMatrix::TransformPoints(const Vector2 *in, Vector2 *out, const unsigned n) const
+{
+	const Simd::Float4 va = Simd::Set1(a);
+	const Simd::Float4 vb = Simd::Set1(b);
+	const Simd::Float4 vc = Simd::Set1(c);
+	const Simd::Float4 vd = Simd::Set1(d);
+	const Simd::Float4 vtx = Simd::Set1(tx);
+	const Simd::Float4 vty = Simd::Set1(ty);
+
+	unsigned i = 0;
+
+	for (; i + Simd::WIDTH <= n; i += Simd::WIDTH)
+	{
+		Simd::Float4 x, y;
+		Simd::LoadPairs(&in[i].x, x, y);
+
+		const Simd::Float4 nx = Simd::Add(Simd::Add(Simd::Mul(va, x), Simd::Mul(vc, y)), vtx);
+		const Simd::Float4 ny = Simd::Add(Simd::Add(Simd::Mul(vb, x), Simd::Mul(vd, y)), vty);
+
+		Simd::StorePairs(&out[i].x, nx, ny);
+	}
+
+	for (; i < n; i++)
+		out[i] = TransformPoint(in[i]);
+}
+
+void AffineMatrix::TransformPoints(std::vector<Vector2> &points) const
+{
+	TransformPoints(points.data(), points.data(), points.size());
+}
+}
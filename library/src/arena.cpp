@@ -0,0 +1,67 @@
+#include <Crash2D/arena.hpp>
+
+#include <algorithm>
+
+namespace Crash2D
+{
+FrameArena::FrameArena(const size_t blockSize) : _blockSize(std::max<size_t>(blockSize, 64)), _current(0), _offset(0), _used(0)
+{
+}
+
+FrameArena::~FrameArena()
+{
+	for (auto && b : _blocks)
+		Deallocate(b.data, b.size, MEMORY_ARENAS);
+}
+
+void* FrameArena::Allocate(const size_t bytes, const size_t align)
+{
+	while (_current < _blocks.size())
+	{
+		const Block &b = _blocks[_current];
+		const size_t start = (_offset + align - 1) & ~(align - 1);
+
+		if (start + bytes <= b.size)
+		{
+			_offset = start + bytes;
+			return b.data + start;
+		}
+
+		// Later blocks are already allocated, move on rather than waste them
+		_used += _offset;
+		_current++;
+		_offset = 0;
+	}
+
+	// Blocks start at the allocator's alignment, which covers every fundamental type
+	const size_t size = std::max(bytes, _blockSize);
+	_blocks.push_back({ static_cast<char*>(Crash2D::Allocate(size, MEMORY_ARENAS)), size });
+
+	_current = _blocks.size() - 1;
+	_offset = bytes;
+
+	return _blocks.back().data;
+}
+
+void FrameArena::Reset()
+{
+	_current = 0;
+	_offset = 0;
+	_used = 0;
+}
+
+const size_t FrameArena::GetUsed() const
+{
+	return _used + _offset;
+}
+
+const size_t FrameArena::GetCapacity() const
+{
+	size_t capacity = 0;
+
+	for (auto && b : _blocks)
+		capacity += b.size;
+
+	return capacity;
+}
+}
@@ -0,0 +1,33 @@
+#include <Crash2D/bounds.hpp>
+#include <Crash2D/shape.hpp>
+#include <Crash2D/projection.hpp>
+
+namespace Crash2D
+{
+Bounds::Bounds()
+{
+}
+
+Bounds::Bounds(const Vector2 &min, const Vector2 &max) : min(min), max(max)
+{
+}
+
+Bounds::Bounds(const Shape &s)
+{
+	const Projection x = s.Project(Axis(1, 0));
+	const Projection y = s.Project(Axis(0, 1));
+
+	min = Vector2(x.min, y.min);
+	max = Vector2(x.max, y.max);
+}
+
+const bool Bounds::Overlaps(const Bounds &b) const
+{
+	return (min.x <= b.max.x && b.min.x <= max.x && min.y <= b.max.y && b.min.y <= max.y);
+}
+
+const bool Bounds::Contains(const Bounds &b) const
+{
+	return (min.x <= b.min.x && b.max.x <= max.x && min.y <= b.min.y && b.max.y <= max.y);
+}
+}
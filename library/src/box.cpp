@@ -0,0 +1,183 @@
+#include <Crash2D/box.hpp>
+#include <Crash2D/segment.hpp>
+#include <Crash2D/projection.hpp>
+#include <Crash2D/collision.hpp>
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#ifndef M_PI
+#define M_PI 3.14159265359
+#endif
+
+namespace Crash2D
+{
+Box::Box() : OrientedBox()
+{
+}
+
+Box::Box(const Vector2 &c, const Vector2 &e) : OrientedBox(c, e)
+{
+}
+
+const bool Box::Overlaps(const Shape &s) const
+{
+	return s.Overlaps(*this);
+}
+
+const bool Box::Overlaps(const Box &b) const
+{
+	const Vector2 d = b.GetCenter() - GetCenter();
+	const Vector2 e = b.GetHalfExtents() + GetHalfExtents();
+
+	return (std::abs(d.x) < e.x && std::abs(d.y) < e.y);
+}
+
+const Vector2 Box::GetDisplacement(const Shape &s) const
+{
+	return -s.GetDisplacement(*this);
+}
+
+const Vector2 Box::GetDisplacement(const Box &b) const
+{
+	Precision_t overlap;
+	return Separate(b, overlap);
+}
+
+const Vector2 Box::GetDisplacement(const Shape &s, bool &overlaps) const
+{
+	return -s.GetDisplacement(*this, overlaps);
+}
+
+const Vector2 Box::GetDisplacement(const Box &b, bool &overlaps) const
+{
+	overlaps = Overlaps(b);
+
+	if (!overlaps)
+		return Vector2(0, 0);
+
+	Precision_t overlap;
+	return Separate(b, overlap);
+}
+
+const Collision Box::GetCollision(const Shape &s) const
+{
+	return -s.GetCollision(*this);
+}
+
+const Collision Box::GetCollision(const Box &b) const
+{
+	// Check if this contains b
+	bool contains = false;
+
+	// Check if b contains this
+	bool contained = false;
+
+	// Intersection points
+	std::vector<Vector2> intersects(0);
+
+	Precision_t overlap;
+	const Vector2 displacement = Separate(b, overlap);
+
+	bool doesOverlap = (displacement != Vector2(0, 0));
+
+	if (doesOverlap)
+	{
+		const Vector2 d = b.GetCenter() - GetCenter();
+		const Vector2 eA = GetHalfExtents();
+		const Vector2 eB = b.GetHalfExtents();
+
+		contains = (std::abs(d.x) + eB.x <= eA.x && std::abs(d.y) + eB.y <= eA.y);
+		contained = (std::abs(d.x) + eA.x <= eB.x && std::abs(d.y) + eA.y <= eB.y);
+		intersects = GetIntersects(b);
+	}
+
+	return Collision(doesOverlap, std::move(intersects), contains, contained, overlap, displacement);
+}
+
+const Vector2 Box::Separate(const Box &b, Precision_t &overlap) const
+{
+	const Vector2 cA = GetCenter();
+	const Vector2 cB = b.GetCenter();
+	const Vector2 eA = GetHalfExtents();
+	const Vector2 eB = b.GetHalfExtents();
+
+	const Projection xA(cB.x - eB.x, cB.x + eB.x);
+	const Projection xB(cA.x - eA.x, cA.x + eA.x);
+	const Projection yA(cB.y - eB.y, cB.y + eB.y);
+	const Projection yB(cA.y - eA.y, cA.y + eA.y);
+
+	// No Collision
+	if (!xA.IsOverlap(xB) || !yA.IsOverlap(yB))
+	{
+		overlap = 0;
+		return Vector2(0, 0);
+	}
+
+	const Precision_t ox = xA.GetOverlap(xB);
+	const Precision_t oy = yA.GetOverlap(yB);
+
+	if (std::abs(oy) < std::abs(ox))
+	{
+		overlap = oy;
+		return Vector2(0, oy);
+	}
+
+	overlap = ox;
+	return Vector2(ox, 0);
+}
+
+void Box::Transform(const Transformation &t)
+{
+	// Scale
+	Vector2 p = GetCenter() - t.GetPivot();
+	p *= t.GetScale();
+
+	_halfExtents *= t.GetScale();
+	_halfExtents = Vector2(std::abs(_halfExtents.x), std::abs(_halfExtents.y));
+
+	// Rotate
+	const Precision_t radians = (t.GetRotation() * M_PI) / 180;
+	const Precision_t s = std::sin(radians);
+	const Precision_t c = std::cos(radians);
+
+	const Precision_t nx = (p.x * c) - (p.y * s);
+	const Precision_t ny = (p.x * s) + (p.y * c);
+
+	p = Vector2(nx, ny) + t.GetPivot();
+
+	// Translate
+	p += t.GetTranslation();
+
+	_center = p;
+
+	UpdatePoints();
+	UpdateSides();
+}
+
+void Box::ReCalc()
+{
+	Vector2 lo(std::numeric_limits<Precision_t>::infinity(), std::numeric_limits<Precision_t>::infinity());
+	Vector2 hi = -lo;
+
+	for (auto && pt : GetPoints())
+	{
+		lo = Vector2(std::min(lo.x, pt.x), std::min(lo.y, pt.y));
+		hi = Vector2(std::max(hi.x, pt.x), std::max(hi.y, pt.y));
+	}
+
+	_axes = { Axis(1, 0), Axis(0, 1) };
+	_halfExtents = (hi - lo) / 2;
+	_center = (hi + lo) / 2;
+
+	UpdatePoints();
+	UpdateSides();
+}
+
+Shape* Box::Clone()
+{
+	return new Box(*this);
+}
+
+}
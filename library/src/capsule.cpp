@@ -0,0 +1,567 @@
+#include <Crash2D/capsule.hpp>
+#include <Crash2D/circle.hpp>
+#include <Crash2D/polygon.hpp>
+#include <Crash2D/segment.hpp>
+#include <Crash2D/projection.hpp>
+#include <Crash2D/collision.hpp>
+#include <Crash2D/counters.hpp>
+
+#include <cmath>
+#include <algorithm>
+
+namespace Crash2D
+{
+Capsule::Capsule() : ShapeImpl(), _radius(0)
+{
+	SetPointCount(2);
+	ReCalc();
+}
+
+Capsule::Capsule(const Vector2 &a, const Vector2 &b, const Precision_t r) : ShapeImpl(), _radius(r)
+{
+	SetPointCount(2);
+	SetPoint(0, a);
+	SetPoint(1, b);
+	ReCalc();
+}
+
+void Capsule::SetRadius(const Precision_t r)
+{
+	_radius = r;
+}
+
+const Precision_t& Capsule::GetRadius() const
+{
+	return _radius;
+}
+
+const Axis& Capsule::GetAxis() const
+{
+	return _axis;
+}
+
+const Vector2 Capsule::GetNearestPoint(const Vector2 &p) const
+{
+	const Vector2 s = GetPoint(1) - GetPoint(0);
+	const Precision_t ss = s.Dot(s);
+
+	if (ss <= EPS)
+		return GetPoint(0);
+
+	const Precision_t q = (p - GetPoint(0)).Dot(s) / ss;
+
+	if (q < 0)
+		return GetPoint(0);
+
+	else if (q > 1)
+		return GetPoint(1);
+
+	else
+		return GetPoint(0) + (s * q);
+}
+
+const Precision_t Capsule::DistancePoint(const Vector2 &p) const
+{
+	return p.GetDistance(GetNearestPoint(p));
+}
+
+const Projection Capsule::Project(const Axis &a) const
+{
+	CRASH2D_COUNT(COUNTER_PROJECTIONS, 1);
+
+	const Precision_t dot0 = a.Dot(GetPoint(0));
+	const Precision_t dot1 = a.Dot(GetPoint(1));
+
+	return Projection(std::min(dot0, dot1) - GetRadius(), std::max(dot0, dot1) + GetRadius());
+}
+
+const Projection Capsule::Project(const Shape &s, const Axis &a) const
+{
+	return s.Project(a);
+}
+
+const bool Capsule::Contains(const Vector2 &v) const
+{
+	return (DistancePoint(v) <= GetRadius());
+}
+
+const bool Capsule::Contains(const Shape &s) const
+{
+	return s.IsInside(*this);
+}
+
+const bool Capsule::Contains(const Segment &s) const
+{
+	return (Contains(s.GetPoint(0)) && Contains(s.GetPoint(1)));
+}
+
+const bool Capsule::Contains(const Circle &c) const
+{
+	return (DistancePoint(c.GetCenter()) + c.GetRadius() <= GetRadius());
+}
+
+const bool Capsule::Contains(const Polygon &p) const
+{
+	for (auto && pt : p.GetPoints())
+	{
+		if (!Contains(pt))
+			return false;
+	}
+
+	return true;
+}
+
+const bool Capsule::Contains(const Capsule &c) const
+{
+	for (auto && pt : c.GetPoints())
+	{
+		if (DistancePoint(pt) + c.GetRadius() > GetRadius())
+			return false;
+	}
+
+	return true;
+}
+
+const bool Capsule::IsInside(const Shape &s) const
+{
+	return s.Contains(*this);
+}
+
+const bool Capsule::IsInside(const Segment &s) const
+{
+	return false;
+}
+
+const bool Capsule::IsInside(const Circle &c) const
+{
+	return c.Contains(*this);
+}
+
+const bool Capsule::IsInside(const Polygon &p) const
+{
+	return p.Contains(*this);
+}
+
+const bool Capsule::IsInside(const Capsule &c) const
+{
+	return c.Contains(*this);
+}
+
+const bool Capsule::Overlaps(const Shape &s) const
+{
+	return s.Overlaps(*this);
+}
+
+const bool Capsule::Overlaps(const Segment &s) const
+{
+	Precision_t overlap;
+	return (Separate(s.GetPoint(0), s.GetPoint(1), 0, overlap) != Vector2(0, 0));
+}
+
+const bool Capsule::Overlaps(const Circle &c) const
+{
+	Precision_t overlap;
+	return (Separate(c.GetCenter(), c.GetCenter(), c.GetRadius(), overlap) != Vector2(0, 0));
+}
+
+const bool Capsule::Overlaps(const Polygon &p) const
+{
+	return (CalcDisplacement(GetAxes(p), *this, p) != Vector2(0, 0));
+}
+
+const bool Capsule::Overlaps(const Capsule &c) const
+{
+	Precision_t overlap;
+	return (Separate(c.GetPoint(0), c.GetPoint(1), c.GetRadius(), overlap) != Vector2(0, 0));
+}
+
+const std::vector<Vector2> Capsule::GetIntersects(const Shape &s) const
+{
+	std::vector<Vector2> intersections(0);
+
+	const Vector2 dir = GetPoint(1) - GetPoint(0);
+	const Precision_t lenSq = dir.LengthSq();
+
+	// The straight sides of the capsule
+	if (lenSq > EPS)
+	{
+		const Vector2 n = GetAxis() * GetRadius();
+		const Segment sides[2] = { Segment(GetPoint(0) + n, GetPoint(1) + n), Segment(GetPoint(0) - n, GetPoint(1) - n) };
+
+		for (auto && side : sides)
+		{
+			for (auto && pt : s.GetIntersects(side))
+			{
+				auto it = std::find(std::begin(intersections), std::end(intersections), pt);
+
+				if (it == std::end(intersections))
+					intersections.push_back(pt);
+			}
+		}
+	}
+
+	// The rounded ends, only the half of each circle facing away from the spine
+	for (unsigned i = 0; i < 2; i++)
+	{
+		const Circle cap(GetPoint(i), GetRadius());
+
+		for (auto && pt : s.GetIntersects(cap))
+		{
+			const Precision_t t = (pt - GetPoint(0)).Dot(dir);
+
+			if ((i == 0 && t > 0) || (i == 1 && t < lenSq))
+				continue;
+
+			auto it = std::find(std::begin(intersections), std::end(intersections), pt);
+
+			if (it == std::end(intersections))
+				intersections.push_back(pt);
+		}
+	}
+
+	return intersections;
+}
+
+const std::vector<Vector2> Capsule::GetIntersects(const Segment &s) const
+{
+	return GetIntersects(static_cast<const Shape&>(s));
+}
+
+const std::vector<Vector2> Capsule::GetIntersects(const Circle &c) const
+{
+	return GetIntersects(static_cast<const Shape&>(c));
+}
+
+const std::vector<Vector2> Capsule::GetIntersects(const Polygon &p) const
+{
+	return GetIntersects(static_cast<const Shape&>(p));
+}
+
+const std::vector<Vector2> Capsule::GetIntersects(const Capsule &c) const
+{
+	return GetIntersects(static_cast<const Shape&>(c));
+}
+
+const Vector2 Capsule::GetDisplacement(const Shape &s) const
+{
+	return -s.GetDisplacement(*this);
+}
+
+const Vector2 Capsule::GetDisplacement(const Segment &s) const
+{
+	Precision_t overlap;
+	return Separate(s.GetPoint(0), s.GetPoint(1), 0, overlap);
+}
+
+const Vector2 Capsule::GetDisplacement(const Circle &c) const
+{
+	Precision_t overlap;
+	return Separate(c.GetCenter(), c.GetCenter(), c.GetRadius(), overlap);
+}
+
+const Vector2 Capsule::GetDisplacement(const Polygon &p) const
+{
+	return CalcDisplacement(GetAxes(p), *this, p);
+}
+
+const Vector2 Capsule::GetDisplacement(const Capsule &c) const
+{
+	Precision_t overlap;
+	return Separate(c.GetPoint(0), c.GetPoint(1), c.GetRadius(), overlap);
+}
+
+const Vector2 Capsule::GetDisplacement(const Shape &s, bool &overlaps) const
+{
+	return -s.GetDisplacement(*this, overlaps);
+}
+
+const Vector2 Capsule::GetDisplacement(const Segment &s, bool &overlaps) const
+{
+	const Vector2 displacement = GetDisplacement(s);
+
+	overlaps = (displacement != Vector2(0, 0));
+	return displacement;
+}
+
+const Vector2 Capsule::GetDisplacement(const Circle &c, bool &overlaps) const
+{
+	const Vector2 displacement = GetDisplacement(c);
+
+	overlaps = (displacement != Vector2(0, 0));
+	return displacement;
+}
+
+const Vector2 Capsule::GetDisplacement(const Polygon &p, bool &overlaps) const
+{
+	const Vector2 displacement = GetDisplacement(p);
+
+	overlaps = (displacement != Vector2(0, 0));
+	return displacement;
+}
+
+const Vector2 Capsule::GetDisplacement(const Capsule &c, bool &overlaps) const
+{
+	const Vector2 displacement = GetDisplacement(c);
+
+	overlaps = (displacement != Vector2(0, 0));
+	return displacement;
+}
+
+const Collision Capsule::GetCollision(const Shape &s) const
+{
+	return -s.GetCollision(*this);
+}
+
+const Collision Capsule::GetCollision(const Segment &s) const
+{
+	// Check if capsule contains segment
+	bool contains = false;
+
+	// Segments cannot contain capsules
+	bool contained = false;
+
+	// Intersection points
+	std::vector<Vector2> intersects(0);
+
+	Precision_t overlap;
+	const Vector2 displacement = Separate(s.GetPoint(0), s.GetPoint(1), 0, overlap);
+
+	bool doesOverlap = (displacement != Vector2(0, 0));
+
+	if (doesOverlap)
+	{
+		contains = Contains(s);
+		intersects = GetIntersects(s);
+	}
+
+	return Collision(doesOverlap, std::move(intersects), contains, contained, overlap, displacement);
+}
+
+const Collision Capsule::GetCollision(const Circle &c) const
+{
+	// Determine if this capsule contains
+	// the circle "c"
+	bool contains = false;
+
+	// Determine if the circle "c"
+	// contains this capsule
+	bool contained = false;
+
+	// Intersection points
+	std::vector<Vector2> intersects(0);
+
+	Precision_t overlap;
+	const Vector2 displacement = Separate(c.GetCenter(), c.GetCenter(), c.GetRadius(), overlap);
+
+	bool doesOverlap = (displacement != Vector2(0, 0));
+
+	if (doesOverlap)
+	{
+		contains = Contains(c);
+		contained = c.Contains(*this);
+		intersects = GetIntersects(c);
+	}
+
+	return Collision(doesOverlap, std::move(intersects), contains, contained, overlap, displacement);
+}
+
+const Collision Capsule::GetCollision(const Polygon &p) const
+{
+	// Check if this contains p
+	bool contains = false;
+
+	// Check if p contains this
+	bool contained = false;
+
+	// Intersection points
+	std::vector<Vector2> intersects(0);
+
+	const AxesVec axes = GetAxes(p);
+
+	// Displacement is the vector to be applied to polygon "p"
+	// in order to seperate it from this
+	const Vector2 displacement = CalcDisplacement(axes, *this, p);
+	const Precision_t overlap = GetOverlap(axes, *this, p);
+
+	bool doesOverlap = (displacement != Vector2(0, 0));
+
+	if (doesOverlap)
+	{
+		contains = Contains(p);
+		contained = p.Contains(*this);
+		intersects = GetIntersects(p);
+	}
+
+	return Collision(doesOverlap, std::move(intersects), contains, contained, overlap, displacement);
+}
+
+const Collision Capsule::GetCollision(const Capsule &c) const
+{
+	// Check if this contains c
+	bool contains = false;
+
+	// Check if c contains this
+	bool contained = false;
+
+	// Intersection points
+	std::vector<Vector2> intersects(0);
+
+	Precision_t overlap;
+	const Vector2 displacement = Separate(c.GetPoint(0), c.GetPoint(1), c.GetRadius(), overlap);
+
+	bool doesOverlap = (displacement != Vector2(0, 0));
+
+	if (doesOverlap)
+	{
+		contains = Contains(c);
+		contained = c.Contains(*this);
+		intersects = GetIntersects(c);
+	}
+
+	return Collision(doesOverlap, std::move(intersects), contains, contained, overlap, displacement);
+}
+
+void Capsule::ClosestPoints(const Vector2 &a, const Vector2 &b, Vector2 &pA, Vector2 &pB) const
+{
+	const Vector2 d1 = GetPoint(1) - GetPoint(0);
+	const Vector2 d2 = b - a;
+	const Vector2 r = GetPoint(0) - a;
+
+	const Precision_t lA = d1.Dot(d1);
+	const Precision_t lB = d2.Dot(d2);
+	const Precision_t f = d2.Dot(r);
+
+	Precision_t s = 0;
+	Precision_t t = 0;
+
+	if (lA <= EPS && lB > EPS)
+		t = std::max<Precision_t>(0, std::min<Precision_t>(1, f / lB));
+
+	else if (lA > EPS)
+	{
+		const Precision_t c = d1.Dot(r);
+
+		if (lB <= EPS)
+			s = std::max<Precision_t>(0, std::min<Precision_t>(1, -c / lA));
+
+		else
+		{
+			const Precision_t d = d1.Dot(d2);
+			const Precision_t denom = lA * lB - d * d;
+
+			// Parallel spines pick an arbitrary point, fixed up by the clamps below
+			if (denom != 0)
+				s = std::max<Precision_t>(0, std::min<Precision_t>(1, (d * f - c * lB) / denom));
+
+			t = (d * s + f) / lB;
+
+			if (t < 0)
+			{
+				t = 0;
+				s = std::max<Precision_t>(0, std::min<Precision_t>(1, -c / lA));
+			}
+
+			else if (t > 1)
+			{
+				t = 1;
+				s = std::max<Precision_t>(0, std::min<Precision_t>(1, (d - c) / lA));
+			}
+		}
+	}
+
+	pA = GetPoint(0) + d1 * s;
+	pB = a + d2 * t;
+}
+
+const Vector2 Capsule::Separate(const Vector2 &a, const Vector2 &b, const Precision_t r, Precision_t &overlap) const
+{
+	Vector2 pA, pB;
+	ClosestPoints(a, b, pA, pB);
+
+	const Vector2 d = pB - pA;
+	const Precision_t distSq = d.LengthSq();
+	const Precision_t radiiSum = GetRadius() + r;
+
+	overlap = 0;
+
+	if (distSq >= radiiSum * radiiSum)
+		return Vector2(0, 0);
+
+	if (distSq > EPS)
+	{
+		const Precision_t dist = std::sqrt(distSq);
+		overlap = radiiSum - dist;
+
+		return d * (overlap / dist);
+	}
+
+	// The spines cross, fall back to the axes of both spines
+	const Capsule other(a, b, r);
+
+	AxesVec axes;
+
+	if (GetAxis() != Vector2(0, 0))
+		axes.push_back(GetAxis());
+
+	if (other.GetAxis() != Vector2(0, 0))
+		axes.push_back(other.GetAxis());
+
+	if (axes.empty())
+		axes.push_back(Axis(1, 0));
+
+	// The signed overlap on the axis CalcDisplacement() picks, as in the other paths
+	const Vector2 displacement = CalcDisplacement(axes, *this, other);
+	overlap = GetOverlap(axes, *this, other);
+
+	return displacement;
+}
+
+const AxesVec Capsule::GetAxes(const Polygon &p) const
+{
+	AxesVec axes = p.GetAxes();
+
+	if (GetAxis() != Vector2(0, 0))
+		axes.push_back(GetAxis());
+
+	for (auto && pt : GetPoints())
+	{
+		const Vector2 v = p.NearestVertex(pt) - pt;
+
+		if (v.LengthSq() > EPS)
+			axes.push_back(v.Normalize());
+	}
+
+	return axes;
+}
+
+void Capsule::Transform(const Transformation &t)
+{
+	ShapeImpl::Transform(t);
+
+	// A mirrored capsule keeps its size, and a stretched one grows to still cover the stretched shape
+	const Vector2 &scale = t.GetScale();
+	_radius *= std::max(std::abs(scale.x), std::abs(scale.y));
+
+	ReCalc();
+}
+
+void Capsule::ReCalc()
+{
+	_center = Vector2(GetPoint(0) + GetPoint(1)) / 2;
+
+	const Vector2 edge = GetPoint(0) - GetPoint(1);
+	const Precision_t length = edge.Length();
+
+	if (length > 0)
+		_axis = edge.Perpendicular() / length;
+
+	else
+		_axis = Axis(0, 0);
+}
+
+Shape* Capsule::Clone()
+{
+	return new Capsule(*this);
+}
+
+}
@@ -3,12 +3,31 @@
 #include <Crash2D/segment.hpp>
 #include <Crash2D/projection.hpp>
 #include <Crash2D/collision.hpp>
+#include <Crash2D/capsule.hpp>
+#include <Crash2D/counters.hpp>
 
 #include <cmath>
 #include <algorithm>
 
 namespace Crash2D
 {
+// Splits v into its length and unit direction, coincident centers separate along x as atan2(0, 0) did
+static const Vector2 GetDirection(const Vector2 &v, Precision_t &length)
+{
+	const Precision_t lengthSq = v.LengthSq();
+
+	if (lengthSq <= 0)
+	{
+		length = 0;
+		return Vector2(1, 0);
+	}
+
+	const Precision_t inv = InverseSqrt(lengthSq);
+	length = lengthSq * inv;
+
+	return v * inv;
+}
+
 Circle::Circle() : ShapeImpl(Vector2(0, 0)), _radius(0)
 {
 }
@@ -34,6 +53,8 @@ const Precision_t& Circle::GetRadius() const
 
 const Projection Circle::Project(const Axis &a) const
 {
+	CRASH2D_COUNT(COUNTER_PROJECTIONS, 1);
+
 	const Precision_t v = a.Dot(GetCenter());
 	return Projection(v - GetRadius(), v + GetRadius());
 }
@@ -62,6 +83,17 @@ const bool Circle::Contains(const Polygon &p) const
 	return true;
 }
 
+const bool Circle::Contains(const Capsule &c) const
+{
+	for (auto && pt : c.GetPoints())
+	{
+		if (GetCenter().GetDistance(pt) + c.GetRadius() > GetRadius())
+			return false;
+	}
+
+	return true;
+}
+
 const bool Circle::Contains(const Circle &c) const
 {
 	if (c.GetRadius() > GetRadius())
@@ -103,6 +135,11 @@ const bool Circle::IsInside(const Polygon &p) const
 	return p.Contains(*this);
 }
 
+const bool Circle::IsInside(const Capsule &c) const
+{
+	return c.Contains(*this);
+}
+
 const bool Circle::Overlaps(const Shape &s) const
 {
 	return s.Overlaps(*this);
@@ -122,9 +159,8 @@ const bool Circle::Overlaps(const Circle &c) const
 	const Vector2 v = (c.GetCenter()) - (GetCenter());
 
 	const Precision_t radiiSum = GetRadius() + c.GetRadius();
-	const Precision_t dist = v.Length();
 
-	return (dist <= radiiSum);
+	return (v.LengthSq() <= radiiSum * radiiSum);
 }
 
 const bool Circle::Overlaps(const Polygon &p) const
@@ -132,6 +168,11 @@ const bool Circle::Overlaps(const Polygon &p) const
 	return p.Overlaps(*this);
 }
 
+const bool Circle::Overlaps(const Capsule &c) const
+{
+	return c.Overlaps(*this);
+}
+
 const std::vector<Vector2> Circle::GetIntersects(const Shape &s) const
 {
 	return s.GetIntersects(*this);
@@ -139,6 +180,8 @@ const std::vector<Vector2> Circle::GetIntersects(const Shape &s) const
 
 const std::vector<Vector2> Circle::GetIntersects(const Segment &s) const
 {
+	CRASH2D_COUNT(COUNTER_EDGE_TESTS, 1);
+
 	std::vector<Vector2> intersections(0);
 
 	Vector2 circlePosition = GetCenter();
@@ -188,17 +231,19 @@ const std::vector<Vector2> Circle::GetIntersects(const Segment &s) const
 	return intersections;
 }
 
-const std::vector<Vector2> Circle::GetIntersects(const Circle &c) const
+// Writes the intersection points of two circles into any container of points
+template <typename Points>
+static void IntersectCircles(const Circle &self, const Circle &c, Points &intersections)
 {
-	std::vector<Vector2> intersections(0);
+	intersections.clear();
 
-	if (!Overlaps(c))
-		return intersections;
+	if (!self.Overlaps(c))
+		return;
 
-	const Vector2 c1Pos = GetCenter();
+	const Vector2 c1Pos = self.GetCenter();
 	const Vector2 c2Pos = c.GetCenter();
 
-	const Precision_t c1r2 = GetRadius() * GetRadius();
+	const Precision_t c1r2 = self.GetRadius() * self.GetRadius();
 	const Precision_t c2r2 = c.GetRadius() * c.GetRadius();
 
 	const Vector2 c2c1 = c2Pos - c1Pos;
@@ -219,15 +264,36 @@ const std::vector<Vector2> Circle::GetIntersects(const Circle &c) const
 
 	if (i1 != i2)
 		intersections.push_back(i2);
+}
+
+const std::vector<Vector2> Circle::GetIntersects(const Circle &c) const
+{
+	std::vector<Vector2> intersections(0);
+	IntersectCircles(*this, c, intersections);
 
 	return intersections;
 }
 
+void Circle::GetIntersects(const Shape &s, ArenaVector<Vector2> &intersects) const
+{
+	s.GetIntersects(*this, intersects);
+}
+
+void Circle::GetIntersects(const Circle &c, ArenaVector<Vector2> &intersects) const
+{
+	IntersectCircles(*this, c, intersects);
+}
+
 const std::vector<Vector2> Circle::GetIntersects(const Polygon &p) const
 {
 	return p.GetIntersects(*this);
 }
 
+const std::vector<Vector2> Circle::GetIntersects(const Capsule &c) const
+{
+	return c.GetIntersects(*this);
+}
+
 const Vector2 Circle::GetDisplacement(const Shape &s) const
 {
 	return -s.GetDisplacement(*this);
@@ -246,16 +312,13 @@ const Vector2 Circle::GetDisplacement(const Circle &c) const
 {
 	const Vector2 v = (c.GetCenter()) - (GetCenter());
 
-	const Precision_t theta = atan2(v.y, v.x);
+	Precision_t dist;
+	const Vector2 dir = GetDirection(v, dist);
 
 	const Precision_t radiiSum = GetRadius() + c.GetRadius();
-	const Precision_t dist = v.Length();
 	const Precision_t tDist = (radiiSum - dist) + 1;
 
-	const Precision_t x = tDist * std::cos(theta);
-	const Precision_t y = tDist * std::sin(theta);
-
-	return Vector2(x, y);
+	return dir * tDist;
 }
 
 const Vector2 Circle::GetDisplacement(const Polygon &p) const
@@ -263,6 +326,44 @@ const Vector2 Circle::GetDisplacement(const Polygon &p) const
 	return -p.GetDisplacement(*this);
 }
 
+const Vector2 Circle::GetDisplacement(const Capsule &c) const
+{
+	return -c.GetDisplacement(*this);
+}
+
+const Vector2 Circle::GetDisplacement(const Shape &s, bool &overlaps) const
+{
+	return -s.GetDisplacement(*this, overlaps);
+}
+
+const Vector2 Circle::GetDisplacement(const Segment &s, bool &overlaps) const
+{
+	const Vector2 displacement = GetDisplacement(s);
+
+	overlaps = (displacement != Vector2(0, 0));
+	return displacement;
+}
+
+const Vector2 Circle::GetDisplacement(const Circle &c, bool &overlaps) const
+{
+	overlaps = Overlaps(c);
+
+	if (!overlaps)
+		return Vector2(0, 0);
+
+	return GetDisplacement(c);
+}
+
+const Vector2 Circle::GetDisplacement(const Polygon &p, bool &overlaps) const
+{
+	return -p.GetDisplacement(*this, overlaps);
+}
+
+const Vector2 Circle::GetDisplacement(const Capsule &c, bool &overlaps) const
+{
+	return -c.GetDisplacement(*this, overlaps);
+}
+
 const Collision Circle::GetCollision(const Shape &s) const
 {
 	return -s.GetCollision(*this);
@@ -295,31 +396,30 @@ const Collision Circle::GetCollision(const Segment &s) const
 		intersects = GetIntersects(s);
 	}
 
-	return Collision(doesOverlap, intersects, contains, contained, overlap, displacement);
+	return Collision(doesOverlap, std::move(intersects), contains, contained, overlap, displacement);
 }
 
-const Collision Circle::GetCollision(const Circle &c) const
+// Gets the collision of two circles without its intersection points, which go into any container of points
+template <typename Points>
+static const Collision CollideCircles(const Circle &self, const Circle &c, Points &intersects)
 {
-	const Vector2 v = (c.GetCenter()) - (GetCenter());
+	const Vector2 v = (c.GetCenter()) - (self.GetCenter());
 
-	const Precision_t theta = atan2(v.y, v.x);
+	Precision_t dist;
+	const Vector2 dir = GetDirection(v, dist);
 
-	const Precision_t radiiSum = GetRadius() + c.GetRadius();
-	const Precision_t dist = v.Length();
+	const Precision_t radiiSum = self.GetRadius() + c.GetRadius();
 	const Precision_t tDist = (radiiSum - dist) + 1;
 
-	bool doesOverlap = (dist <= radiiSum);
+	bool doesOverlap = (v.LengthSq() <= radiiSum * radiiSum);
 
 	// Determine if this circle contains
 	// the circle "c"
-	bool contains = Contains(c);//(dist <= radiiDif);
+	bool contains = self.Contains(c);//(dist <= radiiDif);
 
 	// Determine if the circle "c"
 	// contains this circle
-	bool contained = c.Contains(*this);
-
-	// Intersection points
-	std::vector<Vector2> intersects(0);
+	bool contained = c.Contains(self);
 
 	// Displacement is the vector to be applied to circle "c"
 	// in order to seperate it from the circle
@@ -327,15 +427,34 @@ const Collision Circle::GetCollision(const Circle &c) const
 
 	if (doesOverlap)
 	{
+		displacement = dir * tDist;
+		IntersectCircles(self, c, intersects);
+	}
 
-		const Precision_t x = tDist * std::cos(theta);
-		const Precision_t y = tDist * std::sin(theta);
+	else
+		intersects.clear();
 
-		displacement = Vector2(x, y);
-		intersects = GetIntersects(c);
-	}
+	return Collision(doesOverlap, std::vector<Vector2>(), contains, contained, dist, displacement);
+}
 
-	return Collision(doesOverlap, intersects, contains, contained, dist, displacement);
+const Collision Circle::GetCollision(const Circle &c) const
+{
+	// Intersection points
+	std::vector<Vector2> intersects(0);
+
+	const Collision collision = CollideCircles(*this, c, intersects);
+
+	return Collision(collision.Overlaps(), std::move(intersects), collision.AcontainsB(), collision.BcontainsA(), collision.GetOverlap(), collision.GetDisplacement());
+}
+
+const Collision Circle::GetCollision(const Shape &s, ArenaVector<Vector2> &intersects) const
+{
+	return -s.GetCollision(*this, intersects);
+}
+
+const Collision Circle::GetCollision(const Circle &c, ArenaVector<Vector2> &intersects) const
+{
+	return CollideCircles(*this, c, intersects);
 }
 
 const Collision Circle::GetCollision(const Polygon &p) const
@@ -343,6 +462,11 @@ const Collision Circle::GetCollision(const Polygon &p) const
 	return -p.GetCollision(*this);
 }
 
+const Collision Circle::GetCollision(const Capsule &c) const
+{
+	return -c.GetCollision(*this);
+}
+
 void Circle::Transform(const Transformation &t)
 {
 	// Scale
@@ -0,0 +1,105 @@
+#include <Crash2D/circle_kernel.hpp>
+#include <Crash2D/simd.hpp>
+
+#include <cmath>
+
+namespace Crash2D
+{
+// Resolves four pairs whose centers differ by (dx, dy) and whose radii sum to rs, writing to out at offset i
+static void CollideGroup(const Simd::Float4 dx, const Simd::Float4 dy, const Simd::Float4 rs, CircleContacts &out, const unsigned i, const unsigned count)
+{
+	const Simd::Float4 zero = Simd::Set1(0);
+
+	const Simd::Float4 d2 = Simd::Add(Simd::Mul(dx, dx), Simd::Mul(dy, dy));
+	const Simd::Mask4 hit = Simd::LessEqual(d2, Simd::Mul(rs, rs));
+	const unsigned bits = Simd::ToBits(hit);
+
+	Precision_t depth[Simd::WIDTH] = { 0, 0, 0, 0 };
+	Precision_t nx[Simd::WIDTH] = { 0, 0, 0, 0 };
+	Precision_t ny[Simd::WIDTH] = { 0, 0, 0, 0 };
+
+	// Most groups miss entirely, so skip the square root for them
+	if (bits != 0)
+	{
+		const Simd::Float4 dist = Simd::Sqrt(d2);
+		const Simd::Mask4 apart = Simd::Greater(dist, zero);
+
+		// Coincident centers separate along x, which is where atan2(0, 0) points
+		const Simd::Float4 safe = Simd::Select(apart, dist, Simd::Set1(1));
+		const Simd::Float4 ux = Simd::Select(apart, Simd::Div(dx, safe), Simd::Set1(1));
+		const Simd::Float4 uy = Simd::Select(apart, Simd::Div(dy, safe), zero);
+
+		Simd::Store(depth, Simd::Select(hit, Simd::Sub(rs, dist), zero));
+		Simd::Store(nx, Simd::Select(hit, ux, zero));
+		Simd::Store(ny, Simd::Select(hit, uy, zero));
+	}
+
+	for (unsigned j = 0; j < count; j++)
+	{
+		out.overlaps[i + j] = (bits >> j) & 1;
+		out.depth[i + j] = depth[j];
+		out.normalX[i + j] = nx[j];
+		out.normalY[i + j] = ny[j];
+	}
+}
+
+void CollideCircles(const CircleBatch &c, const unsigned *first, const unsigned *second, const unsigned n, CircleContacts &out)
+{
+	for (unsigned i = 0; i < n; i += Simd::WIDTH)
+	{
+		const unsigned count = (n - i < Simd::WIDTH) ? n - i : Simd::WIDTH;
+
+		Precision_t dx[Simd::WIDTH], dy[Simd::WIDTH], rs[Simd::WIDTH];
+
+		// Gather the pairs into lanes, padding the tail with copies of the last pair
+		for (unsigned j = 0; j < Simd::WIDTH; j++)
+		{
+			const unsigned k = i + (j < count ? j : count - 1);
+			const unsigned a = first[k];
+			const unsigned b = second[k];
+
+			dx[j] = c.x[b] - c.x[a];
+			dy[j] = c.y[b] - c.y[a];
+			rs[j] = c.radius[a] + c.radius[b];
+		}
+
+		CollideGroup(Simd::Load(dx), Simd::Load(dy), Simd::Load(rs), out, i, count);
+	}
+}
+
+void CollideCircles(const Vector2 &center, const Precision_t radius, const CircleBatch &c, CircleContacts &out)
+{
+	const Simd::Float4 cx = Simd::Set1(center.x);
+	const Simd::Float4 cy = Simd::Set1(center.y);
+	const Simd::Float4 r = Simd::Set1(radius);
+
+	unsigned i = 0;
+
+	for (; i + Simd::WIDTH <= c.count; i += Simd::WIDTH)
+	{
+		const Simd::Float4 dx = Simd::Sub(Simd::Load(c.x + i), cx);
+		const Simd::Float4 dy = Simd::Sub(Simd::Load(c.y + i), cy);
+		const Simd::Float4 rs = Simd::Add(Simd::Load(c.radius + i), r);
+
+		CollideGroup(dx, dy, rs, out, i, Simd::WIDTH);
+	}
+
+	if (i < c.count)
+	{
+		const unsigned count = c.count - i;
+
+		Precision_t dx[Simd::WIDTH], dy[Simd::WIDTH], rs[Simd::WIDTH];
+
+		for (unsigned j = 0; j < Simd::WIDTH; j++)
+		{
+			const unsigned k = i + (j < count ? j : count - 1);
+
+			dx[j] = c.x[k] - center.x;
+			dy[j] = c.y[k] - center.y;
+			rs[j] = c.radius[k] + radius;
+		}
+
+		CollideGroup(Simd::Load(dx), Simd::Load(dy), Simd::Load(rs), out, i, count);
+	}
+}
+}
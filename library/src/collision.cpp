@@ -1,6 +1,8 @@
 #include <Crash2D/collision.hpp>
 #include <Crash2D/vector2.hpp>
 
+#include <utility>
+
 namespace Crash2D
 {
 Collision::Collision() :
@@ -8,8 +10,8 @@ Collision::Collision() :
 {
 }
 
-Collision::Collision(bool dI, const std::vector<Vector2> i, bool aCb, bool bCa, const Precision_t o, const Vector2 t)
-	: _doesOverlap(dI), _intersects(i), _aContainsb(aCb), _bContainsa(bCa), _overlap(o), _displacement(t)
+Collision::Collision(bool dI, std::vector<Vector2> i, bool aCb, bool bCa, const Precision_t o, const Vector2 t)
+	: _doesOverlap(dI), _intersects(std::move(i)), _aContainsb(aCb), _bContainsa(bCa), _overlap(o), _displacement(t)
 {
 }
 
@@ -28,6 +30,11 @@ const std::vector<Vector2>& Collision::GetIntersects() const
 	return _intersects;
 }
 
+const size_t Collision::GetMemoryUsage() const
+{
+	return _intersects.capacity() * sizeof(Vector2);
+}
+
 const bool Collision::AcontainsB() const
 {
 	return _aContainsb;
@@ -0,0 +1,553 @@
+#include <Crash2D/collision_world.hpp>
+#include <Crash2D/trace.hpp>
+#include <Crash2D/recorder.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Crash2D
+{
+static_assert(sizeof(Precision_t) == sizeof(uint32_t), "Displacements are hashed as 32 bit patterns");
+
+CollisionWorld::CollisionWorld() : _scheduler(nullptr), _recorder(nullptr), _count(0), _step(0), _sleepDelay(0)
+{
+}
+
+ShapeHandle CollisionWorld::Add(Shape *s, const MotionType type, const CollisionFilter &filter)
+{
+	unsigned index;
+
+	if (!_free.empty())
+	{
+		index = _free.back();
+		_free.pop_back();
+	}
+
+	else
+	{
+		index = _slots.size();
+		_slots.push_back(Slot());
+		_slots.back().generation = 0;
+		_slots.back().movedStep = 0;
+	}
+
+	Slot &slot = _slots[index];
+	slot.shape.reset(s);
+	slot.moved = false;
+	slot.activeStep = _step;
+	slot.type = type;
+	slot.awake = (type == MOTION_DYNAMIC);
+
+	_broadphase.Insert(index, Bounds(*s), slot.awake);
+	_broadphase.SetFilter(index, filter);
+	_count++;
+
+	// A static shape added on top of sleeping ones must still touch them
+	if (type != MOTION_DYNAMIC)
+		SetMoved(index);
+
+	if (_recorder)
+		_recorder->Add(GetHandle(index), *s, type, filter);
+
+	return GetHandle(index);
+}
+
+void CollisionWorld::Remove(const ShapeHandle &h)
+{
+	if (!IsValid(h))
+		return;
+
+	if (_recorder)
+		_recorder->Remove(h);
+
+	Slot &slot = _slots[h.index];
+	slot.shape.reset();
+	slot.generation++;
+
+	_broadphase.Remove(h.index);
+	_free.push_back(h.index);
+	_count--;
+}
+
+const bool CollisionWorld::IsValid(const ShapeHandle &h) const
+{
+	return (h.index < _slots.size() && _slots[h.index].shape && _slots[h.index].generation == h.generation);
+}
+
+Shape* CollisionWorld::Get(const ShapeHandle &h) const
+{
+	return IsValid(h) ? _slots[h.index].shape.get() : nullptr;
+}
+
+const unsigned CollisionWorld::GetShapeCount() const
+{
+	return _count;
+}
+
+const MotionType CollisionWorld::GetMotionType(const ShapeHandle &h) const
+{
+	return IsValid(h) ? _slots[h.index].type : MOTION_STATIC;
+}
+
+void CollisionWorld::SetFilter(const ShapeHandle &h, const CollisionFilter &f)
+{
+	if (!IsValid(h))
+		return;
+
+	if (_recorder)
+		_recorder->SetFilter(h, f);
+
+	_broadphase.SetFilter(h.index, f);
+
+	if (_slots[h.index].type == MOTION_DYNAMIC)
+		SetAwake(h.index, true);
+}
+
+const CollisionFilter& CollisionWorld::GetFilter(const ShapeHandle &h) const
+{
+	static const CollisionFilter none(0, 0);
+
+	return IsValid(h) ? _broadphase.GetFilter(h.index) : none;
+}
+
+void CollisionWorld::Wake(const ShapeHandle &h)
+{
+	if (!IsValid(h) || _slots[h.index].type != MOTION_DYNAMIC)
+		return;
+
+	if (_recorder)
+		_recorder->SetAwake(h, true);
+
+	SetAwake(h.index, true);
+}
+
+void CollisionWorld::Sleep(const ShapeHandle &h)
+{
+	if (!IsValid(h) || _slots[h.index].type != MOTION_DYNAMIC)
+		return;
+
+	if (_recorder)
+		_recorder->SetAwake(h, false);
+
+	SetAwake(h.index, false);
+}
+
+const bool CollisionWorld::IsAwake(const ShapeHandle &h) const
+{
+	return (IsValid(h) && _slots[h.index].awake);
+}
+
+void CollisionWorld::SetSleepDelay(const unsigned steps)
+{
+	if (_recorder)
+		_recorder->SetSleepDelay(steps);
+
+	_sleepDelay = steps;
+}
+
+const unsigned CollisionWorld::GetSleepDelay() const
+{
+	return _sleepDelay;
+}
+
+void CollisionWorld::Transform(const ShapeHandle &h, const Transformation &t)
+{
+	if (!IsValid(h))
+		return;
+
+	if (_recorder)
+		_recorder->Transform(h, t);
+
+	_slots[h.index].shape->Transform(t);
+	SetMoved(h.index);
+}
+
+void CollisionWorld::MarkMoved(const ShapeHandle &h)
+{
+	if (!IsValid(h))
+		return;
+
+	// The shape was changed directly, so only its new geometry can be recorded
+	if (_recorder)
+		_recorder->Reshape(h, *_slots[h.index].shape);
+
+	SetMoved(h.index);
+}
+
+const unsigned CollisionWorld::Step()
+{
+	CRASH2D_ZONE("Step");
+
+	_step++;
+
+	{
+		CRASH2D_ZONE("Broadphase insert");
+		UpdateBounds();
+	}
+
+	{
+		CRASH2D_ZONE("Pair generation");
+		_broadphase.FindPairs(_pairs);
+		SettleStatic();
+		UpdateCache();
+	}
+
+	if (_scheduler && _scheduler->GetWorkerCount() > 1 && _tests.size() > NARROWPHASE_CHUNK)
+		CollideParallel();
+
+	else
+	{
+		CRASH2D_ZONE("Narrowphase");
+
+		for (auto && i : _tests)
+		{
+			CachedPair &e = _cache[i];
+			e.touching = Collide(e.pair, e.contact);
+		}
+	}
+
+	{
+		CRASH2D_ZONE("Merge");
+		WakeTouching();
+		Report();
+
+		if (_sleepDelay > 0)
+			SleepResting();
+	}
+
+	if (_recorder)
+		_recorder->Step(_contacts.size(), GetContactHash());
+
+	return _contacts.size();
+}
+
+const std::vector<Contact>& CollisionWorld::GetContacts() const
+{
+	return _contacts;
+}
+
+const std::vector<ContactEvent>& CollisionWorld::GetEvents() const
+{
+	return _events;
+}
+
+const unsigned CollisionWorld::GetPairCount() const
+{
+	return _pairs.size();
+}
+
+const unsigned CollisionWorld::GetTestedCount() const
+{
+	return _tests.size();
+}
+
+const uint64_t CollisionWorld::GetContactHash() const
+{
+	uint64_t hash = 14695981039346656037ULL;
+
+	const auto mix = [&hash](const uint32_t v)
+	{
+		for (unsigned i = 0; i < 4; i++)
+		{
+			hash ^= (v >> (i * 8)) & 0xFF;
+			hash *= 1099511628211ULL;
+		}
+	};
+
+	for (auto && c : _contacts)
+	{
+		uint32_t x, y;
+		std::memcpy(&x, &c.displacement.x, sizeof(x));
+		std::memcpy(&y, &c.displacement.y, sizeof(y));
+
+		mix(c.a.index);
+		mix(c.a.generation);
+		mix(c.b.index);
+		mix(c.b.generation);
+		mix(x);
+		mix(y);
+	}
+
+	return hash;
+}
+
+const SweepBroadphase& CollisionWorld::GetBroadphase() const
+{
+	return _broadphase;
+}
+
+void CollisionWorld::SetScheduler(Scheduler *s)
+{
+	_scheduler = s;
+}
+
+Scheduler* CollisionWorld::GetScheduler() const
+{
+	return _scheduler;
+}
+
+const bool CollisionWorld::SetRecorder(Recorder *r)
+{
+	if (r && !_slots.empty())
+		return false;
+
+	_recorder = r;
+
+	if (_recorder && _sleepDelay > 0)
+		_recorder->SetSleepDelay(_sleepDelay);
+
+	return true;
+}
+
+Recorder* CollisionWorld::GetRecorder() const
+{
+	return _recorder;
+}
+
+const ShapeHandle CollisionWorld::GetHandle(const unsigned index) const
+{
+	return ShapeHandle{ index, _slots[index].generation };
+}
+
+void CollisionWorld::SetMoved(const unsigned index)
+{
+	Slot &slot = _slots[index];
+
+	if (!slot.moved)
+	{
+		slot.moved = true;
+		_moved.push_back(index);
+	}
+
+	if (slot.type == MOTION_DYNAMIC && !slot.awake)
+		SetAwake(index, true);
+}
+
+void CollisionWorld::UpdateBounds()
+{
+	for (auto && index : _moved)
+	{
+		Slot &slot = _slots[index];
+
+		// Removed since it was marked
+		if (!slot.shape || !slot.moved)
+			continue;
+
+		_broadphase.Update(index, Bounds(*slot.shape));
+		slot.moved = false;
+		slot.movedStep = _step;
+		slot.activeStep = _step;
+
+		// Sleeping shapes are only paired with awake ones, so a moved static shape is awake for this step
+		if (slot.type != MOTION_DYNAMIC)
+		{
+			_broadphase.SetAwake(index, true);
+			_movedStatic.push_back(index);
+		}
+	}
+
+	_moved.clear();
+}
+
+void CollisionWorld::SettleStatic()
+{
+	if (_movedStatic.empty())
+		return;
+
+	for (auto && index : _movedStatic)
+		_broadphase.SetAwake(index, false);
+
+	_movedStatic.clear();
+
+	// Static shapes are never paired with each other
+	_pairs.erase(std::remove_if(_pairs.begin(), _pairs.end(), [this](const ProxyPair &p)
+	{
+		return (_slots[p.first].type != MOTION_DYNAMIC && _slots[p.second].type != MOTION_DYNAMIC);
+	}), _pairs.end());
+}
+
+void CollisionWorld::SetAwake(const unsigned index, const bool awake)
+{
+	Slot &slot = _slots[index];
+
+	slot.awake = awake;
+	_broadphase.SetAwake(index, awake);
+
+	if (awake)
+		slot.activeStep = _step;
+}
+
+void CollisionWorld::UpdateCache()
+{
+	_previous.swap(_cache);
+	_cache.clear();
+	_tests.clear();
+
+	unsigned j = 0;
+
+	for (auto && p : _pairs)
+	{
+		// Both lists are sorted, so previous entries before p were not found this step
+		for (; j < _previous.size() && _previous[j].pair < p; j++)
+			KeepResting(_previous[j]);
+
+		CachedPair e;
+		e.pair = p;
+		e.contact = { GetHandle(p.first), GetHandle(p.second), Vector2(0, 0) };
+		e.touching = false;
+
+		const bool still = (_slots[p.first].movedStep != _step && _slots[p.second].movedStep != _step);
+		bool reused = false;
+
+		if (j < _previous.size() && _previous[j].pair == p)
+		{
+			const CachedPair &old = _previous[j++];
+
+			// A reused slot holds a different shape, which the generations tell apart
+			if (still && old.contact.a == e.contact.a && old.contact.b == e.contact.b)
+			{
+				e.contact.displacement = old.contact.displacement;
+				e.touching = old.touching;
+				reused = true;
+			}
+		}
+
+		if (!reused)
+			_tests.push_back(_cache.size());
+
+		_cache.push_back(e);
+	}
+
+	for (; j < _previous.size(); j++)
+		KeepResting(_previous[j]);
+}
+
+void CollisionWorld::KeepResting(const CachedPair &old)
+{
+	const ShapeHandle &a = old.contact.a;
+	const ShapeHandle &b = old.contact.b;
+
+	// Pairs of static and sleeping shapes are not reported by the broadphase, but their contacts remain
+	if (!old.touching || !IsValid(a) || !IsValid(b) || _slots[a.index].awake || _slots[b.index].awake)
+		return;
+
+	if (!_broadphase.GetFilter(a.index).Accepts(_broadphase.GetFilter(b.index)))
+		return;
+
+	if (_slots[a.index].movedStep == _step || _slots[b.index].movedStep == _step)
+		_tests.push_back(_cache.size());
+
+	_cache.push_back(old);
+}
+
+const bool CollisionWorld::Collide(const ProxyPair &p, Contact &c) const
+{
+	const Shape &a = *_slots[p.first].shape;
+	const Shape &b = *_slots[p.second].shape;
+
+	CRASH2D_QUERY_ZONE("GetDisplacement");
+
+	// One separating pass gives both the overlap and the displacement
+	bool overlaps;
+	const Vector2 displacement = a.GetDisplacement(b, overlaps);
+
+	if (!overlaps)
+		return false;
+
+	c = { GetHandle(p.first), GetHandle(p.second), displacement };
+	return true;
+}
+
+void CollisionWorld::CollideParallel()
+{
+	CRASH2D_ZONE("Narrowphase");
+
+	const unsigned chunks = (_tests.size() + NARROWPHASE_CHUNK - 1) / NARROWPHASE_CHUNK;
+
+	// Every queued pair has its own cache entry, so workers never write to the same result
+	_scheduler->Run(chunks, [this](const unsigned chunk, const unsigned worker)
+	{
+		CRASH2D_ZONE("Narrowphase chunk");
+
+		const unsigned end = std::min<unsigned>((chunk + 1) * NARROWPHASE_CHUNK, _tests.size());
+
+		for (unsigned i = chunk * NARROWPHASE_CHUNK; i < end; i++)
+		{
+			CachedPair &e = _cache[_tests[i]];
+			e.touching = Collide(e.pair, e.contact);
+		}
+	});
+}
+
+void CollisionWorld::WakeTouching()
+{
+	for (auto && i : _tests)
+	{
+		const CachedPair &e = _cache[i];
+
+		if (!e.touching)
+			continue;
+
+		// Only pairs with a moved shape are tested, so a sleeping shape in one is being pushed
+		for (auto && index : { e.pair.first, e.pair.second })
+		{
+			const Slot &slot = _slots[index];
+
+			if (slot.type == MOTION_DYNAMIC && !slot.awake)
+				SetAwake(index, true);
+		}
+	}
+}
+
+void CollisionWorld::SleepResting()
+{
+	for (unsigned i = 0; i < _slots.size(); i++)
+	{
+		const Slot &slot = _slots[i];
+
+		if (slot.shape && slot.awake && _step - slot.activeStep >= _sleepDelay)
+			SetAwake(i, false);
+	}
+}
+
+void CollisionWorld::Report()
+{
+	_contacts.clear();
+	_events.clear();
+
+	unsigned j = 0;
+
+	for (auto && e : _cache)
+	{
+		bool was = false;
+
+		// Walk the previous entries up to and including this pair
+		for (; j < _previous.size() && !(e.pair < _previous[j].pair); j++)
+		{
+			const CachedPair &old = _previous[j];
+
+			if (!old.touching)
+				continue;
+
+			if (old.pair == e.pair && old.contact.a == e.contact.a && old.contact.b == e.contact.b)
+				was = true;
+
+			if (!was || !e.touching)
+				_events.push_back({ CONTACT_END, old.contact });
+		}
+
+		if (e.touching)
+		{
+			_contacts.push_back(e.contact);
+			_events.push_back({ was ? CONTACT_PERSIST : CONTACT_BEGIN, e.contact });
+		}
+	}
+
+	// Pairs that are no longer candidates
+	for (; j < _previous.size(); j++)
+	{
+		if (_previous[j].touching)
+			_events.push_back({ CONTACT_END, _previous[j].contact });
+	}
+}
+}
@@ -0,0 +1,152 @@
+#include <Crash2D/counters.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace Crash2D
+{
+Counters::Counters()
+{
+	std::fill(values, values + COUNTER_COUNT, 0);
+}
+
+const char* Counters::GetName(const Counter c)
+{
+	static const char *NAMES[COUNTER_COUNT] =
+	{
+		"displacements", "overlaps", "axes", "early_outs", "projections", "edge_tests", "cell_visits", "bounds_tests"
+	};
+
+	return NAMES[c];
+}
+
+const Counters Counters::operator - (const Counters &c) const
+{
+	Counters d;
+
+	for (unsigned i = 0; i < COUNTER_COUNT; i++)
+		d.values[i] = values[i] - c.values[i];
+
+	return d;
+}
+
+const Counters Counters::operator + (const Counters &c) const
+{
+	Counters s;
+
+	for (unsigned i = 0; i < COUNTER_COUNT; i++)
+		s.values[i] = values[i] + c.values[i];
+
+	return s;
+}
+
+#ifdef CRASH2D_COUNTERS
+
+// Every live block, and what the exited threads counted
+struct CounterRegistry
+{
+	std::mutex mutex;
+	std::vector<CounterBlock*> blocks;
+	Counters retired;
+};
+
+// Never destroyed, threads may still exit after static destructors have run
+static CounterRegistry& GetRegistry()
+{
+	static CounterRegistry *registry = new CounterRegistry();
+	return *registry;
+}
+
+static const Counters Read(const CounterBlock &b)
+{
+	Counters c;
+
+	for (unsigned i = 0; i < COUNTER_COUNT; i++)
+		c.values[i] = b.values[i].load(std::memory_order_relaxed);
+
+	return c;
+}
+
+thread_local CounterBlock threadCounters;
+
+CounterBlock::CounterBlock()
+{
+	for (auto && v : values)
+		v.store(0, std::memory_order_relaxed);
+
+	CounterRegistry &r = GetRegistry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+
+	r.blocks.push_back(this);
+}
+
+CounterBlock::~CounterBlock()
+{
+	CounterRegistry &r = GetRegistry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+
+	r.retired = r.retired + Read(*this);
+	r.blocks.erase(std::find(r.blocks.begin(), r.blocks.end(), this));
+}
+
+const bool CountersEnabled()
+{
+	return true;
+}
+
+const Counters GetCounters()
+{
+	CounterRegistry &r = GetRegistry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+
+	Counters total = r.retired;
+
+	for (auto && b : r.blocks)
+		total = total + Read(*b);
+
+	return total;
+}
+
+const Counters GetThreadCounters()
+{
+	return Read(threadCounters);
+}
+
+void ResetCounters()
+{
+	CounterRegistry &r = GetRegistry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+
+	r.retired = Counters();
+
+	for (auto && b : r.blocks)
+	{
+		for (auto && v : b->values)
+			v.store(0, std::memory_order_relaxed);
+	}
+}
+
+#else
+
+const bool CountersEnabled()
+{
+	return false;
+}
+
+const Counters GetCounters()
+{
+	return Counters();
+}
+
+const Counters GetThreadCounters()
+{
+	return Counters();
+}
+
+void ResetCounters()
+{
+}
+
+#endif
+}
@@ -0,0 +1,147 @@
+#include <Crash2D/edge_table.hpp>
+#include <Crash2D/segment.hpp>
+#include <Crash2D/counters.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Crash2D
+{
+EdgeTable::EdgeTable() : _size(0), _capacity(0)
+{
+}
+
+void EdgeTable::Clear()
+{
+	_size = 0;
+}
+
+void EdgeTable::Reserve(const unsigned n)
+{
+	if (n > _capacity)
+		Grow(n);
+}
+
+void EdgeTable::Add(const Vector2 &a, const Vector2 &b)
+{
+	const Vector2 dir = b - a;
+	const Precision_t invLength = 1 / dir.Length();
+
+	// Same orientation as Segment's axis, the perpendicular of start minus end
+	const Axis normal = (-dir).Perpendicular() * invLength;
+
+	if (_size == _capacity)
+		Grow(_capacity < 4 ? 4 : _capacity * 2);
+
+	Get(START_X)[_size] = a.x;
+	Get(START_Y)[_size] = a.y;
+	Get(DIR_X)[_size] = dir.x;
+	Get(DIR_Y)[_size] = dir.y;
+	Get(NORMAL_X)[_size] = normal.x;
+	Get(NORMAL_Y)[_size] = normal.y;
+	Get(INV_LENGTH)[_size] = invLength;
+
+	_size++;
+}
+
+const unsigned EdgeTable::GetSize() const
+{
+	return _size;
+}
+
+const size_t EdgeTable::GetMemoryUsage() const
+{
+	return _block.capacity() * sizeof(Precision_t);
+}
+
+void EdgeTable::Grow(const unsigned capacity)
+{
+	TaggedVector<Precision_t, MEMORY_SHAPES> block(COLUMN_COUNT * capacity);
+
+	for (unsigned c = 0; c < COLUMN_COUNT; c++)
+		std::copy(Get(static_cast<Column>(c)), Get(static_cast<Column>(c)) + _size, block.data() + c * capacity);
+
+	_block.swap(block);
+	_capacity = capacity;
+}
+
+const Vector2 EdgeTable::GetStart(const unsigned i) const
+{
+	return Vector2(Get(START_X)[i], Get(START_Y)[i]);
+}
+
+const Vector2 EdgeTable::GetEnd(const unsigned i) const
+{
+	return Vector2(Get(START_X)[i] + Get(DIR_X)[i], Get(START_Y)[i] + Get(DIR_Y)[i]);
+}
+
+const Vector2 EdgeTable::GetDirection(const unsigned i) const
+{
+	return Vector2(Get(DIR_X)[i], Get(DIR_Y)[i]);
+}
+
+const Axis EdgeTable::GetNormal(const unsigned i) const
+{
+	return Axis(Get(NORMAL_X)[i], Get(NORMAL_Y)[i]);
+}
+
+const Precision_t EdgeTable::GetInverseLength(const unsigned i) const
+{
+	return Get(INV_LENGTH)[i];
+}
+
+const Segment EdgeTable::GetSide(const unsigned i) const
+{
+	return Segment(GetStart(i), GetEnd(i));
+}
+
+const Precision_t EdgeTable::DistancePoint(const unsigned i, const Vector2 &p) const
+{
+	return std::abs(Get(NORMAL_X)[i] * (p.x - Get(START_X)[i]) + Get(NORMAL_Y)[i] * (p.y - Get(START_Y)[i]));
+}
+
+const bool EdgeTable::Intersect(const unsigned i, const EdgeTable &t, const unsigned j, Vector2 &out) const
+{
+	CRASH2D_COUNT(COUNTER_EDGE_TESTS, 1);
+
+	const Precision_t x1 = Get(START_X)[i];
+	const Precision_t y1 = Get(START_Y)[i];
+
+	const Precision_t x2 = x1 + Get(DIR_X)[i];
+	const Precision_t y2 = y1 + Get(DIR_Y)[i];
+
+	const Precision_t x3 = t.Get(START_X)[j];
+	const Precision_t y3 = t.Get(START_Y)[j];
+
+	const Precision_t x4 = x3 + t.Get(DIR_X)[j];
+	const Precision_t y4 = y3 + t.Get(DIR_Y)[j];
+
+	const Precision_t Bottom = (x1 - x2) * (y3 - y4) - (y1 - y2) * (x3 - x4);
+
+	const Precision_t xTop = (x1 * y2 - y1 * x2) * (x3 - x4) - (x1 - x2) * (x3 * y4 - y3 * x4);
+	const Precision_t yTop = (x1 * y2 - y1 * x2) * (y3 - y4) - (y1 - y2) * (x3 * y4 - y3 * x4);
+
+	out = Vector2(xTop / Bottom, yTop / Bottom);
+
+	// Same test as Segment::Contains() on both sides
+	auto contains = [&out](const Vector2 &start, const Vector2 &dir)
+	{
+		const Vector2 ca = out - start;
+		const Precision_t dot = dir.Dot(ca);
+
+		return (AreEqual(dir.Cross(ca), 0) && dot >= 0 && dot <= dir.LengthSq());
+	};
+
+	return (contains(GetStart(i), GetDirection(i)) && contains(t.GetStart(j), t.GetDirection(j)));
+}
+
+const Segment SideView::Iterator::operator * () const
+{
+	return _table->GetSide(_index);
+}
+
+const Segment SideView::operator [] (const unsigned i) const
+{
+	return _table->GetSide(i);
+}
+}
@@ -0,0 +1,98 @@
+#include <Crash2D/memory.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+namespace Crash2D
+{
+static std::atomic<Allocator*> allocator(nullptr);
+
+// Relaxed, these are statistics and order nothing else
+static std::atomic<uint64_t> held[MEMORY_TAG_COUNT];
+static std::atomic<uint64_t> peaks[MEMORY_TAG_COUNT];
+static std::atomic<uint64_t> counts[MEMORY_TAG_COUNT];
+
+MemoryStats::MemoryStats()
+{
+	std::fill(bytes, bytes + MEMORY_TAG_COUNT, 0);
+	std::fill(peak, peak + MEMORY_TAG_COUNT, 0);
+	std::fill(allocations, allocations + MEMORY_TAG_COUNT, 0);
+}
+
+const char* MemoryStats::GetName(const MemoryTag t)
+{
+	static const char *NAMES[MEMORY_TAG_COUNT] = { "shapes", "broadphase", "world", "arenas" };
+
+	return NAMES[t];
+}
+
+const uint64_t MemoryStats::GetTotal() const
+{
+	uint64_t total = 0;
+
+	for (auto && b : bytes)
+		total += b;
+
+	return total;
+}
+
+const bool SetAllocator(Allocator *a)
+{
+	for (auto && h : held)
+	{
+		if (h.load(std::memory_order_relaxed) != 0)
+			return false;
+	}
+
+	allocator.store(a, std::memory_order_release);
+	return true;
+}
+
+Allocator* GetAllocator()
+{
+	return allocator.load(std::memory_order_acquire);
+}
+
+const MemoryStats GetMemoryStats()
+{
+	MemoryStats s;
+
+	for (unsigned i = 0; i < MEMORY_TAG_COUNT; i++)
+	{
+		s.bytes[i] = held[i].load(std::memory_order_relaxed);
+		s.peak[i] = peaks[i].load(std::memory_order_relaxed);
+		s.allocations[i] = counts[i].load(std::memory_order_relaxed);
+	}
+
+	return s;
+}
+
+void* Allocate(const size_t bytes, const MemoryTag tag)
+{
+	Allocator *a = GetAllocator();
+	void *p = a ? a->Allocate(bytes, tag) : ::operator new(bytes);
+
+	const uint64_t now = held[tag].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+	uint64_t peak = peaks[tag].load(std::memory_order_relaxed);
+
+	while (now > peak && !peaks[tag].compare_exchange_weak(peak, now, std::memory_order_relaxed))
+		;
+
+	counts[tag].fetch_add(1, std::memory_order_relaxed);
+	return p;
+}
+
+void Deallocate(void *p, const size_t bytes, const MemoryTag tag)
+{
+	held[tag].fetch_sub(bytes, std::memory_order_relaxed);
+
+	Allocator *a = GetAllocator();
+
+	if (a)
+		a->Deallocate(p, bytes, tag);
+
+	else
+		::operator delete(p);
+}
+}
@@ -0,0 +1,354 @@
+#include <Crash2D/oriented_box.hpp>
+#include <Crash2D/box.hpp>
+#include <Crash2D/circle.hpp>
+#include <Crash2D/segment.hpp>
+#include <Crash2D/projection.hpp>
+#include <Crash2D/collision.hpp>
+#include <Crash2D/counters.hpp>
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#ifndef M_PI
+#define M_PI 3.14159265359
+#endif
+
+namespace Crash2D
+{
+OrientedBox::OrientedBox() : Polygon(), _halfExtents(Vector2(0, 0))
+{
+	SetPointCount(4);
+	_axes = { Axis(1, 0), Axis(0, 1) };
+	UpdateSides();
+}
+
+OrientedBox::OrientedBox(const Vector2 &c, const Vector2 &e, const Precision_t r) : Polygon(), _halfExtents(e)
+{
+	const Precision_t radians = (r * M_PI) / 180;
+	const Axis u(std::cos(radians), std::sin(radians));
+
+	SetPointCount(4);
+	_center = c;
+	_axes = { u, Axis(-u.y, u.x) };
+
+	UpdatePoints();
+	UpdateSides();
+}
+
+const Vector2& OrientedBox::GetHalfExtents() const
+{
+	return _halfExtents;
+}
+
+const Vector2 OrientedBox::ToLocal(const Vector2 &p) const
+{
+	const Vector2 d = p - GetCenter();
+	return Vector2(d.Dot(_axes[0]), d.Dot(_axes[1]));
+}
+
+const Vector2 OrientedBox::GetNearestPoint(const Vector2 &p) const
+{
+	const Vector2 l = ToLocal(p);
+
+	const Precision_t x = std::max(-_halfExtents.x, std::min(l.x, _halfExtents.x));
+	const Precision_t y = std::max(-_halfExtents.y, std::min(l.y, _halfExtents.y));
+
+	return GetCenter() + _axes[0] * x + _axes[1] * y;
+}
+
+const Projection OrientedBox::Project(const Axis &a) const
+{
+	CRASH2D_COUNT(COUNTER_PROJECTIONS, 1);
+
+	const Precision_t c = a.Dot(GetCenter());
+	const Precision_t r = std::abs(a.Dot(_axes[0])) * _halfExtents.x + std::abs(a.Dot(_axes[1])) * _halfExtents.y;
+
+	return Projection(c - r, c + r);
+}
+
+const bool OrientedBox::Contains(const Vector2 &v) const
+{
+	const Vector2 l = ToLocal(v);
+	return (std::abs(l.x) <= _halfExtents.x && std::abs(l.y) <= _halfExtents.y);
+}
+
+const bool OrientedBox::Contains(const Circle &c) const
+{
+	const Vector2 l = ToLocal(c.GetCenter());
+	const Precision_t r = c.GetRadius();
+
+	return (std::abs(l.x) + r <= _halfExtents.x && std::abs(l.y) + r <= _halfExtents.y);
+}
+
+const bool OrientedBox::Overlaps(const Shape &s) const
+{
+	return s.Overlaps(*this);
+}
+
+const bool OrientedBox::Overlaps(const Circle &c) const
+{
+	const Vector2 d = c.GetCenter() - GetNearestPoint(c.GetCenter());
+	return (d.LengthSq() < c.GetRadius() * c.GetRadius());
+}
+
+const bool OrientedBox::Overlaps(const OrientedBox &b) const
+{
+	Precision_t overlap;
+	return (Separate(b, overlap) != Vector2(0, 0));
+}
+
+const bool OrientedBox::Overlaps(const Box &b) const
+{
+	return Overlaps(static_cast<const OrientedBox&>(b));
+}
+
+const Vector2 OrientedBox::GetDisplacement(const Shape &s) const
+{
+	return -s.GetDisplacement(*this);
+}
+
+const Vector2 OrientedBox::GetDisplacement(const Circle &c) const
+{
+	Precision_t overlap;
+	return Separate(c, overlap);
+}
+
+const Vector2 OrientedBox::GetDisplacement(const OrientedBox &b) const
+{
+	Precision_t overlap;
+	return Separate(b, overlap);
+}
+
+const Vector2 OrientedBox::GetDisplacement(const Box &b) const
+{
+	return GetDisplacement(static_cast<const OrientedBox&>(b));
+}
+
+const Vector2 OrientedBox::GetDisplacement(const Shape &s, bool &overlaps) const
+{
+	return -s.GetDisplacement(*this, overlaps);
+}
+
+const Vector2 OrientedBox::GetDisplacement(const Circle &c, bool &overlaps) const
+{
+	overlaps = Overlaps(c);
+
+	if (!overlaps)
+		return Vector2(0, 0);
+
+	Precision_t overlap;
+	return Separate(c, overlap);
+}
+
+const Vector2 OrientedBox::GetDisplacement(const OrientedBox &b, bool &overlaps) const
+{
+	Precision_t overlap;
+	const Vector2 displacement = Separate(b, overlap);
+
+	overlaps = (displacement != Vector2(0, 0));
+	return displacement;
+}
+
+const Vector2 OrientedBox::GetDisplacement(const Box &b, bool &overlaps) const
+{
+	return GetDisplacement(static_cast<const OrientedBox&>(b), overlaps);
+}
+
+const Collision OrientedBox::GetCollision(const Shape &s) const
+{
+	return -s.GetCollision(*this);
+}
+
+const Collision OrientedBox::GetCollision(const Circle &c) const
+{
+	// Determine if this box contains
+	// the circle "c"
+	bool contains = false;
+
+	// Determine if the circle "c"
+	// contains this box
+	bool contained = false;
+
+	// Intersection points
+	std::vector<Vector2> intersects(0);
+
+	Precision_t overlap;
+	const Vector2 displacement = Separate(c, overlap);
+
+	bool doesOverlap = (displacement != Vector2(0, 0));
+
+	if (doesOverlap)
+	{
+		contains = Contains(c);
+		contained = c.Contains(*this);
+		intersects = GetIntersects(c);
+	}
+
+	return Collision(doesOverlap, std::move(intersects), contains, contained, overlap, displacement);
+}
+
+const Collision OrientedBox::GetCollision(const OrientedBox &b) const
+{
+	// Check if this contains b
+	bool contains = false;
+
+	// Check if b contains this
+	bool contained = false;
+
+	// Intersection points
+	std::vector<Vector2> intersects(0);
+
+	Precision_t overlap;
+	const Vector2 displacement = Separate(b, overlap);
+
+	bool doesOverlap = (displacement != Vector2(0, 0));
+
+	if (doesOverlap)
+	{
+		contains = Contains(b);
+		contained = b.Contains(*this);
+		intersects = GetIntersects(b);
+	}
+
+	return Collision(doesOverlap, std::move(intersects), contains, contained, overlap, displacement);
+}
+
+const Collision OrientedBox::GetCollision(const Box &b) const
+{
+	return GetCollision(static_cast<const OrientedBox&>(b));
+}
+
+const Vector2 OrientedBox::Separate(const OrientedBox &b, Precision_t &overlap) const
+{
+	const Axis axes[4] = { _axes[0], _axes[1], b._axes[0], b._axes[1] };
+
+	overlap = std::numeric_limits<Precision_t>::infinity();
+	Axis smallest;
+
+	CRASH2D_COUNT(COUNTER_DISPLACEMENTS, 1);
+
+	for (auto && axis : axes)
+	{
+		CRASH2D_COUNT(COUNTER_AXES, 1);
+
+		const Projection pA = b.Project(axis);
+		const Projection pB = Project(axis);
+
+		// No Collision
+		if (!pA.IsOverlap(pB))
+		{
+			CRASH2D_COUNT(COUNTER_EARLY_OUTS, 1);
+			overlap = 0;
+			return Vector2(0, 0);
+		}
+
+		const Precision_t o = pA.GetOverlap(pB);
+
+		if (std::abs(o) < std::abs(overlap))
+		{
+			overlap = o;
+			smallest = axis;
+		}
+	}
+
+	return smallest * overlap;
+}
+
+const Vector2 OrientedBox::Separate(const Circle &c, Precision_t &overlap) const
+{
+	const Vector2 l = ToLocal(c.GetCenter());
+	const Precision_t r = c.GetRadius();
+
+	overlap = 0;
+
+	// Center outside the box, push along the direction from the nearest point
+	if (std::abs(l.x) > _halfExtents.x || std::abs(l.y) > _halfExtents.y)
+	{
+		const Precision_t x = std::max(-_halfExtents.x, std::min(l.x, _halfExtents.x));
+		const Precision_t y = std::max(-_halfExtents.y, std::min(l.y, _halfExtents.y));
+
+		const Vector2 d = l - Vector2(x, y);
+		const Precision_t distSq = d.LengthSq();
+
+		if (distSq >= r * r)
+			return Vector2(0, 0);
+
+		const Precision_t dist = std::sqrt(distSq);
+		overlap = r - dist;
+
+		return (_axes[0] * d.x + _axes[1] * d.y) * (overlap / dist);
+	}
+
+	// Center inside the box, push out through the nearest face
+	const Precision_t dx = _halfExtents.x - std::abs(l.x);
+	const Precision_t dy = _halfExtents.y - std::abs(l.y);
+
+	if (dx < dy)
+	{
+		overlap = dx + r;
+		return _axes[0] * (l.x < 0 ? -overlap : overlap);
+	}
+
+	overlap = dy + r;
+	return _axes[1] * (l.y < 0 ? -overlap : overlap);
+}
+
+void OrientedBox::ReCalc()
+{
+	const Vector2 e0 = GetPoint(1) - GetPoint(0);
+	const Vector2 e1 = GetPoint(2) - GetPoint(1);
+
+	const Precision_t l0 = e0.Length();
+	const Precision_t l1 = e1.Length();
+
+	const Axis u = (l0 > 0) ? e0 / l0 : Axis(1, 0);
+	const Axis v = (l1 > 0) ? e1 / l1 : Axis(-u.y, u.x);
+
+	_axes = { u, v };
+	_halfExtents = Vector2(l0 / 2, l1 / 2);
+	_center = (GetPoint(0) + GetPoint(1) + GetPoint(2) + GetPoint(3)) / 4;
+
+	UpdateSides();
+}
+
+void OrientedBox::SetFrame(const Vector2 &c, const Vector2 &e, const Axis &u, const Axis &v)
+{
+	_axes = { u, v };
+	_halfExtents = e;
+	_center = c;
+
+	UpdateSides();
+}
+
+void OrientedBox::SetLocalSpace(const bool local)
+{
+}
+
+void OrientedBox::UpdatePoints()
+{
+	const Vector2 u = _axes[0] * _halfExtents.x;
+	const Vector2 v = _axes[1] * _halfExtents.y;
+
+	SetPoint(0, GetCenter() - u - v);
+	SetPoint(1, GetCenter() + u - v);
+	SetPoint(2, GetCenter() + u + v);
+	SetPoint(3, GetCenter() - u + v);
+}
+
+void OrientedBox::UpdateSides()
+{
+	_edges.Clear();
+
+	for (unsigned i = 0; i < 4; i++)
+		_edges.Add(GetPoint(i), GetPoint(i + 1 == 4 ? 0 : i + 1));
+
+	_vertices.Assign(_points);
+}
+
+Shape* OrientedBox::Clone()
+{
+	return new OrientedBox(*this);
+}
+
+}
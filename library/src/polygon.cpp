@@ -1,15 +1,20 @@
 #include <Crash2D/projection.hpp>
+#include <Crash2D/projection_kernel.hpp>
 #include <Crash2D/collision.hpp>
+#include <Crash2D/capsule.hpp>
 #include <Crash2D/polygon.hpp>
 #include <Crash2D/segment.hpp>
 #include <Crash2D/circle.hpp>
+#include <Crash2D/counters.hpp>
 
 #include <limits>
 #include <algorithm>
+#include <map>
+#include <memory>
 
 namespace Crash2D
 {
-Polygon::Polygon() : ShapeImpl(), _side(0)
+Polygon::Polygon() : ShapeImpl(), _local(false), _dirty(false)
 {
 }
 
@@ -20,12 +25,162 @@ const Projection Polygon::Project(const Shape &s, const Axis &a) const
 
 const AxesVec& Polygon::GetAxes() const
 {
+	UpdateWorld();
 	return _axes;
 }
 
-const std::vector<Segment>& Polygon::GetSides() const
+const SideView Polygon::GetSides() const
 {
-	return _side;
+	UpdateWorld();
+	return SideView(_edges);
+}
+
+const EdgeTable& Polygon::GetEdges() const
+{
+	UpdateWorld();
+	return _edges;
+}
+
+const PointArray& Polygon::GetVertices() const
+{
+	UpdateWorld();
+	return _vertices;
+}
+
+const Vector2& Polygon::GetCenter() const
+{
+	UpdateWorld();
+	return _center;
+}
+
+void Polygon::SetPointCount(const unsigned &c)
+{
+	if (_local)
+	{
+		_localPoints.resize(c);
+		_dirty = true;
+	}
+
+	ShapeImpl::SetPointCount(c);
+}
+
+void Polygon::SetPoint(const unsigned &i, const Vector2 &p)
+{
+	if (_local)
+	{
+		_localPoints[i] = p;
+		_dirty = true;
+		return;
+	}
+
+	ShapeImpl::SetPoint(i, p);
+}
+
+const Vector2& Polygon::GetPoint(const unsigned &i) const
+{
+	UpdateWorld();
+	return _points[i];
+}
+
+const std::vector<Vector2>& Polygon::GetPoints() const
+{
+	UpdateWorld();
+	return _points;
+}
+
+const size_t Polygon::GetMemoryUsage() const
+{
+	return ShapeImpl::GetMemoryUsage() + (_axes.capacity() + _localAxes.capacity()) * sizeof(Axis) +
+		_localPoints.capacity() * sizeof(Vector2) + _edges.GetMemoryUsage() + _vertices.GetMemoryUsage();
+}
+
+void Polygon::SetLocalSpace(const bool local)
+{
+	if (local == _local)
+		return;
+
+	if (local)
+	{
+		_localPoints = _points;
+		_localAxes = _axes;
+		_localCenter = _center;
+		_transform = AffineMatrix();
+	}
+
+	else
+	{
+		UpdateWorld();
+
+		_localPoints.clear();
+		_localAxes.clear();
+		_transform = AffineMatrix();
+	}
+
+	_local = local;
+	_dirty = false;
+}
+
+const bool Polygon::IsLocalSpace() const
+{
+	return _local;
+}
+
+void Polygon::SetTransform(const AffineMatrix &m)
+{
+	SetLocalSpace(true);
+
+	if (!_local)
+		return;
+
+	_transform = m;
+	_dirty = true;
+}
+
+const AffineMatrix& Polygon::GetTransform() const
+{
+	return _transform;
+}
+
+void Polygon::Refresh()
+{
+	UpdateWorld();
+}
+
+const std::vector<Vector2>& Polygon::GetLocalPoints() const
+{
+	return _local ? _localPoints : _points;
+}
+
+void Polygon::UpdateWorld() const
+{
+	if (!_dirty)
+		return;
+
+	// Cleared first, the rebuild below reads points through the public accessors
+	_dirty = false;
+
+	_points.resize(_localPoints.size());
+	_transform.TransformPoints(_localPoints.data(), _points.data(), _localPoints.size());
+
+	// Normals follow the inverse transpose, so the local axes only need rotating and rescaling
+	const AffineMatrix inv = _transform.Inverse();
+
+	_axes.resize(_localAxes.size());
+
+	for (unsigned i = 0; i < _localAxes.size(); i++)
+	{
+		const Axis &n = _localAxes[i];
+		_axes[i] = Axis(inv.a * n.x + inv.b * n.y, inv.c * n.x + inv.d * n.y).Normalize();
+	}
+
+	_edges.Clear();
+	_edges.Reserve(_points.size());
+
+	for (unsigned i = 0; i < _points.size(); i++)
+		_edges.Add(_points[i], _points[i + 1 == _points.size() ? 0 : i + 1]);
+
+	_vertices.Assign(_points);
+	_center = _transform.TransformPoint(_localCenter);
 }
 
 const Vector2 Polygon::NearestVertex(const Vector2 &p) const
@@ -47,65 +202,84 @@ const Vector2 Polygon::NearestVertex(const Vector2 &p) const
 	return v;
 }
 
-void Polygon::ReCalc()
+// Builds the sides, deduplicated axes and center of the given points
+static void CalcGeometry(const std::vector<Vector2> &points, EdgeTable &edges, AxesVec &axes, Vector2 &center)
 {
 	Precision_t x = 0;
 	Precision_t y = 0;
 
-	_axes.clear();
-	_side.clear();
+	axes.clear();
+	edges.Clear();
 
-	for (unsigned i = 0; i < GetPointCount(); i++)
+	axes.reserve(points.size());
+	edges.Reserve(points.size());
+
+	for (unsigned i = 0; i < points.size(); i++)
 	{
-		x += _points[i].x;
-		y += _points[i].y;
+		x += points[i].x;
+		y += points[i].y;
 
-		const Vector2 p1 = GetPoint(i);
-		const Vector2 p2 =  GetPoint(i + 1 == GetPointCount() ? 0 : i + 1);
+		const Vector2 p1 = points[i];
+		const Vector2 p2 =  points[i + 1 == points.size() ? 0 : i + 1];
 
-		const Segment l(p1, p2);
+		edges.Add(p1, p2);
+		axes.push_back(edges.GetNormal(i));
+	}
 
-		bool parallel = false;
+	ShapeImpl::RemoveParallelAxes(axes);
 
-		for (auto && ln : _side)
-		{
-			if (l.IsParallel(ln))
-			{
-				parallel = true;
-				break;
-			}
-		}
+	center = Vector2(x / points.size(), y / points.size());
+}
 
-		_side.push_back(l);
+void Polygon::ReCalc()
+{
+	if (_local)
+	{
+		// The world geometry follows from the local geometry on the next query
+		EdgeTable edges;
+		CalcGeometry(_localPoints, edges, _localAxes, _localCenter);
+		_dirty = true;
 
-		if (!parallel)
-		{
-			const Vector2 edge = p1 - p2;
-			const Axis normal = edge.Perpendicular().Normalize();
-			_axes.push_back(normal);
-		}
+		return;
 	}
 
-	_center = Vector2(x / GetPointCount(), y / GetPointCount());
+	CalcGeometry(_points, _edges, _axes, _center);
+	_vertices.Assign(_points);
 }
 
-const Projection Polygon::Project(const Axis &a) const
+const AxesVec Polygon::MergeAxes(const Polygon &p) const
 {
-	Precision_t min = a.Dot(GetPoint(0));
-	Precision_t max = min;
+	const AxesVec &A = GetAxes();
+	const AxesVec &B = p.GetAxes();
 
-	for (unsigned i = 1; i < GetPointCount(); i++)
-	{
-		Precision_t prj = a.Dot(GetPoint(i));
+	AxesVec axes;
+	axes.reserve(A.size() + B.size());
+	axes.insert(axes.end(), A.begin(), A.end());
+	axes.insert(axes.end(), B.begin(), B.end());
 
-		if (prj < min)
-			min = prj;
+	RemoveParallelAxes(axes);
 
-		else if (prj > max)
-			max = prj;
-	}
+	return axes;
+}
+
+void Polygon::MergeAxes(const Polygon &p, ArenaVector<Axis> &axes) const
+{
+	const AxesVec &A = GetAxes();
+	const AxesVec &B = p.GetAxes();
+
+	axes.clear();
+	axes.reserve(A.size() + B.size());
+	axes.insert(axes.end(), A.begin(), A.end());
+	axes.insert(axes.end(), B.begin(), B.end());
+
+	RemoveParallelAxes(axes);
+}
 
-	return Projection(min, max);
+const Projection Polygon::Project(const Axis &a) const
+{
+	CRASH2D_COUNT(COUNTER_PROJECTIONS, 1);
+
+	return ProjectPoints(GetVertices(), a);
 }
 
 const bool Polygon::TriangleContains(const Vector2 &p, const Vector2 &a, const Vector2 &b, const Vector2 &c) const
@@ -174,9 +348,11 @@ const bool Polygon::Contains(const Circle &c) const
 	if (!Contains(center))
 		return false;
 
-	for(auto && s : GetSides())
+	UpdateWorld();
+
+	for (unsigned i = 0; i < _edges.GetSize(); i++)
 	{
-		const Precision_t dist = s.DistancePoint(center);
+		const Precision_t dist = _edges.DistancePoint(i, center);
 
 		if (c.GetRadius() > dist)
 			return false;
@@ -197,6 +373,17 @@ const bool Polygon::Contains(const Polygon &p) const
 	return true;
 }
 
+const bool Polygon::Contains(const Capsule &c) const
+{
+	for (auto && pt : c.GetPoints())
+	{
+		if (!Contains(Circle(pt, c.GetRadius())))
+			return false;
+	}
+
+	return true;
+}
+
 const bool Polygon::IsInside(const Shape &s) const
 {
 	return s.Contains(*this);
@@ -217,6 +404,11 @@ const bool Polygon::IsInside(const Polygon &p) const
 	return p.Contains(*this);
 }
 
+const bool Polygon::IsInside(const Capsule &c) const
+{
+	return c.Contains(*this);
+}
+
 const bool Polygon::Overlaps(const Shape &s) const
 {
 	return s.Overlaps(*this);
@@ -240,16 +432,13 @@ const bool Polygon::Overlaps(const Circle &c) const
 
 const bool Polygon::Overlaps(const Polygon &p) const
 {
-	const AxesVec &A = GetAxes();
-	const AxesVec &B = p.GetAxes();
-
-	AxesVec axes;
-
-	axes.reserve(A.size() + B.size());
-	axes.insert(axes.end(), A.begin(), A.end());
-	axes.insert(axes.end(), B.begin(), B.end());
+	Precision_t overlap;
+	return (SeparatePoints(MergeAxes(p), GetVertices(), p.GetVertices(), overlap) != Vector2(0, 0));
+}
 
-	return (CalcDisplacement(axes, *this, p) != Vector2(0, 0));
+const bool Polygon::Overlaps(const Capsule &c) const
+{
+	return c.Overlaps(*this);
 }
 
 const std::vector<Vector2> Polygon::GetIntersects(const Shape &s) const
@@ -281,13 +470,9 @@ const std::vector<Vector2> Polygon::GetIntersects(const Circle &c) const
 {
 	std::vector<Vector2> intersections(0);
 
-	std::vector<Segment> sides;
-
 	for (auto && side : GetSides())
 	{
-		const Segment seg(side.GetPoint(0), side.GetPoint(1));
-
-		const std::vector<Vector2> intercepts = c.GetIntersects(seg);
+		const std::vector<Vector2> intercepts = c.GetIntersects(side);
 
 		for (auto && pt : intercepts)
 		{
@@ -303,42 +488,177 @@ const std::vector<Vector2> Polygon::GetIntersects(const Circle &c) const
 
 const std::vector<Vector2> Polygon::GetIntersects(const Polygon &p) const
 {
-	std::vector<Vector2> intersects(0);
+	if (GetSides().size() + p.GetSides().size() > SWEEP_THRESHOLD)
+		return GetIntersectsSweep(p);
+
+	return GetIntersectsBrute(p);
+}
+
+// Intersects two sets of sides with a sweep along x, scratch space is drawn through the allocator of the points
+template <typename Points>
+static void IntersectEdgesSweep(const EdgeTable &edgesA, const EdgeTable &edgesB, Points &intersects)
+{
+	typedef std::allocator_traits<typename Points::allocator_type> Traits;
+
+	struct Bounds
+	{
+		Precision_t minX, maxX, minY, maxY;
+		unsigned index;
+	};
 
-	std::vector<Segment> sidesA;
-	std::vector<Segment> sidesB;
+	typedef std::vector<Bounds, typename Traits::template rebind_alloc<Bounds>> BoundsVec;
+	typedef std::vector<const Bounds*, typename Traits::template rebind_alloc<const Bounds*>> ActiveVec;
+	typedef std::pair<unsigned, unsigned> Pair;
+	typedef std::pair<const Precision_t, Precision_t> Found;
 
-	for (auto s : GetSides())
+	auto sortedBounds = [&intersects](const EdgeTable &edges) -> BoundsVec
 	{
-		Segment sT(s.GetPoint(0), s.GetPoint(1));
-		sidesA.push_back(sT);
+		BoundsVec bounds(intersects.get_allocator());
+		bounds.reserve(edges.GetSize());
+
+		for (unsigned i = 0; i < edges.GetSize(); i++)
+		{
+			const Vector2 a = edges.GetStart(i);
+			const Vector2 b = edges.GetEnd(i);
+
+			bounds.push_back({ std::min(a.x, b.x), std::max(a.x, b.x), std::min(a.y, b.y), std::max(a.y, b.y), i });
+		}
+
+		std::sort(std::begin(bounds), std::end(bounds), [](const Bounds &l, const Bounds &r)
+		{
+			return l.minX < r.minX;
+		});
+
+		return bounds;
+	};
+
+	const BoundsVec boundsA = sortedBounds(edgesA);
+	const BoundsVec boundsB = sortedBounds(edgesB);
+
+	// Sweep both sets of sides along x, keeping the sides that still span the sweep position
+	std::vector<Pair, typename Traits::template rebind_alloc<Pair>> pairs(intersects.get_allocator());
+	ActiveVec activeA(intersects.get_allocator());
+	ActiveVec activeB(intersects.get_allocator());
+
+	unsigned nextA = 0;
+	unsigned nextB = 0;
+
+	while (nextA < boundsA.size() || nextB < boundsB.size())
+	{
+		const bool fromA = (nextB == boundsB.size() || (nextA < boundsA.size() && boundsA[nextA].minX <= boundsB[nextB].minX));
+		const Bounds &e = fromA ? boundsA[nextA++] : boundsB[nextB++];
+
+		ActiveVec &own = fromA ? activeA : activeB;
+		ActiveVec &other = fromA ? activeB : activeA;
+
+		other.erase(std::remove_if(std::begin(other), std::end(other), [&e](const Bounds *o)
+		{
+			return o->maxX < e.minX;
+		}), std::end(other));
+
+		for (auto && o : other)
+		{
+			if (o->minY <= e.maxY && e.minY <= o->maxY)
+				pairs.push_back(fromA ? std::make_pair(e.index, o->index) : std::make_pair(o->index, e.index));
+		}
+
+		own.push_back(&e);
 	}
 
-	for (auto s : p.GetSides())
+	// Visit candidates in the same order as the brute force path so the results match
+	std::sort(std::begin(pairs), std::end(pairs));
+
+	intersects.clear();
+	std::multimap<Precision_t, Precision_t, std::less<Precision_t>, typename Traits::template rebind_alloc<Found>> found(intersects.get_allocator());
+
+	for (auto && pr : pairs)
 	{
-		Segment sT(s.GetPoint(0), s.GetPoint(1));
-		sidesB.push_back(sT);
+		Vector2 pt;
+
+		if (edgesA.Intersect(pr.first, edgesB, pr.second, pt))
+		{
+			bool duplicate = false;
+
+			// Only points within the comparison tolerance on x can compare equal, widened to absorb rounding
+			auto it = found.lower_bound(pt.x - 2 * CMP_TOLERANCE);
+			auto end = found.upper_bound(pt.x + 2 * CMP_TOLERANCE);
+
+			for (; it != end; ++it)
+			{
+				if (Vector2(it->first, it->second) == pt)
+				{
+					duplicate = true;
+					break;
+				}
+			}
+
+			if (!duplicate)
+			{
+				found.insert(std::make_pair(pt.x, pt.y));
+				intersects.push_back(pt);
+			}
+		}
 	}
+}
+
+// Intersects every side of one set with every side of the other
+template <typename Points>
+static void IntersectEdgesBrute(const EdgeTable &edgesA, const EdgeTable &edgesB, Points &intersects)
+{
+	intersects.clear();
 
-	for (auto sA : sidesA)
+	for (unsigned a = 0; a < edgesA.GetSize(); a++)
 	{
-		for (auto sB : sidesB)
+		for (unsigned b = 0; b < edgesB.GetSize(); b++)
 		{
-			auto i = sA.GetIntersects(sB);
+			Vector2 i;
 
-			if (i.size() > 0)
+			if (edgesA.Intersect(a, edgesB, b, i))
 			{
-				auto it = std::find(std::begin(intersects), std::end(intersects), i[0]);
+				auto it = std::find(std::begin(intersects), std::end(intersects), i);
 
 				if (it == std::end(intersects))
-					intersects.push_back(i[0]);
+					intersects.push_back(i);
 			}
 		}
 	}
+}
+
+const std::vector<Vector2> Polygon::GetIntersectsSweep(const Polygon &p) const
+{
+	std::vector<Vector2> intersects(0);
+	IntersectEdgesSweep(GetEdges(), p.GetEdges(), intersects);
 
 	return intersects;
 }
 
+const std::vector<Vector2> Polygon::GetIntersectsBrute(const Polygon &p) const
+{
+	std::vector<Vector2> intersects(0);
+	IntersectEdgesBrute(GetEdges(), p.GetEdges(), intersects);
+
+	return intersects;
+}
+
+void Polygon::GetIntersects(const Shape &s, ArenaVector<Vector2> &intersects) const
+{
+	s.GetIntersects(*this, intersects);
+}
+
+void Polygon::GetIntersects(const Polygon &p, ArenaVector<Vector2> &intersects) const
+{
+	if (GetEdges().GetSize() + p.GetEdges().GetSize() > SWEEP_THRESHOLD)
+		IntersectEdgesSweep(GetEdges(), p.GetEdges(), intersects);
+
+	else
+		IntersectEdgesBrute(GetEdges(), p.GetEdges(), intersects);
+}
+
+const std::vector<Vector2> Polygon::GetIntersects(const Capsule &c) const
+{
+	return c.GetIntersects(*this);
+}
+
 const Vector2 Polygon::GetDisplacement(const Shape &s) const
 {
 	return -s.GetDisplacement(*this);
@@ -362,15 +682,47 @@ const Vector2 Polygon::GetDisplacement(const Circle &c) const
 
 const Vector2 Polygon::GetDisplacement(const Polygon &p) const
 {
-	const AxesVec &A = GetAxes();
-	const AxesVec &B = p.GetAxes();
+	Precision_t overlap;
+	return SeparatePoints(MergeAxes(p), GetVertices(), p.GetVertices(), overlap);
+}
 
-	AxesVec axes;
-	axes.reserve(A.size() + B.size());
-	axes.insert(axes.end(), A.begin(), A.end());
-	axes.insert(axes.end(), B.begin(), B.end());
+const Vector2 Polygon::GetDisplacement(const Capsule &c) const
+{
+	return -c.GetDisplacement(*this);
+}
+
+const Vector2 Polygon::GetDisplacement(const Shape &s, bool &overlaps) const
+{
+	return -s.GetDisplacement(*this, overlaps);
+}
+
+const Vector2 Polygon::GetDisplacement(const Segment &s, bool &overlaps) const
+{
+	const Vector2 displacement = GetDisplacement(s);
+
+	overlaps = (displacement != Vector2(0, 0));
+	return displacement;
+}
+
+const Vector2 Polygon::GetDisplacement(const Circle &c, bool &overlaps) const
+{
+	const Vector2 displacement = GetDisplacement(c);
+
+	overlaps = (displacement != Vector2(0, 0));
+	return displacement;
+}
+
+const Vector2 Polygon::GetDisplacement(const Polygon &p, bool &overlaps) const
+{
+	const Vector2 displacement = GetDisplacement(p);
 
-	return CalcDisplacement(axes, *this, p);
+	overlaps = (displacement != Vector2(0, 0));
+	return displacement;
+}
+
+const Vector2 Polygon::GetDisplacement(const Capsule &c, bool &overlaps) const
+{
+	return -c.GetDisplacement(*this, overlaps);
 }
 
 const Collision Polygon::GetCollision(const Shape &s) const
@@ -405,7 +757,7 @@ const Collision Polygon::GetCollision(const Segment &s) const
 		intersects = GetIntersects(s);
 	}
 
-	return Collision(doesOverlap, intersects, contains, contained, overlap, displacement);
+	return Collision(doesOverlap, std::move(intersects), contains, contained, overlap, displacement);
 }
 
 const Collision Polygon::GetCollision(const Circle &c) const
@@ -440,7 +792,7 @@ const Collision Polygon::GetCollision(const Circle &c) const
 		intersects = GetIntersects(c);
 	}
 
-	return Collision(doesOverlap, intersects, contains, contained, overlap, displacement);
+	return Collision(doesOverlap, std::move(intersects), contains, contained, overlap, displacement);
 }
 
 const Collision Polygon::GetCollision(const Polygon &p) const
@@ -454,18 +806,12 @@ const Collision Polygon::GetCollision(const Polygon &p) const
 	// Intersection points
 	std::vector<Vector2> intersects(0);
 
-	const AxesVec &A = GetAxes();
-	const AxesVec &B = p.GetAxes();
-
-	AxesVec axes;
-	axes.reserve(A.size() + B.size());
-	axes.insert(axes.end(), A.begin(), A.end());
-	axes.insert(axes.end(), B.begin(), B.end());
+	const AxesVec axes = MergeAxes(p);
 
 	// Displacement is the vector to be applied to polygo "p"
 	// in order to seperate it from this
-	const Vector2 displacement = CalcDisplacement(axes, *this, p);
-	const Precision_t overlap = GetOverlap(axes, *this, p);
+	Precision_t overlap;
+	const Vector2 displacement = SeparatePoints(axes, GetVertices(), p.GetVertices(), overlap);
 
 	bool doesOverlap = (displacement != Vector2(0, 0));
 
@@ -476,11 +822,51 @@ const Collision Polygon::GetCollision(const Polygon &p) const
 		intersects = GetIntersects(p);
 	}
 
-	return Collision(doesOverlap, intersects, contains, contained, overlap, displacement);
+	return Collision(doesOverlap, std::move(intersects), contains, contained, overlap, displacement);
+}
+
+const Collision Polygon::GetCollision(const Capsule &c) const
+{
+	return -c.GetCollision(*this);
+}
+
+const Collision Polygon::GetCollision(const Shape &s, ArenaVector<Vector2> &intersects) const
+{
+	return -s.GetCollision(*this, intersects);
+}
+
+const Collision Polygon::GetCollision(const Polygon &p, ArenaVector<Vector2> &intersects) const
+{
+	// The merged axes live in the arena of the buffer too
+	ArenaVector<Axis> axes(intersects.get_allocator());
+	MergeAxes(p, axes);
+
+	Precision_t overlap;
+	const Vector2 displacement = SeparatePoints(axes.data(), axes.size(), GetVertices(), p.GetVertices(), overlap);
+
+	bool doesOverlap = (displacement != Vector2(0, 0));
+
+	if (!doesOverlap)
+	{
+		intersects.clear();
+		return Collision(false, std::vector<Vector2>(), false, false, overlap, displacement);
+	}
+
+	GetIntersects(p, intersects);
+
+	return Collision(true, std::vector<Vector2>(), Contains(p), p.Contains(*this), overlap, displacement);
 }
 
 void Polygon::Transform(const Transformation &t)
 {
+	if (_local)
+	{
+		_transform = AffineMatrix(t) * _transform;
+		_dirty = true;
+
+		return;
+	}
+
 	ShapeImpl::Transform(t);
 	ReCalc();
 }
@@ -0,0 +1,144 @@
+#include <Crash2D/polygon_instance.hpp>
+#include <Crash2D/projection.hpp>
+#include <Crash2D/counters.hpp>
+
+namespace Crash2D
+{
+PolygonGeometry::PolygonGeometry(const std::vector<Vector2> &points)
+{
+	_polygon.SetPointCount(points.size());
+
+	for (unsigned i = 0; i < points.size(); i++)
+		_polygon.SetPoint(i, points[i]);
+
+	_polygon.ReCalc();
+}
+
+const Polygon& PolygonGeometry::GetPolygon() const
+{
+	return _polygon;
+}
+
+const std::vector<Vector2>& PolygonGeometry::GetPoints() const
+{
+	return _polygon.GetPoints();
+}
+
+const AxesVec& PolygonGeometry::GetAxes() const
+{
+	return _polygon.GetAxes();
+}
+
+const Vector2& PolygonGeometry::GetCenter() const
+{
+	return _polygon.GetCenter();
+}
+
+const PointArray& PolygonGeometry::GetVertices() const
+{
+	return _polygon.GetVertices();
+}
+
+PolygonInstance::PolygonInstance(const GeometryPtr &g) : _geometry(g)
+{
+}
+
+PolygonInstance::PolygonInstance(const GeometryPtr &g, const AffineMatrix &m) : _geometry(g), _transform(m)
+{
+}
+
+const GeometryPtr& PolygonInstance::GetGeometry() const
+{
+	return _geometry;
+}
+
+const AffineMatrix& PolygonInstance::GetTransform() const
+{
+	return _transform;
+}
+
+void PolygonInstance::SetTransform(const AffineMatrix &m)
+{
+	_transform = m;
+}
+
+void PolygonInstance::Transform(const Transformation &t)
+{
+	_transform = AffineMatrix(t) * _transform;
+}
+
+const Vector2 PolygonInstance::GetCenter() const
+{
+	return _transform.TransformPoint(_geometry->GetCenter());
+}
+
+const Projection PolygonInstance::Project(const Axis &a) const
+{
+	const AffineMatrix &m = _transform;
+
+	// a . (M p + t) is (M^T a) . p plus a . t
+	const Axis local(m.a * a.x + m.b * a.y, m.c * a.x + m.d * a.y);
+	const Precision_t offset = a.x * m.tx + a.y * m.ty;
+
+	CRASH2D_COUNT(COUNTER_PROJECTIONS, 1);
+
+	const Projection p = ProjectPoints(_geometry->GetVertices(), local);
+
+	return Projection(p.min + offset, p.max + offset);
+}
+
+const bool PolygonInstance::Contains(const Vector2 &v) const
+{
+	return _geometry->GetPolygon().Contains(_transform.Inverse().TransformPoint(v));
+}
+
+const bool PolygonInstance::Overlaps(const PolygonInstance &p) const
+{
+	return (Separate(p) != Vector2(0, 0));
+}
+
+const Vector2 PolygonInstance::GetDisplacement(const PolygonInstance &p) const
+{
+	const Vector2 d = Separate(p);
+
+	// Displacements are directions, so only the linear part applies
+	return Vector2(_transform.a * d.x + _transform.c * d.y, _transform.b * d.x + _transform.d * d.y);
+}
+
+const Polygon PolygonInstance::ToPolygon() const
+{
+	Polygon p = _geometry->GetPolygon();
+	p.SetTransform(_transform);
+
+	return p;
+}
+
+const Vector2 PolygonInstance::Separate(const PolygonInstance &p) const
+{
+	// Scratch space reused across queries on the same thread
+	thread_local std::vector<Vector2> points;
+	thread_local PointArray other;
+	thread_local AxesVec axes;
+
+	// Maps the other instance's local space into this instance's local space
+	const AffineMatrix rel = _transform.Inverse() * p._transform;
+	const AffineMatrix inv = rel.Inverse();
+
+	const std::vector<Vector2> &src = p._geometry->GetPoints();
+
+	points.resize(src.size());
+	rel.TransformPoints(src.data(), points.data(), src.size());
+	other.Assign(points);
+
+	axes = _geometry->GetAxes();
+
+	// Normals follow the inverse transpose
+	for (auto && n : p._geometry->GetAxes())
+		axes.push_back(Axis(inv.a * n.x + inv.b * n.y, inv.c * n.x + inv.d * n.y).Normalize());
+
+	ShapeImpl::RemoveParallelAxes(axes);
+
+	Precision_t overlap;
+	return SeparatePoints(axes, _geometry->GetVertices(), other, overlap);
+}
+}
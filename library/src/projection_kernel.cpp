@@ -0,0 +1,246 @@
+#include <Crash2D/projection_kernel.hpp>
+#include <Crash2D/simd.hpp>
+#include <Crash2D/counters.hpp>
+
+#include <cmath>
+#include <limits>
+
+namespace Crash2D
+{
+static_assert(sizeof(Vector2) == 2 * sizeof(Precision_t), "Axes are read as packed (x, y) pairs");
+
+PointArray::PointArray() : _size(0), _padded(0)
+{
+}
+
+void PointArray::Assign(const std::vector<Vector2> &points)
+{
+	_size = points.size();
+
+	_padded = (_size + Simd::WIDTH - 1) / Simd::WIDTH * Simd::WIDTH;
+	_block.resize(2 * _padded);
+
+	Precision_t *x = _block.data();
+	Precision_t *y = x + _padded;
+
+	for (unsigned i = 0; i < _padded; i++)
+	{
+		const Vector2 &pt = points[i < _size ? i : _size - 1];
+
+		x[i] = pt.x;
+		y[i] = pt.y;
+	}
+}
+
+const unsigned PointArray::GetSize() const
+{
+	return _size;
+}
+
+const size_t PointArray::GetMemoryUsage() const
+{
+	return _block.capacity() * sizeof(Precision_t);
+}
+
+const Precision_t* PointArray::GetX() const
+{
+	return _block.data();
+}
+
+const Precision_t* PointArray::GetY() const
+{
+	return _block.data() + _padded;
+}
+
+const Projection ProjectPoints(const PointArray &p, const Axis &a)
+{
+	if (p.GetSize() == 0)
+		return Projection();
+
+	const Precision_t *x = p.GetX();
+	const Precision_t *y = p.GetY();
+
+	const Simd::Float4 ax = Simd::Set1(a.x);
+	const Simd::Float4 ay = Simd::Set1(a.y);
+
+	Simd::Float4 lo = Simd::Add(Simd::Mul(ax, Simd::Load(x)), Simd::Mul(ay, Simd::Load(y)));
+	Simd::Float4 hi = lo;
+
+	for (unsigned i = Simd::WIDTH; i < p.GetSize(); i += Simd::WIDTH)
+	{
+		const Simd::Float4 d = Simd::Add(Simd::Mul(ax, Simd::Load(x + i)), Simd::Mul(ay, Simd::Load(y + i)));
+
+		lo = Simd::Min(lo, d);
+		hi = Simd::Max(hi, d);
+	}
+
+	return Projection(Simd::ReduceMin(lo), Simd::ReduceMax(hi));
+}
+
+// Projects every point onto four axes at once, one lane per axis
+static void ProjectGroup(const PointArray &p, const Simd::Float4 &ax, const Simd::Float4 &ay, Simd::Float4 &lo, Simd::Float4 &hi)
+{
+	const Precision_t *x = p.GetX();
+	const Precision_t *y = p.GetY();
+
+	lo = Simd::Add(Simd::Mul(ax, Simd::Set1(x[0])), Simd::Mul(ay, Simd::Set1(y[0])));
+	hi = lo;
+
+	// Two independent accumulators hide the latency of the min/max chain
+	Simd::Float4 lo2 = lo;
+	Simd::Float4 hi2 = hi;
+
+	unsigned i = 1;
+
+	for (; i + 1 < p.GetSize(); i += 2)
+	{
+		const Simd::Float4 d = Simd::Add(Simd::Mul(ax, Simd::Set1(x[i])), Simd::Mul(ay, Simd::Set1(y[i])));
+		const Simd::Float4 d2 = Simd::Add(Simd::Mul(ax, Simd::Set1(x[i + 1])), Simd::Mul(ay, Simd::Set1(y[i + 1])));
+
+		lo = Simd::Min(lo, d);
+		hi = Simd::Max(hi, d);
+		lo2 = Simd::Min(lo2, d2);
+		hi2 = Simd::Max(hi2, d2);
+	}
+
+	if (i < p.GetSize())
+	{
+		const Simd::Float4 d = Simd::Add(Simd::Mul(ax, Simd::Set1(x[i])), Simd::Mul(ay, Simd::Set1(y[i])));
+
+		lo = Simd::Min(lo, d);
+		hi = Simd::Max(hi, d);
+	}
+
+	lo = Simd::Min(lo, lo2);
+	hi = Simd::Max(hi, hi2);
+}
+
+// Loads up to four axes into x and y lanes, repeating the last axis to fill the group
+static void LoadAxes(const Axis *axes, const unsigned count, Simd::Float4 &ax, Simd::Float4 &ay)
+{
+	if (count >= Simd::WIDTH)
+	{
+		Simd::LoadPairs(&axes[0].x, ax, ay);
+		return;
+	}
+
+	Axis group[Simd::WIDTH];
+
+	for (unsigned i = 0; i < Simd::WIDTH; i++)
+		group[i] = axes[i < count ? i : count - 1];
+
+	Simd::LoadPairs(&group[0].x, ax, ay);
+}
+
+void ProjectPoints(const PointArray &p, const Axis *axes, const unsigned n, Projection *out)
+{
+	if (p.GetSize() == 0)
+	{
+		std::fill(out, out + n, Projection());
+		return;
+	}
+
+	for (unsigned g = 0; g < n; g += Simd::WIDTH)
+	{
+		Simd::Float4 ax, ay, lo, hi;
+		LoadAxes(axes + g, n - g, ax, ay);
+		ProjectGroup(p, ax, ay, lo, hi);
+
+		Precision_t min[Simd::WIDTH];
+		Precision_t max[Simd::WIDTH];
+
+		Simd::Store(min, lo);
+		Simd::Store(max, hi);
+
+		for (unsigned i = 0; i < Simd::WIDTH && g + i < n; i++)
+			out[g + i] = Projection(min[i], max[i]);
+	}
+}
+
+const Vector2 SeparatePoints(const AxesVec &axes, const PointArray &a, const PointArray &b, Precision_t &overlap)
+{
+	return SeparatePoints(axes.data(), axes.size(), a, b, overlap);
+}
+
+const Vector2 SeparatePoints(const Axis *axes, const unsigned n, const PointArray &a, const PointArray &b, Precision_t &overlap)
+{
+	Precision_t Overlap = std::numeric_limits<Precision_t>::infinity();
+	Axis smallest;
+
+	// Small shapes fill the lanes with axes instead, measured to win below roughly 48 points for the pair
+	const bool wide = (a.GetSize() + b.GetSize() > 48);
+
+	if (a.GetSize() == 0 || b.GetSize() == 0)
+	{
+		overlap = 0;
+		return Vector2(0, 0);
+	}
+
+	CRASH2D_COUNT(COUNTER_DISPLACEMENTS, 1);
+
+	for (unsigned g = 0; g < n; g += Simd::WIDTH)
+	{
+		// Both point sets are projected onto every axis of the group, even past a separating one
+		CRASH2D_COUNT(COUNTER_PROJECTIONS, 2 * std::min(Simd::WIDTH, n - g));
+
+		Precision_t minA[Simd::WIDTH], maxA[Simd::WIDTH];
+		Precision_t minB[Simd::WIDTH], maxB[Simd::WIDTH];
+
+		if (wide)
+		{
+			// Large shapes fill the lanes with points, one axis at a time
+			for (unsigned i = 0; i < Simd::WIDTH && g + i < n; i++)
+			{
+				const Projection prA = ProjectPoints(a, axes[g + i]);
+				const Projection prB = ProjectPoints(b, axes[g + i]);
+
+				minA[i] = prA.min;
+				maxA[i] = prA.max;
+				minB[i] = prB.min;
+				maxB[i] = prB.max;
+			}
+		}
+
+		else
+		{
+			Simd::Float4 ax, ay, loA, hiA, loB, hiB;
+			LoadAxes(axes + g, n - g, ax, ay);
+			ProjectGroup(a, ax, ay, loA, hiA);
+			ProjectGroup(b, ax, ay, loB, hiB);
+
+			Simd::Store(minA, loA);
+			Simd::Store(maxA, hiA);
+			Simd::Store(minB, loB);
+			Simd::Store(maxB, hiB);
+		}
+
+		// Select in axis order so ties resolve exactly as in CalcDisplacement
+		for (unsigned i = 0; i < Simd::WIDTH && g + i < n; i++)
+		{
+			const Projection pA(minB[i], maxB[i]);
+			const Projection pB(minA[i], maxA[i]);
+
+			CRASH2D_COUNT(COUNTER_AXES, 1);
+
+			// No Collision
+			if (!pA.IsOverlap(pB))
+			{
+				CRASH2D_COUNT(COUNTER_EARLY_OUTS, 1);
+				overlap = 0;
+				return Vector2(0, 0);
+			}
+
+			const Precision_t o = pA.GetOverlap(pB);
+
+			if (std::abs(o) < std::abs(Overlap))
+			{
+				Overlap = o;
+				smallest = axes[g + i];
+			}
+		}
+	}
+
+	overlap = Overlap;
+	return smallest * Overlap;
+}
+}
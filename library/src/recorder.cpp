@@ -0,0 +1,158 @@
+#include <Crash2D/recorder.hpp>
+#include <Crash2D/circle.hpp>
+#include <Crash2D/segment.hpp>
+#include <Crash2D/capsule.hpp>
+#include <Crash2D/box.hpp>
+
+namespace Crash2D
+{
+static_assert(sizeof(Precision_t) == sizeof(uint32_t), "Recordings store single precision values");
+
+Recorder::Recorder(std::ostream &out) : _out(out), _good(true)
+{
+	Write(RECORDING_MAGIC);
+	Write(RECORDING_VERSION);
+}
+
+const bool Recorder::IsGood() const
+{
+	return (_good && _out.good());
+}
+
+void Recorder::Add(const ShapeHandle &h, const Shape &s, const MotionType type, const CollisionFilter &filter)
+{
+	WriteOp(RECORD_ADD, h);
+	Write(static_cast<uint8_t>(type));
+	Write(filter.category);
+	Write(filter.mask);
+	Write(filter.group);
+	WriteShape(s);
+}
+
+void Recorder::Remove(const ShapeHandle &h)
+{
+	WriteOp(RECORD_REMOVE, h);
+}
+
+void Recorder::Transform(const ShapeHandle &h, const Transformation &t)
+{
+	WriteOp(RECORD_TRANSFORM, h);
+	WriteVector(t.GetScale());
+	Write(t.GetRotation());
+	WriteVector(t.GetTranslation());
+	WriteVector(t.GetPivot());
+}
+
+void Recorder::Reshape(const ShapeHandle &h, const Shape &s)
+{
+	WriteOp(RECORD_RESHAPE, h);
+	WriteShape(s);
+}
+
+void Recorder::SetFilter(const ShapeHandle &h, const CollisionFilter &filter)
+{
+	WriteOp(RECORD_FILTER, h);
+	Write(filter.category);
+	Write(filter.mask);
+	Write(filter.group);
+}
+
+void Recorder::SetAwake(const ShapeHandle &h, const bool awake)
+{
+	WriteOp(awake ? RECORD_WAKE : RECORD_SLEEP, h);
+}
+
+void Recorder::SetSleepDelay(const unsigned steps)
+{
+	Write(static_cast<uint8_t>(RECORD_SLEEP_DELAY));
+	Write(static_cast<uint32_t>(steps));
+}
+
+void Recorder::Step(const unsigned contacts, const uint64_t hash)
+{
+	Write(static_cast<uint8_t>(RECORD_STEP));
+	Write(static_cast<uint32_t>(contacts));
+	Write(hash);
+}
+
+void Recorder::WriteOp(const RecordOp op, const ShapeHandle &h)
+{
+	Write(static_cast<uint8_t>(op));
+	Write(static_cast<uint32_t>(h.index));
+	Write(static_cast<uint32_t>(h.generation));
+}
+
+void Recorder::WriteVector(const Vector2 &v)
+{
+	Write(v.x);
+	Write(v.y);
+}
+
+void Recorder::WriteShape(const Shape &s)
+{
+	// Boxes keep a center, axes and half extents next to their points, which can not be derived back from them
+	if (const OrientedBox *b = dynamic_cast<const OrientedBox*>(&s))
+	{
+		Write(static_cast<uint8_t>(dynamic_cast<const Box*>(&s) ? RECORD_BOX : RECORD_ORIENTED_BOX));
+
+		for (unsigned i = 0; i < 4; i++)
+			WriteVector(b->GetPoint(i));
+
+		WriteVector(b->GetCenter());
+		WriteVector(b->GetHalfExtents());
+		WriteVector(b->GetAxes()[0]);
+		WriteVector(b->GetAxes()[1]);
+	}
+
+	else if (const Polygon *p = dynamic_cast<const Polygon*>(&s))
+	{
+		// Local space polygons keep their local points and transform, so they replay bit for bit
+		const bool local = p->IsLocalSpace();
+		const std::vector<Vector2> &points = p->GetLocalPoints();
+
+		Write(static_cast<uint8_t>(RECORD_POLYGON));
+		Write(static_cast<uint8_t>(local));
+		Write(static_cast<uint32_t>(points.size()));
+
+		for (auto && pt : points)
+			WriteVector(pt);
+
+		if (local)
+		{
+			const AffineMatrix &m = p->GetTransform();
+
+			for (auto && v : { m.a, m.b, m.c, m.d, m.tx, m.ty })
+				Write(v);
+		}
+	}
+
+	else if (const Circle *c = dynamic_cast<const Circle*>(&s))
+	{
+		Write(static_cast<uint8_t>(RECORD_CIRCLE));
+		WriteVector(c->GetCenter());
+		Write(c->GetRadius());
+	}
+
+	else if (const Capsule *c = dynamic_cast<const Capsule*>(&s))
+	{
+		Write(static_cast<uint8_t>(RECORD_CAPSULE));
+		WriteVector(c->GetPoint(0));
+		WriteVector(c->GetPoint(1));
+		Write(c->GetRadius());
+	}
+
+	else if (const Segment *g = dynamic_cast<const Segment*>(&s))
+	{
+		Write(static_cast<uint8_t>(RECORD_SEGMENT));
+		WriteVector(g->GetPoint(0));
+		WriteVector(g->GetPoint(1));
+	}
+
+	else
+	{
+		// Marks where the recording stops making sense, a replay fails here instead of misreading what follows
+		Write(static_cast<uint8_t>(RECORD_UNSUPPORTED));
+		_good = false;
+	}
+}
+}
@@ -0,0 +1,339 @@
+#include <Crash2D/replayer.hpp>
+#include <Crash2D/circle.hpp>
+#include <Crash2D/segment.hpp>
+#include <Crash2D/capsule.hpp>
+#include <Crash2D/box.hpp>
+
+#include <chrono>
+#include <memory>
+
+namespace Crash2D
+{
+// Copies the geometry of one shape into another of the same kind
+template <typename T>
+static const bool Assign(Shape &dst, const Shape &src)
+{
+	T *d = dynamic_cast<T*>(&dst);
+	const T *s = dynamic_cast<const T*>(&src);
+
+	if (!d || !s)
+		return false;
+
+	*d = *s;
+	return true;
+}
+
+Replayer::Replayer(std::istream &in) : _in(in)
+{
+	uint32_t magic, version;
+
+	if (!Read(magic) || !Read(version) || magic != RECORDING_MAGIC)
+		Fail("Not a recording");
+
+	else if (version != RECORDING_VERSION)
+		Fail("Unsupported recording version " + std::to_string(version));
+}
+
+const bool Replayer::Next(CollisionWorld &world, ReplayStep &step)
+{
+	if (!_error.empty())
+		return false;
+
+	uint8_t op;
+
+	while (Read(op))
+	{
+		ShapeHandle h;
+
+		switch (op)
+		{
+		case RECORD_ADD:
+		{
+			uint32_t index, generation;
+			uint8_t type;
+			CollisionFilter filter;
+
+			if (!Read(index) || !Read(generation) || !Read(type) || !ReadFilter(filter))
+				return Fail("Truncated recording");
+
+			if (type > MOTION_DYNAMIC)
+				return Fail("Unknown motion type " + std::to_string(type));
+
+			Shape *s = ReadShape();
+
+			if (!s)
+				return false;
+
+			h = world.Add(s, static_cast<MotionType>(type), filter);
+
+			if (h.index != index || h.generation != generation)
+				return Fail("The world handed out a different handle than the recording, it must start empty");
+
+			break;
+		}
+
+		case RECORD_REMOVE:
+			if (!ReadHandle(world, h))
+				return false;
+
+			world.Remove(h);
+			break;
+
+		case RECORD_TRANSFORM:
+		{
+			Vector2 scale, translation, pivot;
+			Precision_t rotation;
+
+			if (!ReadHandle(world, h) || !ReadVector(scale) || !Read(rotation) || !ReadVector(translation) || !ReadVector(pivot))
+				return Fail("Truncated recording");
+
+			Transformation t(scale, rotation, translation);
+			t.SetPivot(pivot);
+
+			world.Transform(h, t);
+			break;
+		}
+
+		case RECORD_RESHAPE:
+		{
+			if (!ReadHandle(world, h))
+				return false;
+
+			const std::unique_ptr<Shape> s(ReadShape());
+
+			if (!s)
+				return false;
+
+			Shape &dst = *world.Get(h);
+
+			// Most derived first, boxes are polygons too
+			if (!Assign<Box>(dst, *s) && !Assign<OrientedBox>(dst, *s) && !Assign<Polygon>(dst, *s) &&
+				!Assign<Circle>(dst, *s) && !Assign<Capsule>(dst, *s) && !Assign<Segment>(dst, *s))
+				return Fail("A shape changed kind");
+
+			world.MarkMoved(h);
+			break;
+		}
+
+		case RECORD_FILTER:
+		{
+			CollisionFilter filter;
+
+			if (!ReadHandle(world, h) || !ReadFilter(filter))
+				return Fail("Truncated recording");
+
+			world.SetFilter(h, filter);
+			break;
+		}
+
+		case RECORD_WAKE:
+		case RECORD_SLEEP:
+			if (!ReadHandle(world, h))
+				return false;
+
+			if (op == RECORD_WAKE)
+				world.Wake(h);
+
+			else
+				world.Sleep(h);
+
+			break;
+
+		case RECORD_SLEEP_DELAY:
+		{
+			uint32_t steps;
+
+			if (!Read(steps))
+				return Fail("Truncated recording");
+
+			world.SetSleepDelay(steps);
+			break;
+		}
+
+		case RECORD_STEP:
+		{
+			uint32_t contacts;
+
+			if (!Read(contacts) || !Read(step.expectedHash))
+				return Fail("Truncated recording");
+
+			const auto start = std::chrono::steady_clock::now();
+			step.contacts = world.Step();
+			step.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			step.expectedContacts = contacts;
+			step.hash = world.GetContactHash();
+			return true;
+		}
+
+		default:
+			return Fail("Unknown operation " + std::to_string(op));
+		}
+	}
+
+	return false;
+}
+
+const std::string& Replayer::GetError() const
+{
+	return _error;
+}
+
+const bool Replayer::ReadVector(Vector2 &v)
+{
+	return (Read(v.x) && Read(v.y));
+}
+
+const bool Replayer::ReadHandle(const CollisionWorld &world, ShapeHandle &h)
+{
+	uint32_t index, generation;
+
+	if (!Read(index) || !Read(generation))
+		return Fail("Truncated recording");
+
+	h = ShapeHandle{ index, generation };
+
+	if (!world.IsValid(h))
+		return Fail("The recording refers to a shape the world does not have");
+
+	return true;
+}
+
+const bool Replayer::ReadFilter(CollisionFilter &f)
+{
+	return (Read(f.category) && Read(f.mask) && Read(f.group));
+}
+
+Shape* Replayer::ReadShape()
+{
+	uint8_t kind;
+	Vector2 a, b;
+	Precision_t r;
+
+	if (!Read(kind))
+	{
+		Fail("Truncated recording");
+		return nullptr;
+	}
+
+	switch (kind)
+	{
+	case RECORD_CIRCLE:
+		if (ReadVector(a) && Read(r))
+			return new Circle(a, r);
+
+		break;
+
+	case RECORD_SEGMENT:
+		if (ReadVector(a) && ReadVector(b))
+			return new Segment(a, b);
+
+		break;
+
+	case RECORD_CAPSULE:
+		if (ReadVector(a) && ReadVector(b) && Read(r))
+			return new Capsule(a, b, r);
+
+		break;
+
+	case RECORD_ORIENTED_BOX:
+	case RECORD_BOX:
+	{
+		std::unique_ptr<OrientedBox> box(kind == RECORD_BOX ? new Box() : new OrientedBox());
+		Vector2 e, u, v;
+
+		for (unsigned i = 0; i < 4; i++)
+		{
+			if (!ReadVector(a))
+			{
+				Fail("Truncated recording");
+				return nullptr;
+			}
+
+			box->SetPoint(i, a);
+		}
+
+		if (!ReadVector(b) || !ReadVector(e) || !ReadVector(u) || !ReadVector(v))
+			break;
+
+		box->SetFrame(b, e, u, v);
+		return box.release();
+	}
+
+	case RECORD_POLYGON:
+	{
+		uint8_t local;
+		uint32_t count;
+
+		if (!Read(local) || !Read(count))
+			break;
+
+		if (count < 3 || count > RECORDING_MAX_POINTS)
+		{
+			Fail("Polygon with " + std::to_string(count) + " points");
+			return nullptr;
+		}
+
+		std::unique_ptr<Polygon> p(new Polygon());
+		p->SetPointCount(count);
+
+		for (unsigned i = 0; i < count; i++)
+		{
+			if (!ReadVector(a))
+			{
+				Fail("Truncated recording");
+				return nullptr;
+			}
+
+			p->SetPoint(i, a);
+		}
+
+		p->ReCalc();
+
+		if (local)
+		{
+			Precision_t m[6];
+
+			for (auto && v : m)
+			{
+				if (!Read(v))
+				{
+					Fail("Truncated recording");
+					return nullptr;
+				}
+			}
+
+			const AffineMatrix identity;
+			const AffineMatrix t(m[0], m[1], m[2], m[3], m[4], m[5]);
+
+			// An untouched polygon keeps the world geometry ReCalc() gave it, rebuilding it would round differently
+			p->SetLocalSpace(true);
+
+			if (t.a != identity.a || t.b != identity.b || t.c != identity.c || t.d != identity.d || t.tx != identity.tx || t.ty != identity.ty)
+				p->SetTransform(t);
+		}
+
+		return p.release();
+	}
+
+	case RECORD_UNSUPPORTED:
+		Fail("The recording holds a shape that could not be recorded");
+		return nullptr;
+
+	default:
+		Fail("Unknown shape kind " + std::to_string(kind));
+		return nullptr;
+	}
+
+	Fail("Truncated recording");
+	return nullptr;
+}
+
+const bool Replayer::Fail(const std::string &error)
+{
+	if (_error.empty())
+		_error = error;
+
+	return false;
+}
+}
@@ -3,6 +3,8 @@
 #include <Crash2D/circle.hpp>
 #include <Crash2D/polygon.hpp>
 #include <Crash2D/collision.hpp>
+#include <Crash2D/capsule.hpp>
+#include <Crash2D/counters.hpp>
 
 #include <limits>
 #include <cmath>
@@ -148,6 +150,8 @@ const bool Segment::IsParallel(const Segment &s) const
 
 const Projection Segment::Project(const Axis &a) const
 {
+	CRASH2D_COUNT(COUNTER_PROJECTIONS, 1);
+
 	const Precision_t dot0 = a.Dot(GetPoint(0));
 	const Precision_t dot1 = a.Dot(GetPoint(1));
 
@@ -189,6 +193,11 @@ const bool Segment::Contains(const Polygon &p) const
 	return false;
 }
 
+const bool Segment::Contains(const Capsule &c) const
+{
+	return false;
+}
+
 const bool Segment::IsInside(const Shape &s) const
 {
 	return s.Contains(*this);
@@ -209,6 +218,11 @@ const bool Segment::IsInside(const Polygon &p) const
 	return p.Contains(*this);
 }
 
+const bool Segment::IsInside(const Capsule &c) const
+{
+	return c.Contains(*this);
+}
+
 const bool Segment::Overlaps(const Shape &s) const
 {
 	return s.Overlaps(*this);
@@ -234,6 +248,11 @@ const bool Segment::Overlaps(const Polygon &p) const
 	return p.Overlaps(*this);
 }
 
+const bool Segment::Overlaps(const Capsule &c) const
+{
+	return c.Overlaps(*this);
+}
+
 const std::vector<Vector2> Segment::GetIntersects(const Shape &s) const
 {
 	return s.GetIntersects(*this);
@@ -241,6 +260,8 @@ const std::vector<Vector2> Segment::GetIntersects(const Shape &s) const
 
 const std::vector<Vector2> Segment::GetIntersects(const Segment &s) const
 {
+	CRASH2D_COUNT(COUNTER_EDGE_TESTS, 1);
+
 	const Precision_t x1 = GetPoint(0).x;
 	const Precision_t y1 = GetPoint(0).y;
 
@@ -281,6 +302,11 @@ const std::vector<Vector2> Segment::GetIntersects(const Polygon &p) const
 	return p.GetIntersects(*this);
 }
 
+const std::vector<Vector2> Segment::GetIntersects(const Capsule &c) const
+{
+	return c.GetIntersects(*this);
+}
+
 const Vector2 Segment::GetDisplacement(const Shape &s) const
 {
 	return -s.GetDisplacement(*this);
@@ -288,17 +314,8 @@ const Vector2 Segment::GetDisplacement(const Shape &s) const
 
 const Vector2 Segment::GetDisplacement(const Segment &s) const
 {
-	if (!Overlaps(s))
-		return Vector2(0, 0);
-
-	else
-	{
-		AxesVec axes(2);
-		axes[0] = GetAxis();
-		axes[1] = s.GetAxis();
-
-		return CalcDisplacement(axes, *this, s);
-	}
+	bool overlaps;
+	return GetDisplacement(s, overlaps);
 }
 
 const Vector2 Segment::GetDisplacement(const Circle &c) const
@@ -311,6 +328,45 @@ const Vector2 Segment::GetDisplacement(const Polygon &p) const
 	return -p.GetDisplacement(*this);
 }
 
+const Vector2 Segment::GetDisplacement(const Capsule &c) const
+{
+	return -c.GetDisplacement(*this);
+}
+
+const Vector2 Segment::GetDisplacement(const Shape &s, bool &overlaps) const
+{
+	return -s.GetDisplacement(*this, overlaps);
+}
+
+const Vector2 Segment::GetDisplacement(const Segment &s, bool &overlaps) const
+{
+	overlaps = Overlaps(s);
+
+	if (!overlaps)
+		return Vector2(0, 0);
+
+	AxesVec axes(2);
+	axes[0] = GetAxis();
+	axes[1] = s.GetAxis();
+
+	return CalcDisplacement(axes, *this, s);
+}
+
+const Vector2 Segment::GetDisplacement(const Circle &c, bool &overlaps) const
+{
+	return -c.GetDisplacement(*this, overlaps);
+}
+
+const Vector2 Segment::GetDisplacement(const Polygon &p, bool &overlaps) const
+{
+	return -p.GetDisplacement(*this, overlaps);
+}
+
+const Vector2 Segment::GetDisplacement(const Capsule &c, bool &overlaps) const
+{
+	return -c.GetDisplacement(*this, overlaps);
+}
+
 const Collision Segment::GetCollision(const Shape &s) const
 {
 	return -s.GetCollision(*this);
@@ -331,6 +387,11 @@ const Collision Segment::GetCollision(const Polygon &p) const
 	return -p.GetCollision(*this);
 }
 
+const Collision Segment::GetCollision(const Capsule &c) const
+{
+	return -c.GetCollision(*this);
+}
+
 void Segment::ReCalc()
 {
 	const Vector2 s = GetPoint(1) - GetPoint(0);
@@ -4,13 +4,15 @@
 #include <Crash2D/segment.hpp>
 #include <Crash2D/circle.hpp>
 #include <Crash2D/polygon.hpp>
+#include <Crash2D/oriented_box.hpp>
+#include <Crash2D/box.hpp>
+#include <Crash2D/affine_matrix.hpp>
+#include <Crash2D/counters.hpp>
 
 #include <cmath>
 #include <limits>
-
-#ifndef M_PI
-#define M_PI 3.14159265359
-#endif
+#include <algorithm>
+#include <memory>
 
 namespace Crash2D
 {
@@ -54,20 +56,32 @@ const std::vector<Vector2>& ShapeImpl::GetPoints() const
 	return _points;
 }
 
+const size_t ShapeImpl::GetMemoryUsage() const
+{
+	return _points.capacity() * sizeof(Vector2);
+}
+
 const Precision_t ShapeImpl::GetOverlap(const AxesVec &axes, const Shape &a, const Shape &b) const
 {
 	Vector2 displacement;
 	Precision_t Overlap = std::numeric_limits<Precision_t>::infinity();
 	Axis smallest;
 
+	CRASH2D_COUNT(COUNTER_OVERLAPS, 1);
+
 	for (auto && axis : axes)
 	{
+		CRASH2D_COUNT(COUNTER_AXES, 1);
+
 		const Projection pA = b.Project(axis);
 		const Projection pB = a.Project(axis);
 
 		// No Collision
 		if (!pA.IsOverlap(pB))
+		{
+			CRASH2D_COUNT(COUNTER_EARLY_OUTS, 1);
 			return 0;
+		}
 
 		else
 		{
@@ -93,14 +107,21 @@ const Vector2 ShapeImpl::CalcDisplacement(const AxesVec &axes, const Shape &a, c
 	Precision_t Overlap = std::numeric_limits<Precision_t>::infinity();
 	Axis smallest;
 
+	CRASH2D_COUNT(COUNTER_DISPLACEMENTS, 1);
+
 	for (auto && axis : axes)
 	{
+		CRASH2D_COUNT(COUNTER_AXES, 1);
+
 		const Projection pA = b.Project(axis);
 		const Projection pB = a.Project(axis);
 
 		// No Collision
 		if (!pA.IsOverlap(pB))
+		{
+			CRASH2D_COUNT(COUNTER_EARLY_OUTS, 1);
 			return Vector2(0, 0);
+		}
 
 		else
 		{
@@ -119,34 +140,240 @@ const Vector2 ShapeImpl::CalcDisplacement(const AxesVec &axes, const Shape &a, c
 
 	return displacement;
 }
-void ShapeImpl::Transform(const Transformation &t)
+
+// Scratch space is drawn through the allocator of the axes, so arena backed axes stay off the heap
+template <typename Axes>
+static void RemoveParallel(Axes &axes)
 {
-	for (unsigned i = 0; i < GetPointCount(); ++i)
+	typedef std::allocator_traits<typename Axes::allocator_type> Traits;
+	typedef std::pair<Precision_t, unsigned> Key;
+
+	if (axes.size() < 2)
+		return;
+
+	// Flip every axis into the half plane x > 0, where y alone orders unit axes by angle
+	std::vector<Key, typename Traits::template rebind_alloc<Key>> keys(axes.get_allocator());
+	keys.reserve(axes.size());
+
+	for (unsigned i = 0; i < axes.size(); i++)
 	{
-		Vector2 pt = GetPoint(i);
+		const Axis &a = axes[i];
+		const bool flip = (a.x < 0 || (a.x == 0 && a.y < 0));
+
+		keys.push_back(std::make_pair(flip ? -a.y : a.y, i));
+	}
 
-		// Scale
-		pt -= t.GetPivot();
-		pt *= t.GetScale();
-		pt += t.GetPivot();
+	std::sort(std::begin(keys), std::end(keys));
 
-		// Rotate
-		const Precision_t radians = (t.GetRotation() * M_PI ) / 180;
-		const Precision_t s = std::sin(radians);
-		const Precision_t c = std::cos(radians);
+	auto parallel = [&axes](unsigned i, unsigned j)
+	{
+		return (std::abs(axes[i].Cross(axes[j])) <= PARALLEL_TOLERANCE);
+	};
 
-		Vector2 p = pt - t.GetPivot();
+	// Parallel axes are now neighbours, keep the earliest axis of each run
+	std::vector<bool, typename Traits::template rebind_alloc<bool>> keep(axes.size(), false, axes.get_allocator());
+	std::vector<unsigned, typename Traits::template rebind_alloc<unsigned>> runs(axes.get_allocator());
 
-		const Precision_t nx = (p.x * c) - (p.y * s);
-		const Precision_t ny = (p.x * s) + (p.y * c);
+	runs.push_back(keys[0].second);
 
-		p = Vector2(nx, ny) + t.GetPivot();
+	for (unsigned k = 1; k < keys.size(); k++)
+	{
+		const unsigned i = keys[k].second;
 
-		// Translate
-		p += t.GetTranslation();
+		if (parallel(keys[k - 1].second, i))
+			runs.back() = std::min(runs.back(), i);
 
-		SetPoint(i, p);
+		else
+			runs.push_back(i);
 	}
+
+	// Directions just either side of vertical meet at both ends of the order
+	if (runs.size() > 1 && parallel(keys.front().second, keys.back().second))
+	{
+		runs.front() = std::min(runs.front(), runs.back());
+		runs.pop_back();
+	}
+
+	for (auto && i : runs)
+		keep[i] = true;
+
+	unsigned n = 0;
+
+	for (unsigned i = 0; i < axes.size(); i++)
+	{
+		if (keep[i])
+			axes[n++] = axes[i];
+	}
+
+	axes.resize(n);
+}
+
+void ShapeImpl::RemoveParallelAxes(AxesVec &axes)
+{
+	RemoveParallel(axes);
+}
+
+void ShapeImpl::RemoveParallelAxes(ArenaVector<Axis> &axes)
+{
+	RemoveParallel(axes);
+}
+
+const bool ShapeImpl::Overlaps(const OrientedBox &b) const
+{
+	const Shape &s = *this;
+	return s.Overlaps(static_cast<const Polygon&>(b));
+}
+
+const bool ShapeImpl::Overlaps(const Box &b) const
+{
+	const Shape &s = *this;
+	return s.Overlaps(static_cast<const OrientedBox&>(b));
+}
+
+const Vector2 ShapeImpl::GetDisplacement(const OrientedBox &b) const
+{
+	const Shape &s = *this;
+	return s.GetDisplacement(static_cast<const Polygon&>(b));
+}
+
+const Vector2 ShapeImpl::GetDisplacement(const Box &b) const
+{
+	const Shape &s = *this;
+	return s.GetDisplacement(static_cast<const OrientedBox&>(b));
+}
+
+// Shapes that can separate in one pass override these, the rest pay for two
+template <typename Other>
+static const Vector2 OverlapThenSeparate(const Shape &self, const Other &o, bool &overlaps)
+{
+	overlaps = self.Overlaps(o);
+
+	if (!overlaps)
+		return Vector2(0, 0);
+
+	return self.GetDisplacement(o);
+}
+
+const Vector2 ShapeImpl::GetDisplacement(const Shape &s, bool &overlaps) const
+{
+	return OverlapThenSeparate(*this, s, overlaps);
+}
+
+const Vector2 ShapeImpl::GetDisplacement(const Segment &s, bool &overlaps) const
+{
+	return OverlapThenSeparate(*this, s, overlaps);
+}
+
+const Vector2 ShapeImpl::GetDisplacement(const Circle &c, bool &overlaps) const
+{
+	return OverlapThenSeparate(*this, c, overlaps);
+}
+
+const Vector2 ShapeImpl::GetDisplacement(const Polygon &p, bool &overlaps) const
+{
+	return OverlapThenSeparate(*this, p, overlaps);
+}
+
+const Vector2 ShapeImpl::GetDisplacement(const OrientedBox &b, bool &overlaps) const
+{
+	const Shape &s = *this;
+	return s.GetDisplacement(static_cast<const Polygon&>(b), overlaps);
+}
+
+const Vector2 ShapeImpl::GetDisplacement(const Box &b, bool &overlaps) const
+{
+	const Shape &s = *this;
+	return s.GetDisplacement(static_cast<const OrientedBox&>(b), overlaps);
+}
+
+const Vector2 ShapeImpl::GetDisplacement(const Capsule &c, bool &overlaps) const
+{
+	return OverlapThenSeparate(*this, c, overlaps);
+}
+
+const Collision ShapeImpl::GetCollision(const OrientedBox &b) const
+{
+	const Shape &s = *this;
+	return s.GetCollision(static_cast<const Polygon&>(b));
+}
+
+const Collision ShapeImpl::GetCollision(const Box &b) const
+{
+	const Shape &s = *this;
+	return s.GetCollision(static_cast<const OrientedBox&>(b));
+}
+
+// Copies the intersection points of a pair without a dedicated kernel into the caller's buffer
+template <typename T>
+static void CopyIntersects(const Shape &a, const T &b, ArenaVector<Vector2> &intersects)
+{
+	const std::vector<Vector2> points = a.GetIntersects(b);
+	intersects.assign(std::begin(points), std::end(points));
+}
+
+// Moves the intersection points of a collision without a dedicated kernel into the caller's buffer
+template <typename T>
+static const Collision CopyCollision(const Shape &a, const T &b, ArenaVector<Vector2> &intersects)
+{
+	const Collision c = a.GetCollision(b);
+	intersects.assign(std::begin(c.GetIntersects()), std::end(c.GetIntersects()));
+
+	return Collision(c.Overlaps(), std::vector<Vector2>(), c.AcontainsB(), c.BcontainsA(), c.GetOverlap(), c.GetDisplacement());
+}
+
+void ShapeImpl::GetIntersects(const Shape &s, ArenaVector<Vector2> &intersects) const
+{
+	CopyIntersects(*this, s, intersects);
+}
+
+void ShapeImpl::GetIntersects(const Segment &s, ArenaVector<Vector2> &intersects) const
+{
+	CopyIntersects(*this, s, intersects);
+}
+
+void ShapeImpl::GetIntersects(const Circle &c, ArenaVector<Vector2> &intersects) const
+{
+	CopyIntersects(*this, c, intersects);
+}
+
+void ShapeImpl::GetIntersects(const Polygon &p, ArenaVector<Vector2> &intersects) const
+{
+	CopyIntersects(*this, p, intersects);
+}
+
+void ShapeImpl::GetIntersects(const Capsule &c, ArenaVector<Vector2> &intersects) const
+{
+	CopyIntersects(*this, c, intersects);
+}
+
+const Collision ShapeImpl::GetCollision(const Shape &s, ArenaVector<Vector2> &intersects) const
+{
+	return CopyCollision(*this, s, intersects);
+}
+
+const Collision ShapeImpl::GetCollision(const Segment &s, ArenaVector<Vector2> &intersects) const
+{
+	return CopyCollision(*this, s, intersects);
+}
+
+const Collision ShapeImpl::GetCollision(const Circle &c, ArenaVector<Vector2> &intersects) const
+{
+	return CopyCollision(*this, c, intersects);
+}
+
+const Collision ShapeImpl::GetCollision(const Polygon &p, ArenaVector<Vector2> &intersects) const
+{
+	return CopyCollision(*this, p, intersects);
+}
+
+const Collision ShapeImpl::GetCollision(const Capsule &c, ArenaVector<Vector2> &intersects) const
+{
+	return CopyCollision(*this, c, intersects);
+}
+
+void ShapeImpl::Transform(const Transformation &t)
+{
+	AffineMatrix(t).TransformPoints(_points);
 }
 
 void ShapeImpl::ReCalc()
@@ -0,0 +1,155 @@
+#include <Crash2D/shape_pool.hpp>
+#include <Crash2D/box.hpp>
+#include <Crash2D/capsule.hpp>
+#include <Crash2D/circle.hpp>
+#include <Crash2D/segment.hpp>
+
+#include <atomic>
+
+namespace Crash2D
+{
+ShapePool::ShapePool(const unsigned slabSize) : _slabSize(slabSize == 0 ? 1 : slabSize), _count(0)
+{
+}
+
+ShapePool::~ShapePool()
+{
+	for (auto && s : _slots)
+	{
+		if (s.shape)
+			s.slab->Destroy(s.object);
+	}
+}
+
+const bool ShapePool::Clone(const Shape &s, PoolHandle &h)
+{
+	const std::type_info &type = typeid(s);
+
+	// The whole object, so the copy constructor can be reached without a cast per type
+	const void *object = dynamic_cast<const void*>(&s);
+
+	// Types already cloned are found by address, comparing type_info fully may compare names
+	for (auto && c : _cloners)
+	{
+		if (c.first == &type)
+		{
+			h = c.second(*this, object);
+			return true;
+		}
+	}
+
+	// Matched exactly, so a type derived from one of these is not sliced into its base
+	Cloner cloner = nullptr;
+
+	if (type == typeid(Box))
+		cloner = &CloneAs<Box>;
+
+	else if (type == typeid(OrientedBox))
+		cloner = &CloneAs<OrientedBox>;
+
+	else if (type == typeid(Polygon))
+		cloner = &CloneAs<Polygon>;
+
+	else if (type == typeid(Circle))
+		cloner = &CloneAs<Circle>;
+
+	else if (type == typeid(Capsule))
+		cloner = &CloneAs<Capsule>;
+
+	else if (type == typeid(Segment))
+		cloner = &CloneAs<Segment>;
+
+	else
+		return false;
+
+	_cloners.push_back(std::make_pair(&type, cloner));
+
+	h = cloner(*this, object);
+	return true;
+}
+
+void ShapePool::Destroy(const PoolHandle &h)
+{
+	if (!IsValid(h))
+		return;
+
+	Slot &s = _slots[h.index];
+
+	s.slab->Destroy(s.object);
+	s.shape = nullptr;
+	s.object = nullptr;
+	s.slab = nullptr;
+	s.generation++;
+
+	_free.push_back(h.index);
+	_count--;
+}
+
+const bool ShapePool::IsValid(const PoolHandle &h) const
+{
+	return (h.index < _slots.size() && _slots[h.index].shape && _slots[h.index].generation == h.generation);
+}
+
+Shape* ShapePool::Get(const PoolHandle &h) const
+{
+	return IsValid(h) ? _slots[h.index].shape : nullptr;
+}
+
+const unsigned ShapePool::GetCount() const
+{
+	return _count;
+}
+
+const size_t ShapePool::GetMemoryUsage() const
+{
+	size_t bytes = 0;
+
+	for (auto && s : _slabs)
+	{
+		if (s)
+			bytes += s->GetSize();
+	}
+
+	for (auto && s : _slots)
+	{
+		if (s.shape)
+			bytes += s.shape->GetMemoryUsage();
+	}
+
+	return bytes;
+}
+
+const unsigned ShapePool::NextType()
+{
+	static std::atomic<unsigned> next(0);
+
+	return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+PoolHandle ShapePool::Insert(Shape *s, void *object, SlabBase *slab)
+{
+	unsigned index;
+
+	if (_free.empty())
+	{
+		index = static_cast<unsigned>(_slots.size());
+		_slots.push_back(Slot{ nullptr, nullptr, nullptr, 0 });
+	}
+
+	else
+	{
+		index = _free.back();
+		_free.pop_back();
+	}
+
+	Slot &slot = _slots[index];
+
+	slot.shape = s;
+	slot.object = object;
+	slot.slab = slab;
+
+	_count++;
+
+	return PoolHandle{ index, slot.generation };
+}
+}
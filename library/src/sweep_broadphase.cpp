@@ -0,0 +1,208 @@
+#include <Crash2D/sweep_broadphase.hpp>
+#include <Crash2D/trace.hpp>
+
+#include <algorithm>
+
+namespace Crash2D
+{
+SweepBroadphase::SweepBroadphase() : _count(0), _stale(false)
+{
+}
+
+void SweepBroadphase::Insert(const unsigned id, const Bounds &b, const bool awake)
+{
+	if (id >= _bounds.size())
+	{
+		_bounds.resize(id + 1);
+		_active.resize(id + 1, 0);
+		_awake.resize(id + 1, 0);
+		_listed.resize(id + 1, 0);
+		_filters.resize(id + 1);
+	}
+
+	_bounds[id] = b;
+	_filters[id] = CollisionFilter();
+	_active[id] = 1;
+	_awake[id] = awake;
+	_count++;
+
+	List(id, awake);
+}
+
+void SweepBroadphase::Update(const unsigned id, const Bounds &b)
+{
+	_bounds[id] = b;
+}
+
+void SweepBroadphase::Remove(const unsigned id)
+{
+	_active[id] = 0;
+	_count--;
+	_stale = true;
+}
+
+void SweepBroadphase::Clear()
+{
+	_bounds.clear();
+	_active.clear();
+	_awake.clear();
+	_listed.clear();
+	_filters.clear();
+	_order.clear();
+	_sleeping.clear();
+	_count = 0;
+	_stale = false;
+}
+
+const bool SweepBroadphase::Contains(const unsigned id) const
+{
+	return (id < _active.size() && _active[id]);
+}
+
+const Bounds& SweepBroadphase::GetBounds(const unsigned id) const
+{
+	return _bounds[id];
+}
+
+void SweepBroadphase::SetAwake(const unsigned id, const bool awake)
+{
+	if (IsAwake(id) == awake)
+		return;
+
+	_awake[id] = awake;
+	_stale = true;
+
+	List(id, awake);
+}
+
+const bool SweepBroadphase::IsAwake(const unsigned id) const
+{
+	return _awake[id];
+}
+
+void SweepBroadphase::SetFilter(const unsigned id, const CollisionFilter &f)
+{
+	_filters[id] = f;
+}
+
+const CollisionFilter& SweepBroadphase::GetFilter(const unsigned id) const
+{
+	return _filters[id];
+}
+
+const unsigned SweepBroadphase::GetSize() const
+{
+	return _count;
+}
+
+void SweepBroadphase::List(const unsigned id, const bool awake)
+{
+	const unsigned char flag = awake ? LISTED_AWAKE : LISTED_SLEEPING;
+
+	// An entry left behind by an earlier removal or move is valid again
+	if (_listed[id] & flag)
+		return;
+
+	(awake ? _order : _sleeping).push_back(id);
+	_listed[id] |= flag;
+}
+
+void SweepBroadphase::Compact(TaggedVector<unsigned, MEMORY_BROADPHASE> &order, const bool awake)
+{
+	const unsigned char flag = awake ? LISTED_AWAKE : LISTED_SLEEPING;
+
+	order.erase(std::remove_if(order.begin(), order.end(), [this, awake, flag](const unsigned id)
+	{
+		if (_active[id] && static_cast<bool>(_awake[id]) == awake)
+			return false;
+
+		_listed[id] &= ~flag;
+		return true;
+	}), order.end());
+}
+
+void SweepBroadphase::Sort(TaggedVector<unsigned, MEMORY_BROADPHASE> &order)
+{
+	// Insertion sort, the order from the last call is usually almost right. Far from sorted,
+	// after bulk inserts or teleports, it gives up once the moves pass a few per proxy
+	const size_t budget = static_cast<size_t>(SWEEP_SORT_MOVES) * order.size();
+	size_t moves = 0;
+
+	for (unsigned i = 1; i < order.size(); i++)
+	{
+		const unsigned id = order[i];
+		unsigned j = i;
+
+		for (; j > 0 && Before(id, order[j - 1]); j--)
+			order[j] = order[j - 1];
+
+		order[j] = id;
+		moves += i - j;
+
+		if (moves > budget)
+		{
+			// Before() is a strict total order, so the result is the same either way
+			std::sort(order.begin(), order.end(), [this](const unsigned a, const unsigned b) { return Before(a, b); });
+			return;
+		}
+	}
+}
+
+void SweepBroadphase::FindPairs(std::vector<ProxyPair> &pairs)
+{
+	pairs.clear();
+
+	if (_stale)
+	{
+		Compact(_order, true);
+		Compact(_sleeping, false);
+		_stale = false;
+	}
+
+	{
+		CRASH2D_ZONE("Sweep sort");
+		Sort(_order);
+		Sort(_sleeping);
+	}
+
+	CRASH2D_ZONE("Sweep");
+
+	// Awake against awake
+	for (unsigned i = 0; i < _order.size(); i++)
+	{
+		const unsigned a = _order[i];
+		const Precision_t right = _bounds[a].max.x;
+
+		// Everything after j starts further right than a ends
+		for (unsigned j = i + 1; j < _order.size() && _bounds[_order[j]].min.x <= right; j++)
+			AddIfOverlapping(a, _order[j], pairs);
+	}
+
+	// Awake against sleeping, walking both lists in order and pairing each proxy
+	// with the ones in the other list that start before it ends
+	unsigned i = 0, j = 0;
+
+	while (i < _order.size() && j < _sleeping.size())
+	{
+		if (Before(_order[i], _sleeping[j]))
+		{
+			const unsigned a = _order[i++];
+			const Precision_t right = _bounds[a].max.x;
+
+			for (unsigned k = j; k < _sleeping.size() && _bounds[_sleeping[k]].min.x <= right; k++)
+				AddIfOverlapping(a, _sleeping[k], pairs);
+		}
+
+		else
+		{
+			const unsigned s = _sleeping[j++];
+			const Precision_t right = _bounds[s].max.x;
+
+			for (unsigned k = i; k < _order.size() && _bounds[_order[k]].min.x <= right; k++)
+				AddIfOverlapping(s, _order[k], pairs);
+		}
+	}
+
+	std::sort(pairs.begin(), pairs.end());
+}
+}
@@ -0,0 +1,135 @@
+#include <Crash2D/thread_pool.hpp>
+
+namespace Crash2D
+{
+ThreadPool::ThreadPool(const unsigned workers) : _task(nullptr), _pending(0), _batch(0), _stop(false)
+{
+	const unsigned n = (workers > 0) ? workers : 1;
+
+	for (unsigned i = 0; i < n; i++)
+		_queues.emplace_back(new Queue());
+
+	for (unsigned i = 1; i < n; i++)
+		_threads.emplace_back(&ThreadPool::WorkerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+
+	_wake.notify_all();
+
+	for (auto && t : _threads)
+		t.join();
+}
+
+const unsigned ThreadPool::GetWorkerCount() const
+{
+	return _queues.size();
+}
+
+void ThreadPool::Run(const unsigned count, const Task &task)
+{
+	if (count == 0)
+		return;
+
+	const unsigned workers = _queues.size();
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_task = &task;
+		_pending = count;
+
+		// One contiguous block per worker keeps neighbouring tasks on the same core
+		for (unsigned w = 0; w < workers; w++)
+		{
+			std::lock_guard<std::mutex> queueLock(_queues[w]->mutex);
+
+			for (unsigned i = count * w / workers; i < count * (w + 1) / workers; i++)
+				_queues[w]->tasks.push_back(i);
+		}
+
+		_batch++;
+	}
+
+	_wake.notify_all();
+
+	while (RunOne(0))
+		;
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	_done.wait(lock, [this] { return _pending == 0; });
+
+	_task = nullptr;
+}
+
+void ThreadPool::WorkerLoop(const unsigned worker)
+{
+	unsigned seen = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_wake.wait(lock, [&] { return _stop || _batch != seen; });
+
+			if (_stop)
+				return;
+
+			seen = _batch;
+		}
+
+		while (RunOne(worker))
+			;
+	}
+}
+
+const bool ThreadPool::RunOne(const unsigned worker)
+{
+	const unsigned workers = _queues.size();
+
+	unsigned task = 0;
+	bool found = false;
+
+	// Own queue from the front, then steal from the back of the others
+	for (unsigned i = 0; i < workers && !found; i++)
+	{
+		Queue &q = *_queues[(worker + i) % workers];
+		std::lock_guard<std::mutex> lock(q.mutex);
+
+		if (q.tasks.empty())
+			continue;
+
+		if (i == 0)
+		{
+			task = q.tasks.front();
+			q.tasks.pop_front();
+		}
+
+		else
+		{
+			task = q.tasks.back();
+			q.tasks.pop_back();
+		}
+
+		found = true;
+	}
+
+	if (!found)
+		return false;
+
+	(*_task)(task, worker);
+
+	if (--_pending == 0)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_done.notify_all();
+	}
+
+	return true;
+}
+}
@@ -0,0 +1,200 @@
+#include <Crash2D/trace.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Crash2D
+{
+#ifdef CRASH2D_TRACE
+
+// The spans of one thread, written only by that thread
+struct TraceBuffer
+{
+	std::unique_ptr<TraceEvent[]> events;
+	std::atomic<uint64_t> written;
+	unsigned thread;
+
+	TraceBuffer();
+	~TraceBuffer();
+
+	inline void Record(const TraceEvent &e)
+	{
+		const uint64_t n = written.load(std::memory_order_relaxed);
+		events[n % TRACE_CAPACITY] = e;
+
+		// Publishes the span to a reader that loads the count with acquire
+		written.store(n + 1, std::memory_order_release);
+	}
+};
+
+// Every live buffer, plus the spans of threads that have exited
+struct TraceRegistry
+{
+	std::mutex mutex;
+	std::vector<TraceBuffer*> buffers;
+	std::vector<std::pair<unsigned, TraceEvent>> retired;
+	unsigned threads = 0;
+	std::atomic<bool> queries;
+	const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+	TraceRegistry() : queries(false) {}
+};
+
+// Never destroyed, threads may still exit after static destructors have run
+static TraceRegistry& GetRegistry()
+{
+	static TraceRegistry *registry = new TraceRegistry();
+	return *registry;
+}
+
+static thread_local TraceBuffer threadTrace;
+
+static const uint64_t Now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - GetRegistry().epoch).count();
+}
+
+// Appends the spans still held by a buffer, oldest first
+static void Collect(const TraceBuffer &b, std::vector<std::pair<unsigned, TraceEvent>> &out)
+{
+	const uint64_t written = b.written.load(std::memory_order_acquire);
+	const uint64_t first = (written > TRACE_CAPACITY) ? written - TRACE_CAPACITY : 0;
+
+	for (uint64_t i = first; i < written; i++)
+		out.push_back(std::make_pair(b.thread, b.events[i % TRACE_CAPACITY]));
+}
+
+// Chrome traces count in microseconds, the nanoseconds are kept as three decimals
+static void WriteMicroseconds(std::ostream &out, const uint64_t ns)
+{
+	const unsigned fraction = ns % 1000;
+
+	out << ns / 1000 << '.' << fraction / 100 << (fraction / 10) % 10 << fraction % 10;
+}
+
+TraceBuffer::TraceBuffer() : events(new TraceEvent[TRACE_CAPACITY]), written(0)
+{
+	TraceRegistry &r = GetRegistry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+
+	thread = ++r.threads;
+	r.buffers.push_back(this);
+}
+
+TraceBuffer::~TraceBuffer()
+{
+	TraceRegistry &r = GetRegistry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+
+	Collect(*this, r.retired);
+	r.buffers.erase(std::find(r.buffers.begin(), r.buffers.end(), this));
+}
+
+TraceZone::TraceZone(const char *name, const bool enabled) : _name(enabled ? name : nullptr), _start(enabled ? Now() : 0)
+{
+}
+
+TraceZone::~TraceZone()
+{
+	if (_name)
+		threadTrace.Record({ _name, _start, Now() - _start });
+}
+
+const bool TracingEnabled()
+{
+	return true;
+}
+
+void SetQueryTracing(const bool enabled)
+{
+	GetRegistry().queries.store(enabled, std::memory_order_relaxed);
+}
+
+const bool GetQueryTracing()
+{
+	return GetRegistry().queries.load(std::memory_order_relaxed);
+}
+
+void WriteTrace(std::ostream &out)
+{
+	TraceRegistry &r = GetRegistry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+
+	std::vector<std::pair<unsigned, TraceEvent>> events = r.retired;
+
+	for (auto && b : r.buffers)
+		Collect(*b, events);
+
+	out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+	bool first = true;
+
+	for (unsigned t = 1; t <= r.threads; t++)
+	{
+		out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << t
+			<< ",\"args\":{\"name\":\"Crash2D thread " << t << "\"}}";
+		first = false;
+	}
+
+	for (auto && e : events)
+	{
+		out << ",\n{\"name\":\"" << e.second.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.first << ",\"ts\":";
+		WriteMicroseconds(out, e.second.start);
+		out << ",\"dur\":";
+		WriteMicroseconds(out, e.second.duration);
+		out << "}";
+	}
+
+	out << "\n]}\n";
+}
+
+void ClearTrace()
+{
+	TraceRegistry &r = GetRegistry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+
+	r.retired.clear();
+
+	for (auto && b : r.buffers)
+		b->written.store(0, std::memory_order_relaxed);
+}
+
+#else
+
+TraceZone::TraceZone(const char *name, const bool enabled) : _name(nullptr), _start(0)
+{
+}
+
+TraceZone::~TraceZone()
+{
+}
+
+const bool TracingEnabled()
+{
+	return false;
+}
+
+void SetQueryTracing(const bool enabled)
+{
+}
+
+const bool GetQueryTracing()
+{
+	return false;
+}
+
+void WriteTrace(std::ostream &out)
+{
+	out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n]}\n";
+}
+
+void ClearTrace()
+{
+}
+
+#endif
+}
@@ -3,6 +3,23 @@
 #include <cmath>
 #include <iostream>
 
+#if defined(CRASH2D_FAST_MATH) && defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+// Deterministic builds need every float operation to round the same way on every run and machine
+#if defined(CRASH2D_DETERMINISTIC)
+#if defined(CRASH2D_FAST_MATH)
+#error "CRASH2D_FAST_MATH uses a hardware estimate that differs between CPUs and cannot be combined with CRASH2D_DETERMINISTIC"
+#endif
+#if defined(__FAST_MATH__)
+#error "-ffast-math lets the compiler reorder float operations and cannot be combined with CRASH2D_DETERMINISTIC"
+#endif
+#if defined(__i386__) && !defined(__SSE2_MATH__)
+#error "x87 arithmetic keeps excess precision, build with -msse2 -mfpmath=sse for CRASH2D_DETERMINISTIC"
+#endif
+#endif
+
 namespace Crash2D
 {
 const Vector2 Vector2::Perpendicular() const
@@ -32,7 +49,7 @@ const Precision_t Vector2::Length() const
 
 const Vector2 Vector2::Normalize() const
 {
-	return *this / Length();
+	return *this * InverseSqrt(LengthSq());
 }
 
 const Precision_t Vector2::GetDistance(const Vector2 &v) const
@@ -43,7 +60,19 @@ const Precision_t Vector2::GetDistance(const Vector2 &v) const
 
 bool AreEqual(Precision_t a, Precision_t b)
 {
-	//change 0.1 to real precision
-	return (a == b || std::fabs(a - b) <= 0.1);
+	//change CMP_TOLERANCE to real precision
+	return (a == b || std::fabs(a - b) <= CMP_TOLERANCE);
+}
+
+Precision_t InverseSqrt(Precision_t v)
+{
+#if defined(CRASH2D_FAST_MATH) && defined(__SSE__)
+	const Precision_t y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(v)));
+
+	// One Newton-Raphson step takes the 12 bit estimate to nearly full precision
+	return y * (1.5f - 0.5f * v * y * y);
+#else
+	return 1 / std::sqrt(v);
+#endif
 }
 }
@@ -4,6 +4,9 @@
 #include <Crash2D/circle.hpp>
 #include <Crash2D/polygon.hpp>
 #include <Crash2D/segment.hpp>
+#include <Crash2D/oriented_box.hpp>
+#include <Crash2D/box.hpp>
+#include <Crash2D/capsule.hpp>
 #include <Crash2D/projection.hpp>
 #include <Crash2D/collision.hpp>
 #include <Crash2D/transformation.hpp>
@@ -22,6 +25,7 @@ const double ULP = 0.0001;
 Segment mSegment(Segment s, Vector2 displacement);
 Circle mCircle(Circle c, Vector2 displacement);
 Polygon mPolygon(Polygon p, Vector2 displacement);
+Capsule mCapsule(Capsule c, Vector2 displacement);
 
 bool vectorContains(std::vector<Vector2> &coords, Vector2 pt);
 bool vectorEQ(std::vector<Vector2> &a, std::vector<Vector2> &b);
@@ -0,0 +1,133 @@
+#include "helper.hpp"
+
+#include <Crash2D/affine_matrix.hpp>
+
+// The per-point math Shape::Transform used before matrices
+static Vector2 TransformScalar(const Transformation &t, Vector2 pt)
+{
+	pt -= t.GetPivot();
+	pt *= t.GetScale();
+
+	const Precision_t radians = (t.GetRotation() * 3.14159265359) / 180;
+	const Precision_t s = std::sin(radians);
+	const Precision_t c = std::cos(radians);
+
+	const Vector2 p((pt.x * c) - (pt.y * s), (pt.x * s) + (pt.y * c));
+
+	return p + t.GetPivot() + t.GetTranslation();
+}
+
+static Transformation MakeTransformation(const Vector2 &s, const Precision_t r, const Vector2 &t, const Vector2 &pivot)
+{
+	Transformation tr(s, r, t);
+	tr.SetPivot(pivot);
+
+	return tr;
+}
+
+TEST(AffineMatrix, DefaultConstructor)
+{
+	AffineMatrix m;
+	const Vector2 p = m.TransformPoint(Vector2(3, -4));
+
+	ARE_EQ(3, p.x);
+	ARE_EQ(-4, p.y);
+	ARE_EQ(1, m.GetDeterminant());
+}
+
+TEST(AffineMatrix, ConstructFromTransformation)
+{
+	const Transformation t = MakeTransformation(Vector2(2, 3), 30, Vector2(5, -7), Vector2(10, 10));
+	const AffineMatrix m(t);
+
+	const Vector2 points[3] = { Vector2(0, 0), Vector2(10, 10), Vector2(-4, 25) };
+
+	for (auto && p : points)
+	{
+		const Vector2 expected = TransformScalar(t, p);
+		const Vector2 actual = m.TransformPoint(p);
+
+		ARE_EQ(expected.x, actual.x);
+		ARE_EQ(expected.y, actual.y);
+	}
+
+	ARE_EQ(6, m.GetDeterminant());
+}
+
+TEST(AffineMatrix, Compose)
+{
+	const Transformation t1 = MakeTransformation(Vector2(2, 2), 45, Vector2(1, 2), Vector2(0, 0));
+	const Transformation t2 = MakeTransformation(Vector2(1, 0.5), 300, Vector2(-3, 8), Vector2(4, -2));
+	const Transformation t3 = MakeTransformation(Vector2(1, 1), 90, Vector2(0, 0), Vector2(1, 1));
+
+	// Child first, then each parent
+	const AffineMatrix m = AffineMatrix(t3).Compose(AffineMatrix(t2)).Compose(AffineMatrix(t1));
+	const AffineMatrix op = AffineMatrix(t3) * AffineMatrix(t2) * AffineMatrix(t1);
+
+	const Vector2 p(7, -3);
+	const Vector2 expected = TransformScalar(t3, TransformScalar(t2, TransformScalar(t1, p)));
+
+	ARE_EQ(expected.x, m.TransformPoint(p).x);
+	ARE_EQ(expected.y, m.TransformPoint(p).y);
+	ARE_EQ(expected.x, op.TransformPoint(p).x);
+	ARE_EQ(expected.y, op.TransformPoint(p).y);
+}
+
+TEST(AffineMatrix, Inverse)
+{
+	const AffineMatrix m(MakeTransformation(Vector2(2, 4), 120, Vector2(6, -1), Vector2(3, 3)));
+	const AffineMatrix i = m.Inverse();
+
+	const Vector2 p(12, -5);
+	const Vector2 q = i.TransformPoint(m.TransformPoint(p));
+
+	ARE_EQ(p.x, q.x);
+	ARE_EQ(p.y, q.y);
+
+	const AffineMatrix identity = m.Compose(i);
+	ARE_EQ(1, identity.a);
+	ARE_EQ(0, identity.b);
+	ARE_EQ(0, identity.c);
+	ARE_EQ(1, identity.d);
+	ARE_EQ(0, identity.tx);
+	ARE_EQ(0, identity.ty);
+}
+
+TEST(AffineMatrix, InverseSingular)
+{
+	const AffineMatrix m(2, 4, 1, 2, 5, 5);
+	const AffineMatrix i = m.Inverse();
+
+	ARE_EQ(0, i.a);
+	ARE_EQ(0, i.d);
+	ARE_EQ(0, i.tx);
+}
+
+TEST(AffineMatrix, TransformPoints)
+{
+	const AffineMatrix m(MakeTransformation(Vector2(1.5, 2), 75, Vector2(-2, 9), Vector2(1, 0)));
+
+	for (unsigned n = 0; n <= 9; n++)
+	{
+		std::vector<Vector2> points;
+
+		for (unsigned i = 0; i < n; i++)
+			points.push_back(Vector2(std::cos(i * 1.3f) * 10, std::sin(i * 0.7f) * 20));
+
+		std::vector<Vector2> out(n);
+		m.TransformPoints(points.data(), out.data(), n);
+
+		std::vector<Vector2> inPlace = points;
+		m.TransformPoints(inPlace);
+
+		for (unsigned i = 0; i < n; i++)
+		{
+			const Vector2 expected = m.TransformPoint(points[i]);
+
+			EXPECT_EQ(expected.x, out[i].x);
+			EXPECT_EQ(expected.y, out[i].y);
+			EXPECT_EQ(expected.x, inPlace[i].x);
+			EXPECT_EQ(expected.y, inPlace[i].y);
+		}
+	}
+}
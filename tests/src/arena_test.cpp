@@ -0,0 +1,234 @@
+#include "helper.hpp"
+
+#include <Crash2D/arena.hpp>
+#include <Crash2D/SparseSpatialBroadphase.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// Counts every heap allocation made by the test binary, so arena paths can be checked to make none
+static std::atomic<size_t> heapAllocations(0);
+
+void* operator new(size_t size)
+{
+	void *p = std::malloc(size ? size : 1);
+
+	if (!p)
+		throw std::bad_alloc();
+
+	heapAllocations.fetch_add(1, std::memory_order_relaxed);
+	return p;
+}
+
+// GCC cannot see that the replaced operator new above uses malloc
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	std::free(p);
+}
+
+static Polygon Regular(const unsigned n, const Vector2 &c, const Precision_t r)
+{
+	Polygon p;
+	p.SetPointCount(n);
+
+	for (unsigned i = 0; i < n; i++)
+		p.SetPoint(i, c + Vector2(std::cos(i * 6.2831853f / n), std::sin(i * 6.2831853f / n)) * r);
+
+	p.ReCalc();
+	return p;
+}
+
+static void ExpectSameCollision(const Collision &heap, const Collision &arena, const ArenaVector<Vector2> &intersects)
+{
+	EXPECT_EQ(heap.Overlaps(), arena.Overlaps());
+	EXPECT_EQ(heap.AcontainsB(), arena.AcontainsB());
+	EXPECT_EQ(heap.BcontainsA(), arena.BcontainsA());
+	EXPECT_EQ(heap.GetDisplacement(), arena.GetDisplacement());
+	EXPECT_TRUE(arena.GetIntersects().empty());
+
+	if (heap.Overlaps())
+	{
+		ARE_EQ(heap.GetOverlap(), arena.GetOverlap());
+	}
+
+	ASSERT_EQ(heap.GetIntersects().size(), intersects.size());
+
+	for (unsigned i = 0; i < intersects.size(); i++)
+		EXPECT_EQ(heap.GetIntersects()[i], intersects[i]);
+}
+
+TEST(Arena, Allocate)
+{
+	FrameArena arena(256);
+
+	char *a = static_cast<char*>(arena.Allocate(3, 1));
+	double *b = static_cast<double*>(arena.Allocate(sizeof(double), alignof(double)));
+
+	EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(b) % alignof(double));
+	EXPECT_EQ(a + 8, reinterpret_cast<char*>(b));
+	ARE_EQ(16, arena.GetUsed());
+	ARE_EQ(256, arena.GetCapacity());
+
+	// Too large for a block, so it gets one of its own
+	arena.Allocate(1000, 1);
+	ARE_EQ(256 + 1000, arena.GetCapacity());
+
+	// The same memory is handed out again after a reset
+	arena.Reset();
+	ARE_EQ(0, arena.GetUsed());
+	EXPECT_EQ(a, arena.Allocate(3, 1));
+	ARE_EQ(256 + 1000, arena.GetCapacity());
+}
+
+TEST(Arena, Vector)
+{
+	FrameArena arena(1024);
+	ArenaVector<int> v{ ArenaAllocator<int>(arena) };
+
+	for (int i = 0; i < 100; i++)
+		v.push_back(i);
+
+	ARE_EQ(99, v.back());
+	EXPECT_GE(arena.GetUsed(), 100 * sizeof(int));
+}
+
+TEST(Arena, CollisionPairs)
+{
+	SparseSpatialBroadphase broadphase(10, 10);
+	int objects[4];
+
+	broadphase.addRectangle(0, 0, 15, 15, &objects[0]);
+	broadphase.addRectangle(5, 5, 15, 15, &objects[1]);
+	broadphase.addRectangle(12, 12, 5, 5, &objects[2]);
+	broadphase.addRectangle(50, 50, 5, 5, &objects[3]);
+
+	const auto heap = broadphase.getCollisionPairs();
+
+	FrameArena arena;
+	uint64_t allocations = 0;
+
+	for (unsigned frame = 0; frame < 3; frame++)
+	{
+		arena.Reset();
+
+		{
+			const auto pairs = broadphase.getCollisionPairs(arena);
+
+			ARE_EQ(heap.size(), pairs.size());
+
+			for (auto && p : heap)
+				EXPECT_EQ(1u, pairs.count(p));
+		}
+
+		// Only the first frame grows the arena
+		const uint64_t now = GetMemoryStats().allocations[MEMORY_ARENAS];
+
+		if (frame > 0)
+		{
+			ARE_EQ(allocations, now);
+		}
+
+		allocations = now;
+	}
+}
+
+TEST(Arena, GetCollision)
+{
+	const Circle circle(Vector2(0, 0), 10);
+	const Segment segment(Vector2(-20, 5), Vector2(20, 5));
+	const Capsule capsule(Vector2(0, -20), Vector2(0, 20), 3);
+	const Polygon square = Regular(4, Vector2(8, 0), 8);
+	const Polygon round = Regular(12, Vector2(4, 4), 9);
+	const Box box(Vector2(-6, -6), Vector2(6, 6));
+
+	const std::vector<const Shape*> shapes = { &circle, &segment, &capsule, &square, &round, &box };
+
+	FrameArena arena;
+	ArenaVector<Vector2> intersects{ ArenaAllocator<Vector2>(arena) };
+
+	// Every pair matches the heap results, whether it has its own kernel or is copied
+	for (auto && a : shapes)
+	{
+		for (auto && b : shapes)
+		{
+			// A shape meets itself everywhere, which has no intersection points to compare
+			if (a == b)
+				continue;
+
+			const Collision arenaCollision = a->GetCollision(*b, intersects);
+			ExpectSameCollision(a->GetCollision(*b), arenaCollision, intersects);
+
+			a->GetIntersects(*b, intersects);
+			const std::vector<Vector2> heap = a->GetIntersects(*b);
+
+			ASSERT_EQ(heap.size(), intersects.size());
+
+			for (unsigned i = 0; i < heap.size(); i++)
+				EXPECT_EQ(heap[i], intersects[i]);
+		}
+	}
+}
+
+TEST(Arena, GetCollisionNoHeap)
+{
+	const Circle c1(Vector2(0, 0), 10);
+	const Circle c2(Vector2(15, 0), 10);
+	const Circle c3(Vector2(100, 0), 10);
+	const Polygon p1 = Regular(4, Vector2(0, 0), 10);
+	const Polygon p2 = Regular(4, Vector2(12, 3), 10);
+	const Polygon p3 = Regular(16, Vector2(0, 0), 10);
+	const Polygon p4 = Regular(16, Vector2(8, 2), 10);
+	const Polygon p5 = Regular(16, Vector2(100, 0), 10);
+
+	const std::vector<std::pair<const Shape*, const Shape*>> pairs =
+	{
+		{ &c1, &c2 }, { &c1, &c3 }, { &p1, &p2 }, { &p3, &p4 }, { &p3, &p5 }, { &p4, &p1 }
+	};
+
+	FrameArena arena;
+	size_t points = 0;
+
+	for (unsigned frame = 0; frame < 3; frame++)
+	{
+		arena.Reset();
+
+		const size_t before = heapAllocations.load();
+
+		{
+			ArenaVector<Vector2> intersects{ ArenaAllocator<Vector2>(arena) };
+			points = 0;
+
+			for (auto && pr : pairs)
+			{
+				const Collision c = pr.first->GetCollision(*pr.second, intersects);
+				points += intersects.size();
+			}
+		}
+
+		// Only the first frame grows the arena
+		if (frame > 0)
+		{
+			EXPECT_EQ(before, heapAllocations.load());
+		}
+	}
+
+	EXPECT_GT(points, 0u);
+
+	// The same query returning its points on the heap is seen by the count
+	const size_t before = heapAllocations.load();
+	const Collision heap = p3.GetCollision(p4);
+
+	EXPECT_LT(before, heapAllocations.load());
+}
@@ -0,0 +1,34 @@
+#include "helper.hpp"
+
+#include <Crash2D/bounds.hpp>
+
+TEST(Bounds, ConstructFromShape)
+{
+	const Bounds c(Circle(Vector2(10, -5), 3));
+	ARE_EQ(7, c.min.x);
+	ARE_EQ(-8, c.min.y);
+	ARE_EQ(13, c.max.x);
+	ARE_EQ(-2, c.max.y);
+
+	const Bounds b(OrientedBox(Vector2(0, 0), Vector2(10, 10), 45));
+	ARE_EQ(-10 * std::sqrt(2), b.min.x);
+	ARE_EQ(10 * std::sqrt(2), b.max.y);
+}
+
+TEST(Bounds, Overlaps)
+{
+	const Bounds a(Vector2(0, 0), Vector2(10, 10));
+
+	EXPECT_TRUE(a.Overlaps(Bounds(Vector2(5, 5), Vector2(15, 15))));
+	EXPECT_TRUE(a.Overlaps(Bounds(Vector2(10, 0), Vector2(20, 10))));
+	EXPECT_FALSE(a.Overlaps(Bounds(Vector2(11, 0), Vector2(20, 10))));
+	EXPECT_FALSE(a.Overlaps(Bounds(Vector2(0, -5), Vector2(10, -1))));
+}
+
+TEST(Bounds, Contains)
+{
+	const Bounds a(Vector2(0, 0), Vector2(10, 10));
+
+	EXPECT_TRUE(a.Contains(Bounds(Vector2(2, 2), Vector2(8, 8))));
+	EXPECT_FALSE(a.Contains(Bounds(Vector2(2, 2), Vector2(12, 8))));
+}
@@ -0,0 +1,246 @@
+#include "helper.hpp"
+
+TEST(Box, DefaultConstructor)
+{
+	Box b;
+
+	ARE_EQ(4, b.GetPointCount());
+	ARE_EQ(0, b.GetHalfExtents().x);
+	ARE_EQ(0, b.GetHalfExtents().y);
+	ARE_EQ(0, b.GetCenter().x);
+	ARE_EQ(0, b.GetCenter().y);
+}
+
+TEST(Box, ConstructorExtents)
+{
+	Box b(Vector2(10, 20), Vector2(5, 8));
+
+	ARE_EQ(10, b.GetCenter().x);
+	ARE_EQ(20, b.GetCenter().y);
+
+	ARE_EQ(5, b.GetPoint(0).x);
+	ARE_EQ(12, b.GetPoint(0).y);
+
+	ARE_EQ(15, b.GetPoint(2).x);
+	ARE_EQ(28, b.GetPoint(2).y);
+
+	ARE_EQ(2, b.GetAxes().size());
+	ARE_EQ(4, b.GetSides().size());
+}
+
+TEST(Box, ReCalc)
+{
+	Box b;
+	b.SetPoint(0, Vector2(-10, 40));
+	b.SetPoint(1, Vector2(30, 40));
+	b.SetPoint(2, Vector2(30, 0));
+	b.SetPoint(3, Vector2(-10, 0));
+	b.ReCalc();
+
+	ARE_EQ(10, b.GetCenter().x);
+	ARE_EQ(20, b.GetCenter().y);
+	ARE_EQ(20, b.GetHalfExtents().x);
+	ARE_EQ(20, b.GetHalfExtents().y);
+}
+
+TEST(Box, Project)
+{
+	Box b(Vector2(0, 0), Vector2(50, 25));
+	Polygon p = mPolygon(b, Vector2(0, 0));
+
+	const Axis axes[3] = { Axis(1, 0), Axis(0, 1), Axis(1, 1).Normalize() };
+
+	for (auto && a : axes)
+	{
+		Projection pB = b.Project(a);
+		Projection pP = p.Project(a);
+
+		ARE_EQ(pP.min, pB.min);
+		ARE_EQ(pP.max, pB.max);
+	}
+}
+
+TEST(Box, ContainsPoint)
+{
+	Box b(Vector2(0, 0), Vector2(50, 25));
+
+	EXPECT_TRUE(b.Contains(Vector2(49, 24)));
+	EXPECT_FALSE(b.Contains(Vector2(0, 26)));
+}
+
+TEST(Box, ContainsCircle)
+{
+	Box b(Vector2(0, 0), Vector2(50, 50));
+
+	EXPECT_TRUE(b.Contains(Circle(Vector2(0, 0), 50)));
+	EXPECT_FALSE(b.Contains(Circle(Vector2(1, 0), 50)));
+}
+
+TEST(Box, OverlapsBox)
+{
+	Box a(Vector2(0, 0), Vector2(50, 50));
+	Polygon pA = mPolygon(a, Vector2(0, 0));
+
+	const Vector2 offsets[4] = { Vector2(25, 0), Vector2(99, 99), Vector2(100, 0), Vector2(0, 101) };
+
+	for (auto && o : offsets)
+	{
+		Box b(o, Vector2(50, 50));
+		Polygon pB = mPolygon(b, Vector2(0, 0));
+
+		EXPECT_EQ(pA.Overlaps(pB), a.Overlaps(b));
+	}
+}
+
+TEST(Box, OverlapsCircle)
+{
+	Box b(Vector2(0, 0), Vector2(50, 50));
+
+	EXPECT_TRUE(b.Overlaps(Circle(Vector2(0, 0), 10)));
+	EXPECT_TRUE(b.Overlaps(Circle(Vector2(70, 0), 25)));
+	EXPECT_TRUE(b.Overlaps(Circle(Vector2(60, 60), 15)));
+	EXPECT_FALSE(b.Overlaps(Circle(Vector2(60, 60), 14)));
+	EXPECT_FALSE(b.Overlaps(Circle(Vector2(80, 0), 25)));
+}
+
+TEST(Box, GetDisplacementBox)
+{
+	Box a(Vector2(0, 0), Vector2(50, 50));
+	Polygon pA = mPolygon(a, Vector2(0, 0));
+
+	Box b(Vector2(25, 0), Vector2(50, 50));
+	Polygon pB = mPolygon(b, Vector2(0, 0));
+
+	auto d = a.GetDisplacement(b);
+	auto dP = pA.GetDisplacement(pB);
+
+	ARE_EQ(75, d.Length());
+	ARE_EQ(dP.x, d.x);
+	ARE_EQ(dP.y, d.y);
+	EXPECT_FALSE(pA.Overlaps(mPolygon(pB, d)));
+
+	Box c(Vector2(101, 0), Vector2(50, 50));
+	d = a.GetDisplacement(c);
+	ARE_EQ(0, d.Length());
+}
+
+TEST(Box, GetDisplacementCircle)
+{
+	Box b(Vector2(0, 0), Vector2(50, 50));
+	Polygon p = mPolygon(b, Vector2(0, 0));
+
+	const Circle circles[3] = { Circle(Vector2(0, 0), 50), Circle(Vector2(25, 0), 50), Circle(Vector2(60, 60), 20) };
+
+	for (auto && c : circles)
+	{
+		auto d = b.GetDisplacement(c);
+		auto dP = p.GetDisplacement(c);
+
+		ARE_EQ(dP.Length(), d.Length());
+		EXPECT_FALSE(b.Overlaps(mCircle(c, d)));
+	}
+
+	auto d = b.GetDisplacement(Circle(Vector2(100, 0), 50));
+	ARE_EQ(0, d.Length());
+}
+
+TEST(Box, GetCollisionBox)
+{
+	Box a(Vector2(0, 0), Vector2(50, 50));
+	Box b(Vector2(25, 0), Vector2(50, 50));
+
+	Collision col = a.GetCollision(b);
+	ARE_EQ(a.Overlaps(b), col.Overlaps());
+	ARE_EQ(a.Contains(b), col.AcontainsB());
+	ARE_EQ(b.Contains(a), col.BcontainsA());
+
+	auto iC = col.GetIntersects();
+	auto iF = a.GetIntersects(b);
+
+	EXPECT_TRUE(vectorEQ(iC, iF));
+
+	auto dC = col.GetDisplacement();
+	auto dF = a.GetDisplacement(b);
+
+	ARE_EQ(dC.x, dF.x);
+	ARE_EQ(dC.y, dF.y);
+
+	Box c(Vector2(10, 10), Vector2(10, 10));
+	col = a.GetCollision(c);
+	EXPECT_TRUE(col.AcontainsB());
+	EXPECT_FALSE(col.BcontainsA());
+}
+
+TEST(Box, Transform)
+{
+	Box b(Vector2(10, 10), Vector2(5, 5));
+
+	Transformation t;
+	t.SetScale(Vector2(2, 2));
+	t.SetPivot(Vector2(10, 10));
+	t.Translate(Vector2(5, -5));
+	b.Transform(t);
+
+	ARE_EQ(15, b.GetCenter().x);
+	ARE_EQ(5, b.GetCenter().y);
+	ARE_EQ(10, b.GetHalfExtents().x);
+	ARE_EQ(10, b.GetHalfExtents().y);
+	ARE_EQ(5, b.GetPoint(0).x);
+	ARE_EQ(-5, b.GetPoint(0).y);
+}
+
+// Double Disbatch tests
+
+TEST(Box, OverlapsShape)
+{
+	ShapePtr aP(new Box(Vector2(0, 0), Vector2(50, 50)));
+	ShapePtr bP(new Box(Vector2(25, 25), Vector2(50, 50)));
+	ShapePtr cP(new Circle(Vector2(60, 60), 20));
+
+	Box aO = *dynamic_cast<Box*>(aP.get());
+	Box bO = *dynamic_cast<Box*>(bP.get());
+
+	EXPECT_EQ(aP->Overlaps(*bP), aO.Overlaps(bO));
+	EXPECT_TRUE(aP->Overlaps(*bP));
+	EXPECT_TRUE(aP->Overlaps(*cP));
+	EXPECT_TRUE(cP->Overlaps(*aP));
+}
+
+TEST(Box, GetDisplacementShape)
+{
+	ShapePtr aP(new Box(Vector2(0, 0), Vector2(50, 50)));
+	ShapePtr bP(new Box(Vector2(25, 0), Vector2(50, 50)));
+	ShapePtr cP(new Circle(Vector2(25, 0), 50));
+
+	Box aO = *dynamic_cast<Box*>(aP.get());
+	Box bO = *dynamic_cast<Box*>(bP.get());
+	Circle cO = *dynamic_cast<Circle*>(cP.get());
+
+	EXPECT_EQ(aP->GetDisplacement(*bP), aO.GetDisplacement(bO));
+	EXPECT_EQ(aP->GetDisplacement(*cP), aO.GetDisplacement(cO));
+	EXPECT_EQ(cP->GetDisplacement(*aP), -aO.GetDisplacement(cO));
+}
+
+TEST(Box, GetGollisionShape)
+{
+	ShapePtr aP(new Box(Vector2(0, 0), Vector2(50, 50)));
+	ShapePtr bP(new Polygon(mPolygon(Box(Vector2(25, 0), Vector2(50, 50)), Vector2(0, 0))));
+
+	Box aO = *dynamic_cast<Box*>(aP.get());
+	Polygon bO = *dynamic_cast<Polygon*>(bP.get());
+
+	Collision colPtr = aP->GetCollision(*bP);
+	Collision colObj = aO.GetCollision(bO);
+
+	ARE_EQ(colPtr.Overlaps(), colObj.Overlaps());
+	ARE_EQ(colPtr.AcontainsB(), colObj.AcontainsB());
+	ARE_EQ(colPtr.BcontainsA(), colObj.BcontainsA());
+
+	auto iP = colPtr.GetIntersects();
+	auto iO = colObj.GetIntersects();
+
+	EXPECT_TRUE(vectorEQ(iP, iO));
+
+	ARE_EQ(colPtr.GetDisplacement().x, colObj.GetDisplacement().x);
+	ARE_EQ(colPtr.GetDisplacement().y, colObj.GetDisplacement().y);
+}
@@ -0,0 +1,268 @@
+#include "helper.hpp"
+
+TEST(Capsule, DefaultConstructor)
+{
+	Capsule c;
+
+	ARE_EQ(2, c.GetPointCount());
+	ARE_EQ(0, c.GetRadius());
+	ARE_EQ(0, c.GetCenter().x);
+	ARE_EQ(0, c.GetCenter().y);
+}
+
+TEST(Capsule, Constructor)
+{
+	Capsule c(Vector2(0, 0), Vector2(100, 0), 10);
+
+	ARE_EQ(10, c.GetRadius());
+	ARE_EQ(50, c.GetCenter().x);
+	ARE_EQ(0, c.GetCenter().y);
+	ARE_EQ(0, c.GetAxis().x);
+	ARE_EQ(1, std::abs(c.GetAxis().y));
+}
+
+TEST(Capsule, Project)
+{
+	Capsule c(Vector2(0, 0), Vector2(100, 0), 10);
+
+	Projection p = c.Project(Axis(1, 0));
+	ARE_EQ(-10, p.min);
+	ARE_EQ(110, p.max);
+
+	p = c.Project(Axis(0, 1));
+	ARE_EQ(-10, p.min);
+	ARE_EQ(10, p.max);
+}
+
+TEST(Capsule, ContainsPoint)
+{
+	Capsule c(Vector2(0, 0), Vector2(100, 0), 10);
+
+	EXPECT_TRUE(c.Contains(Vector2(50, 9)));
+	EXPECT_TRUE(c.Contains(Vector2(-7, 7)));
+	EXPECT_FALSE(c.Contains(Vector2(50, 11)));
+	EXPECT_FALSE(c.Contains(Vector2(-8, 8)));
+}
+
+TEST(Capsule, ContainsShapes)
+{
+	Capsule c(Vector2(0, 0), Vector2(100, 0), 10);
+
+	EXPECT_TRUE(c.Contains(Circle(Vector2(50, 0), 10)));
+	EXPECT_FALSE(c.Contains(Circle(Vector2(50, 1), 10)));
+	EXPECT_TRUE(c.Contains(Segment(Vector2(0, 5), Vector2(100, -5))));
+	EXPECT_TRUE(c.Contains(Capsule(Vector2(10, 0), Vector2(90, 0), 5)));
+	EXPECT_FALSE(c.Contains(Capsule(Vector2(10, 0), Vector2(90, 6), 5)));
+
+	EXPECT_TRUE(Circle(Vector2(50, 0), 70).Contains(c));
+	EXPECT_FALSE(Circle(Vector2(50, 0), 50).Contains(c));
+	EXPECT_TRUE(Box(Vector2(50, 0), Vector2(60, 10)).Contains(c));
+	EXPECT_FALSE(Box(Vector2(50, 0), Vector2(60, 9)).Contains(c));
+}
+
+TEST(Capsule, OverlapsCapsule)
+{
+	Capsule a(Vector2(0, 0), Vector2(100, 0), 10);
+
+	EXPECT_TRUE(a.Overlaps(Capsule(Vector2(50, 15), Vector2(50, 100), 10)));
+	EXPECT_TRUE(a.Overlaps(Capsule(Vector2(50, -50), Vector2(50, 50), 1)));
+	EXPECT_FALSE(a.Overlaps(Capsule(Vector2(50, 21), Vector2(50, 100), 10)));
+	EXPECT_FALSE(a.Overlaps(Capsule(Vector2(115, 15), Vector2(200, 15), 10)));
+}
+
+TEST(Capsule, OverlapsCircle)
+{
+	Capsule c(Vector2(0, 0), Vector2(100, 0), 10);
+
+	EXPECT_TRUE(c.Overlaps(Circle(Vector2(50, 15), 10)));
+	EXPECT_TRUE(Circle(Vector2(50, 15), 10).Overlaps(c));
+	EXPECT_FALSE(c.Overlaps(Circle(Vector2(-20, 0), 9)));
+}
+
+TEST(Capsule, OverlapsPolygon)
+{
+	Capsule c(Vector2(0, 0), Vector2(100, 0), 10);
+
+	Polygon p;
+	p.SetPointCount(3);
+	p.SetPoint(0, Vector2(40, 5));
+	p.SetPoint(1, Vector2(60, 5));
+	p.SetPoint(2, Vector2(50, 50));
+	p.ReCalc();
+
+	EXPECT_TRUE(c.Overlaps(p));
+	EXPECT_TRUE(p.Overlaps(c));
+	EXPECT_FALSE(c.Overlaps(mPolygon(p, Vector2(0, 10))));
+	EXPECT_FALSE(c.Overlaps(mPolygon(p, Vector2(70, 6))));
+}
+
+TEST(Capsule, GetIntersectsSegment)
+{
+	Capsule c(Vector2(0, 0), Vector2(100, 0), 10);
+	Segment s(Vector2(-50, 0), Vector2(50, 0));
+
+	auto i = c.GetIntersects(s);
+
+	ARE_EQ(1, i.size());
+	ARE_EQ(-10, i[0].x);
+	ARE_EQ(0, i[0].y);
+
+	Segment s2(Vector2(50, -50), Vector2(50, 50));
+	i = c.GetIntersects(s2);
+
+	ARE_EQ(2, i.size());
+	EXPECT_TRUE(vectorContains(i, Vector2(50, 10)));
+	EXPECT_TRUE(vectorContains(i, Vector2(50, -10)));
+}
+
+TEST(Capsule, GetDisplacementCapsule)
+{
+	Capsule a(Vector2(0, 0), Vector2(100, 0), 10);
+
+	Capsule b(Vector2(50, 15), Vector2(50, 100), 10);
+	auto d = a.GetDisplacement(b);
+	ARE_EQ(0, d.x);
+	ARE_EQ(5, d.y);
+	EXPECT_FALSE(a.Overlaps(mCapsule(b, d * 1.01)));
+
+	Capsule c(Vector2(50, -50), Vector2(50, 50), 1);
+	d = a.GetDisplacement(c);
+	EXPECT_FALSE(a.Overlaps(mCapsule(c, d * 1.01)));
+
+	Capsule e(Vector2(50, 21), Vector2(50, 100), 10);
+	d = a.GetDisplacement(e);
+	ARE_EQ(0, d.Length());
+}
+
+TEST(Capsule, GetDisplacementPolygon)
+{
+	Capsule c(Vector2(0, 0), Vector2(100, 0), 10);
+
+	Polygon p;
+	p.SetPointCount(3);
+	p.SetPoint(0, Vector2(40, 5));
+	p.SetPoint(1, Vector2(60, 5));
+	p.SetPoint(2, Vector2(50, 50));
+	p.ReCalc();
+
+	auto d = c.GetDisplacement(p);
+	ARE_EQ(5, d.Length());
+	EXPECT_FALSE(c.Overlaps(mPolygon(p, d * 1.01)));
+}
+
+TEST(Capsule, GetGollisionCircle)
+{
+	Capsule c(Vector2(0, 0), Vector2(100, 0), 10);
+	Circle o(Vector2(50, 15), 10);
+
+	Collision col = c.GetCollision(o);
+	ARE_EQ(c.Overlaps(o), col.Overlaps());
+	ARE_EQ(c.Contains(o), col.AcontainsB());
+	ARE_EQ(o.Contains(c), col.BcontainsA());
+
+	auto iC = col.GetIntersects();
+	auto iF = c.GetIntersects(o);
+
+	EXPECT_TRUE(vectorEQ(iC, iF));
+
+	auto dC = col.GetDisplacement();
+	auto dF = c.GetDisplacement(o);
+
+	ARE_EQ(dC.x, dF.x);
+	ARE_EQ(dC.y, dF.y);
+}
+
+TEST(Capsule, GetCollisionCrossedSpines)
+{
+	Capsule a(Vector2(0, 0), Vector2(100, 0), 10);
+	Capsule b(Vector2(50, -50), Vector2(50, 50), 1);
+
+	// The spines cross, so the overlap is the signed one of the separating axis test, as for polygons
+	Collision col = a.GetCollision(b);
+	ASSERT_TRUE(col.Overlaps());
+	ARE_EQ(-61, col.GetOverlap());
+	ARE_EQ(0, col.GetDisplacement().x);
+	ARE_EQ(col.GetOverlap(), col.GetDisplacement().y);
+}
+
+TEST(Capsule, Transform)
+{
+	Capsule c(Vector2(0, 0), Vector2(100, 0), 10);
+
+	Transformation t;
+	t.SetScale(Vector2(2, 2));
+	t.Translate(Vector2(0, 5));
+	c.Transform(t);
+
+	ARE_EQ(20, c.GetRadius());
+	ARE_EQ(200, c.GetPoint(1).x);
+	ARE_EQ(5, c.GetPoint(1).y);
+	ARE_EQ(100, c.GetCenter().x);
+}
+
+TEST(Capsule, TransformMirrored)
+{
+	Capsule c(Vector2(0, 0), Vector2(100, 0), 10);
+
+	Transformation t;
+	t.SetScale(Vector2(-1, 2));
+	c.Transform(t);
+
+	// The radius stays positive and takes the larger scale
+	ARE_EQ(20, c.GetRadius());
+	ARE_EQ(-100, c.GetPoint(1).x);
+
+	const Projection p = c.Project(Axis(1, 0));
+	EXPECT_LE(p.min, p.max);
+
+	EXPECT_TRUE(c.Overlaps(Circle(Vector2(-50, 25), 6)));
+	EXPECT_FALSE(c.Overlaps(Circle(Vector2(50, 0), 5)));
+}
+
+// Double Disbatch tests
+
+TEST(Capsule, ContainsShape)
+{
+	ShapePtr aP(new Capsule(Vector2(0, 0), Vector2(100, 0), 10));
+	ShapePtr bP(new Circle(Vector2(50, 0), 5));
+
+	EXPECT_TRUE(aP->Contains(*bP));
+	EXPECT_FALSE(bP->Contains(*aP));
+	EXPECT_TRUE(bP->IsInside(*aP));
+}
+
+TEST(Capsule, GetDisplacementShape)
+{
+	ShapePtr aP(new Capsule(Vector2(0, 0), Vector2(100, 0), 10));
+	ShapePtr bP(new Capsule(Vector2(50, 15), Vector2(50, 100), 10));
+
+	Capsule aO = *dynamic_cast<Capsule*>(aP.get());
+	Capsule bO = *dynamic_cast<Capsule*>(bP.get());
+
+	EXPECT_EQ(aP->GetDisplacement(*bP), aO.GetDisplacement(bO));
+	EXPECT_EQ(bP->GetDisplacement(*aP), -aO.GetDisplacement(bO));
+}
+
+TEST(Capsule, GetGollisionShape)
+{
+	ShapePtr aP(new Capsule(Vector2(0, 0), Vector2(100, 0), 10));
+	ShapePtr bP(new Segment(Vector2(50, -50), Vector2(50, 50)));
+
+	Capsule aO = *dynamic_cast<Capsule*>(aP.get());
+	Segment bO = *dynamic_cast<Segment*>(bP.get());
+
+	Collision colPtr = aP->GetCollision(*bP);
+	Collision colObj = aO.GetCollision(bO);
+
+	ARE_EQ(colPtr.Overlaps(), colObj.Overlaps());
+	ARE_EQ(colPtr.AcontainsB(), colObj.AcontainsB());
+	ARE_EQ(colPtr.BcontainsA(), colObj.BcontainsA());
+
+	auto iP = colPtr.GetIntersects();
+	auto iO = colObj.GetIntersects();
+
+	EXPECT_TRUE(vectorEQ(iP, iO));
+
+	ARE_EQ(colPtr.GetDisplacement().x, colObj.GetDisplacement().x);
+	ARE_EQ(colPtr.GetDisplacement().y, colObj.GetDisplacement().y);
+}
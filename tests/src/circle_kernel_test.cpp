@@ -0,0 +1,148 @@
+#include "helper.hpp"
+
+#include <Crash2D/circle_kernel.hpp>
+
+struct CircleSoA
+{
+	std::vector<Precision_t> x, y, radius;
+
+	void Add(const Circle &c)
+	{
+		x.push_back(c.GetCenter().x);
+		y.push_back(c.GetCenter().y);
+		radius.push_back(c.GetRadius());
+	}
+
+	const CircleBatch GetBatch() const
+	{
+		CircleBatch b = { x.data(), y.data(), radius.data(), static_cast<unsigned>(x.size()) };
+		return b;
+	}
+};
+
+struct ContactsSoA
+{
+	std::vector<unsigned char> overlaps;
+	std::vector<Precision_t> depth, normalX, normalY;
+
+	ContactsSoA(unsigned n) : overlaps(n), depth(n), normalX(n), normalY(n) {}
+
+	CircleContacts GetContacts()
+	{
+		CircleContacts c = { overlaps.data(), depth.data(), normalX.data(), normalY.data() };
+		return c;
+	}
+};
+
+static std::vector<Circle> Circles(unsigned n)
+{
+	std::vector<Circle> circles;
+
+	for (unsigned i = 0; i < n; i++)
+		circles.push_back(Circle(Vector2(std::cos(i * 1.3f) * 40, std::sin(i * 0.7f) * 40), 5 + (i % 7) * 3));
+
+	return circles;
+}
+
+static void ExpectContact(const Circle &a, const Circle &b, const ContactsSoA &out, unsigned i)
+{
+	const bool overlaps = a.Overlaps(b);
+	ARE_EQ(overlaps, out.overlaps[i] != 0);
+
+	if (!overlaps)
+	{
+		ARE_EQ(0, out.depth[i]);
+		ARE_EQ(0, out.normalX[i]);
+		ARE_EQ(0, out.normalY[i]);
+		return;
+	}
+
+	const Vector2 v = b.GetCenter() - a.GetCenter();
+	ARE_EQ(a.GetRadius() + b.GetRadius() - v.Length(), out.depth[i]);
+
+	// GetDisplacement adds one to the depth, the direction is the same
+	const Vector2 d = a.GetDisplacement(b);
+	const Precision_t len = d.Length();
+	ARE_EQ(d.x / len, out.normalX[i]);
+	ARE_EQ(d.y / len, out.normalY[i]);
+}
+
+TEST(CircleKernel, CollidePairs)
+{
+	auto circles = Circles(13);
+
+	CircleSoA soa;
+	for (auto && c : circles)
+		soa.Add(c);
+
+	std::vector<unsigned> first, second;
+	for (unsigned i = 0; i < circles.size(); i++)
+	{
+		for (unsigned j = i + 1; j < circles.size(); j++)
+		{
+			first.push_back(i);
+			second.push_back(j);
+		}
+	}
+
+	ContactsSoA out(first.size());
+	CircleContacts contacts = out.GetContacts();
+	CollideCircles(soa.GetBatch(), first.data(), second.data(), first.size(), contacts);
+
+	for (unsigned i = 0; i < first.size(); i++)
+		ExpectContact(circles[first[i]], circles[second[i]], out, i);
+}
+
+TEST(CircleKernel, CollideOneToMany)
+{
+	const Circle c = Circle(Vector2(5, -3), 20);
+
+	for (unsigned n = 1; n <= 9; n++)
+	{
+		auto circles = Circles(n);
+
+		CircleSoA soa;
+		for (auto && other : circles)
+			soa.Add(other);
+
+		ContactsSoA out(n);
+		CircleContacts contacts = out.GetContacts();
+		CollideCircles(c.GetCenter(), c.GetRadius(), soa.GetBatch(), contacts);
+
+		for (unsigned i = 0; i < n; i++)
+			ExpectContact(c, circles[i], out, i);
+	}
+}
+
+TEST(CircleKernel, Touching)
+{
+	CircleSoA soa;
+	soa.Add(Circle(Vector2(0, 0), 5));
+	soa.Add(Circle(Vector2(10, 0), 5));
+
+	const unsigned first = 0, second = 1;
+
+	ContactsSoA out(1);
+	CircleContacts contacts = out.GetContacts();
+	CollideCircles(soa.GetBatch(), &first, &second, 1, contacts);
+
+	ARE_EQ(1, out.overlaps[0]);
+	ARE_EQ(0, out.depth[0]);
+	ARE_EQ(1, out.normalX[0]);
+	ARE_EQ(0, out.normalY[0]);
+}
+
+TEST(CircleKernel, SameCenter)
+{
+	CircleSoA soa;
+	soa.Add(Circle(Vector2(3, 4), 5));
+
+	ContactsSoA out(1);
+	CircleContacts contacts = out.GetContacts();
+	CollideCircles(Vector2(3, 4), 2, soa.GetBatch(), contacts);
+
+	ARE_EQ(1, out.overlaps[0]);
+	ARE_EQ(7, out.depth[0]);
+	ARE_EQ(1, out.normalX[0]);
+	ARE_EQ(0, out.normalY[0]);
+}
@@ -541,3 +541,13 @@ TEST(Circle, GetGollisionShape)
 	ARE_EQ(colPtr.GetDisplacement().x, colObj.GetDisplacement().x);
 	ARE_EQ(colPtr.GetDisplacement().y, colObj.GetDisplacement().y);
 }
+
+TEST(Circle, GetDisplacementSameCenter)
+{
+	Circle a(Vector2(10, 10), 5);
+	Circle b(Vector2(10, 10), 3);
+
+	// Coincident circles separate along the x axis
+	EXPECT_EQ(Vector2(9, 0), a.GetDisplacement(b));
+	EXPECT_EQ(Vector2(9, 0), a.GetCollision(b).GetDisplacement());
+}
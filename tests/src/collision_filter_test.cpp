@@ -0,0 +1,50 @@
+#include "helper.hpp"
+
+#include <Crash2D/collision_filter.hpp>
+
+TEST(CollisionFilter, Default)
+{
+	const CollisionFilter a, b;
+
+	EXPECT_TRUE(a.Accepts(b));
+	ARE_EQ(1, a.category);
+	EXPECT_EQ(0xFFFFFFFFu, a.mask);
+	ARE_EQ(0, a.group);
+}
+
+TEST(CollisionFilter, CategoryMask)
+{
+	const uint32_t PLAYER = 1, ENEMY = 2, BULLET = 4;
+
+	const CollisionFilter player(PLAYER, ENEMY | BULLET);
+	const CollisionFilter enemy(ENEMY, PLAYER | BULLET);
+	const CollisionFilter bullet(BULLET, PLAYER | ENEMY);
+
+	EXPECT_TRUE(player.Accepts(enemy));
+	EXPECT_TRUE(bullet.Accepts(enemy));
+	EXPECT_FALSE(bullet.Accepts(bullet));
+	EXPECT_FALSE(player.Accepts(player));
+
+	// Both sides have to agree
+	const CollisionFilter ghost(ENEMY, 0);
+	EXPECT_FALSE(player.Accepts(ghost));
+	EXPECT_FALSE(ghost.Accepts(player));
+}
+
+TEST(CollisionFilter, Group)
+{
+	const CollisionFilter teamA(1, 0xFFFFFFFF, -1);
+	const CollisionFilter teamB(1, 0xFFFFFFFF, -2);
+	const CollisionFilter linked(2, 0, 3);
+
+	// A shared negative group never collides, a shared positive group always does
+	EXPECT_FALSE(teamA.Accepts(teamA));
+	EXPECT_TRUE(teamA.Accepts(teamB));
+	EXPECT_TRUE(linked.Accepts(linked));
+
+	// Different groups fall back to the masks
+	EXPECT_FALSE(linked.Accepts(teamA));
+
+	EXPECT_EQ(teamA, CollisionFilter(1, 0xFFFFFFFF, -1));
+	EXPECT_NE(teamA, teamB);
+}
@@ -14,7 +14,7 @@ TEST(Collision, DefaultConstructor)
 
 TEST(Collision, FullConstructor)
 {
-	Collision c(true, std::vector<Vector2>(1), true, true, Vector2(-5, -7));
+	Collision c(true, std::vector<Vector2>(1), true, true, 0, Vector2(-5, -7));
 
 	EXPECT_TRUE(c.Overlaps());
 	EXPECT_TRUE(c.AcontainsB());
@@ -30,7 +30,7 @@ TEST(Collision, Negate)
 	pt[0] = Vector2(5, 5);
 	pt[1] = Vector2(-10, -10);
 
-	Collision c(true, pt, false, true, Vector2(-5, -7));
+	Collision c(true, pt, false, true, 0, Vector2(-5, -7));
 
 	c = -c;
 
@@ -47,3 +47,41 @@ TEST(Collision, Negate)
 	ARE_EQ(5, c.GetDisplacement().x);
 	ARE_EQ(7, c.GetDisplacement().y);
 }
+
+TEST(Collision, DisplacementOverlaps)
+{
+	Polygon square;
+	square.SetPointCount(4);
+	square.SetPoint(0, Vector2(0, 10));
+	square.SetPoint(1, Vector2(10, 10));
+	square.SetPoint(2, Vector2(10, 20));
+	square.SetPoint(3, Vector2(0, 20));
+	square.ReCalc();
+
+	// Touching pairs are among them, which overlap without any displacement for some shapes
+	const Circle circle(Vector2(0, 0), 5);
+	const Circle touching(Vector2(10, 0), 5);
+	const Segment segment(Vector2(-5, 5), Vector2(20, 5));
+	const Segment crossing(Vector2(5, -10), Vector2(5, 25));
+	const Capsule capsule(Vector2(20, -10), Vector2(20, 30), 3);
+	const Box box(Vector2(30, 0), Vector2(5, 5));
+	const Box beside(Vector2(40, 0), Vector2(5, 5));
+	const OrientedBox rotated(Vector2(8, 18), Vector2(4, 2), 0.5);
+
+	const std::vector<const Shape*> shapes = { &circle, &touching, &segment, &crossing, &capsule, &square, &box, &beside, &rotated };
+
+	for (auto && a : shapes)
+	{
+		for (auto && b : shapes)
+		{
+			if (a == b)
+				continue;
+
+			bool overlaps;
+			const Vector2 displacement = a->GetDisplacement(*b, overlaps);
+
+			EXPECT_EQ(a->Overlaps(*b), overlaps);
+			EXPECT_EQ(overlaps ? a->GetDisplacement(*b) : Vector2(0, 0), displacement);
+		}
+	}
+}
@@ -0,0 +1,562 @@
+#include "helper.hpp"
+
+#include <Crash2D/collision_world.hpp>
+#include <Crash2D/thread_pool.hpp>
+
+static Polygon* Square(const Vector2 &c, Precision_t h)
+{
+	Polygon *p = new Polygon();
+	p->SetPointCount(4);
+	p->SetPoint(0, c + Vector2(-h, -h));
+	p->SetPoint(1, c + Vector2(h, -h));
+	p->SetPoint(2, c + Vector2(h, h));
+	p->SetPoint(3, c + Vector2(-h, h));
+	p->ReCalc();
+
+	return p;
+}
+
+TEST(CollisionWorld, AddAndRemove)
+{
+	CollisionWorld w;
+
+	ShapeHandle a = w.Add(new Circle(Vector2(0, 0), 5));
+	ShapeHandle b = w.Add(Square(Vector2(50, 0), 5));
+
+	ARE_EQ(2, w.GetShapeCount());
+	EXPECT_TRUE(w.IsValid(a));
+	EXPECT_NE(nullptr, w.Get(b));
+
+	w.Remove(a);
+	EXPECT_FALSE(w.IsValid(a));
+	EXPECT_EQ(nullptr, w.Get(a));
+	ARE_EQ(1, w.GetShapeCount());
+
+	// The slot is reused, but the old handle stays invalid
+	ShapeHandle c = w.Add(new Circle(Vector2(0, 0), 5));
+	EXPECT_EQ(a.index, c.index);
+	EXPECT_NE(a, c);
+	EXPECT_FALSE(w.IsValid(a));
+	EXPECT_TRUE(w.IsValid(c));
+}
+
+TEST(CollisionWorld, Step)
+{
+	CollisionWorld w;
+
+	ShapeHandle a = w.Add(new Circle(Vector2(0, 0), 5));
+	ShapeHandle b = w.Add(Square(Vector2(8, 0), 5));
+	ShapeHandle c = w.Add(new Capsule(Vector2(100, 0), Vector2(120, 0), 4));
+	ShapeHandle d = w.Add(new Box(Vector2(200, 200), Vector2(5, 5)));
+
+	ARE_EQ(1, w.Step());
+
+	const Contact &contact = w.GetContacts()[0];
+	EXPECT_EQ(a, contact.a);
+	EXPECT_EQ(b, contact.b);
+
+	const Vector2 expected = w.Get(a)->GetDisplacement(*w.Get(b));
+	ARE_EQ(expected.x, contact.displacement.x);
+	ARE_EQ(expected.y, contact.displacement.y);
+
+	// Moving a shape through the world keeps the broadphase in sync
+	w.Transform(d, Transformation(Vector2(1, 1), 0, Vector2(-90, -200)));
+	ARE_EQ(2, w.Step());
+	EXPECT_EQ(c, w.GetContacts()[1].a);
+	EXPECT_EQ(d, w.GetContacts()[1].b);
+
+	// Removed and moved shapes drop out
+	w.Remove(b);
+	w.Transform(a, Transformation(Vector2(1, 1), 0, Vector2(0, 300)));
+	ARE_EQ(1, w.Step());
+}
+
+TEST(CollisionWorld, MarkMoved)
+{
+	CollisionWorld w;
+
+	ShapeHandle a = w.Add(new Circle(Vector2(0, 0), 5));
+	ShapeHandle b = w.Add(new Circle(Vector2(40, 0), 5));
+	ARE_EQ(0, w.Step());
+
+	// Changed directly, so the world has to be told
+	w.Get(b)->Transform(Transformation(Vector2(1, 1), 0, Vector2(-32, 0)));
+	w.MarkMoved(b);
+
+	ARE_EQ(1, w.Step());
+	EXPECT_EQ(a, w.GetContacts()[0].a);
+}
+
+// Runs every task on the calling thread in reverse, counting batches
+class ReverseScheduler : public Scheduler
+{
+public:
+	ReverseScheduler() : batches(0) {}
+
+	virtual const unsigned GetWorkerCount() const override
+	{
+		return 3;
+	}
+
+	virtual void Run(const unsigned count, const Task &task) override
+	{
+		batches++;
+
+		for (unsigned i = count; i > 0; i--)
+			task(i - 1, i % 3);
+	}
+
+	unsigned batches;
+};
+
+static void Crowd(CollisionWorld &w, unsigned n)
+{
+	for (unsigned i = 0; i < n; i++)
+	{
+		const Vector2 c(std::cos(i * 1.3f) * 80, std::sin(i * 0.7f) * 80);
+
+		if (i % 3 == 0)
+			w.Add(new Circle(c, 6 + i % 4));
+
+		else if (i % 3 == 1)
+			w.Add(Square(c, 5 + i % 3));
+
+		else
+			w.Add(new Capsule(c, c + Vector2(8, 3), 3));
+	}
+}
+
+static void ExpectSameContacts(const std::vector<Contact> &a, const std::vector<Contact> &b)
+{
+	ASSERT_EQ(a.size(), b.size());
+
+	for (unsigned i = 0; i < a.size(); i++)
+	{
+		EXPECT_EQ(a[i].a, b[i].a);
+		EXPECT_EQ(a[i].b, b[i].b);
+		EXPECT_EQ(a[i].displacement.x, b[i].displacement.x);
+		EXPECT_EQ(a[i].displacement.y, b[i].displacement.y);
+	}
+}
+
+TEST(CollisionWorld, StepParallel)
+{
+	CollisionWorld serial;
+	Crowd(serial, 300);
+	serial.Step();
+
+	EXPECT_GT(serial.GetContacts().size(), NARROWPHASE_CHUNK);
+
+	ThreadPool pool(4);
+	CollisionWorld parallel;
+	Crowd(parallel, 300);
+	parallel.SetScheduler(&pool);
+	EXPECT_EQ(&pool, parallel.GetScheduler());
+	parallel.Step();
+
+	ExpectSameContacts(serial.GetContacts(), parallel.GetContacts());
+}
+
+TEST(CollisionWorld, StepCustomScheduler)
+{
+	CollisionWorld serial;
+	Crowd(serial, 300);
+	serial.Step();
+
+	ReverseScheduler scheduler;
+	CollisionWorld custom;
+	Crowd(custom, 300);
+	custom.SetScheduler(&scheduler);
+	custom.Step();
+
+	ARE_EQ(1, scheduler.batches);
+	ExpectSameContacts(serial.GetContacts(), custom.GetContacts());
+}
+
+// Moves, removes and re-adds shapes over several steps, collecting the hash of each step
+static std::vector<uint64_t> Simulate(Scheduler *s)
+{
+	CollisionWorld w;
+	w.SetScheduler(s);
+	Crowd(w, 400);
+
+	std::vector<uint64_t> hashes;
+
+	for (unsigned step = 0; step < 8; step++)
+	{
+		for (unsigned i = step % 5; i < 400; i += 5)
+		{
+			const ShapeHandle h{ i, w.IsValid(ShapeHandle{ i, 0 }) ? 0u : 1u };
+			w.Transform(h, Transformation(Vector2(1, 1), 0, Vector2(std::cos(i + step * 0.5f) * 3, std::sin(i * 0.3f + step) * 3)));
+		}
+
+		if (step == 3)
+		{
+			for (unsigned i = 0; i < 400; i += 7)
+				w.Remove(ShapeHandle{ i, 0 });
+
+			Crowd(w, 40);
+		}
+
+		w.Step();
+		hashes.push_back(w.GetContactHash());
+	}
+
+	return hashes;
+}
+
+TEST(CollisionWorld, ContactHash)
+{
+	CollisionWorld w;
+	const uint64_t empty = w.GetContactHash();
+
+	ShapeHandle a = w.Add(new Circle(Vector2(0, 0), 5));
+	w.Add(new Circle(Vector2(6, 0), 5));
+	w.Step();
+	const uint64_t first = w.GetContactHash();
+	EXPECT_NE(empty, first);
+
+	// Same contacts, same hash
+	w.Step();
+	EXPECT_EQ(first, w.GetContactHash());
+
+	// Any change to a displacement changes the hash
+	w.Transform(a, Transformation(Vector2(1, 1), 0, Vector2(0.001f, 0)));
+	w.Step();
+	EXPECT_NE(first, w.GetContactHash());
+}
+
+TEST(CollisionWorld, Deterministic)
+{
+	const std::vector<uint64_t> serial = Simulate(nullptr);
+
+	// Repeated runs match
+	EXPECT_EQ(serial, Simulate(nullptr));
+
+	for (unsigned workers = 1; workers <= 8; workers++)
+	{
+		ThreadPool pool(workers);
+		EXPECT_EQ(serial, Simulate(&pool)) << workers << " workers";
+	}
+
+	ReverseScheduler reverse;
+	EXPECT_EQ(serial, Simulate(&reverse));
+}
+
+static void ExpectEvent(const ContactEvent &e, ContactEventType type, const ShapeHandle &a, const ShapeHandle &b)
+{
+	EXPECT_EQ(type, e.type);
+	EXPECT_EQ(a, e.contact.a);
+	EXPECT_EQ(b, e.contact.b);
+}
+
+TEST(CollisionWorld, Events)
+{
+	CollisionWorld w;
+
+	ShapeHandle a = w.Add(new Circle(Vector2(0, 0), 5));
+	ShapeHandle b = w.Add(new Circle(Vector2(20, 0), 5));
+	ShapeHandle c = w.Add(Square(Vector2(100, 0), 5));
+
+	w.Step();
+	EXPECT_TRUE(w.GetEvents().empty());
+
+	w.Transform(b, Transformation(Vector2(1, 1), 0, Vector2(-12, 0)));
+	w.Step();
+	ASSERT_EQ(1u, w.GetEvents().size());
+	ExpectEvent(w.GetEvents()[0], CONTACT_BEGIN, a, b);
+
+	// Nothing moved, so the cached result is reported again without a test
+	const Vector2 d = w.GetContacts()[0].displacement;
+	w.Step();
+	ARE_EQ(0, w.GetTestedCount());
+	ASSERT_EQ(1u, w.GetEvents().size());
+	ExpectEvent(w.GetEvents()[0], CONTACT_PERSIST, a, b);
+	EXPECT_EQ(d.x, w.GetEvents()[0].contact.displacement.x);
+	EXPECT_EQ(d.y, w.GetEvents()[0].contact.displacement.y);
+
+	w.Transform(b, Transformation(Vector2(1, 1), 0, Vector2(1, 0)));
+	w.Step();
+	ARE_EQ(1, w.GetTestedCount());
+	ExpectEvent(w.GetEvents()[0], CONTACT_PERSIST, a, b);
+
+	// Separated, but still candidates
+	w.Transform(b, Transformation(Vector2(1, 1), 0, Vector2(1.5f, 0)));
+	w.Step();
+	ASSERT_EQ(1u, w.GetEvents().size());
+	ExpectEvent(w.GetEvents()[0], CONTACT_END, a, b);
+
+	w.Step();
+	EXPECT_TRUE(w.GetEvents().empty());
+
+	// Removing a shape ends its contacts
+	w.Transform(c, Transformation(Vector2(1, 1), 0, Vector2(-82, 0)));
+	w.Step();
+	ASSERT_EQ(1u, w.GetEvents().size());
+	ExpectEvent(w.GetEvents()[0], CONTACT_BEGIN, b, c);
+
+	w.Remove(c);
+	w.Step();
+	ASSERT_EQ(1u, w.GetEvents().size());
+	ExpectEvent(w.GetEvents()[0], CONTACT_END, b, c);
+	EXPECT_TRUE(w.GetContacts().empty());
+}
+
+TEST(CollisionWorld, EventsReusedSlot)
+{
+	CollisionWorld w;
+
+	ShapeHandle a = w.Add(new Circle(Vector2(0, 0), 5));
+	ShapeHandle b = w.Add(new Circle(Vector2(6, 0), 5));
+	w.Step();
+
+	// A new shape in the same slot and place is a new contact
+	w.Remove(b);
+	ShapeHandle c = w.Add(new Circle(Vector2(6, 0), 5));
+	EXPECT_EQ(b.index, c.index);
+
+	w.Step();
+	ARE_EQ(1, w.GetTestedCount());
+	ASSERT_EQ(2u, w.GetEvents().size());
+	ExpectEvent(w.GetEvents()[0], CONTACT_END, a, b);
+	ExpectEvent(w.GetEvents()[1], CONTACT_BEGIN, a, c);
+}
+
+TEST(CollisionWorld, ReuseResults)
+{
+	ThreadPool pool(4);
+	CollisionWorld w;
+	Crowd(w, 300);
+	w.SetScheduler(&pool);
+
+	w.Step();
+	const std::vector<Contact> first = w.GetContacts();
+	EXPECT_GT(w.GetTestedCount(), 0u);
+
+	w.Step();
+	ARE_EQ(0, w.GetTestedCount());
+	ExpectSameContacts(first, w.GetContacts());
+	EXPECT_EQ(first.size(), w.GetEvents().size());
+
+	for (auto && e : w.GetEvents())
+		EXPECT_EQ(CONTACT_PERSIST, e.type);
+
+	// Only pairs touching the moved shape are tested again
+	w.Transform(first[0].a, Transformation(Vector2(1, 1), 0, Vector2(0.5f, 0)));
+	w.Step();
+	EXPECT_GT(w.GetTestedCount(), 0u);
+	EXPECT_LT(w.GetTestedCount(), 20u);
+}
+
+TEST(CollisionWorld, Static)
+{
+	CollisionWorld w;
+
+	ShapeHandle a = w.Add(Square(Vector2(0, 0), 5), MOTION_STATIC);
+	ShapeHandle b = w.Add(Square(Vector2(8, 0), 5), MOTION_STATIC);
+	ShapeHandle c = w.Add(new Circle(Vector2(30, 0), 5));
+
+	EXPECT_EQ(MOTION_STATIC, w.GetMotionType(a));
+	EXPECT_EQ(MOTION_DYNAMIC, w.GetMotionType(c));
+	EXPECT_EQ(MOTION_STATIC, w.GetMotionType(ShapeHandle{ 99, 0 }));
+	EXPECT_EQ(MOTION_STATIC, w.GetMotionType(ShapeHandle{ c.index, c.generation + 1 }));
+	EXPECT_FALSE(w.IsAwake(a));
+	EXPECT_TRUE(w.IsAwake(c));
+
+	// Static shapes are never paired with each other, and never wake
+	ARE_EQ(0, w.Step());
+	ARE_EQ(0, w.GetPairCount());
+
+	w.Wake(a);
+	EXPECT_FALSE(w.IsAwake(a));
+
+	w.Transform(c, Transformation(Vector2(1, 1), 0, Vector2(-16, 0)));
+	ARE_EQ(1, w.Step());
+	EXPECT_EQ(b, w.GetContacts()[0].a);
+	EXPECT_EQ(c, w.GetContacts()[0].b);
+}
+
+TEST(CollisionWorld, StaticWakesSleeping)
+{
+	CollisionWorld w;
+
+	ShapeHandle a = w.Add(Square(Vector2(-40, 0), 5), MOTION_STATIC);
+	ShapeHandle c = w.Add(new Circle(Vector2(0, 0), 5));
+
+	w.Sleep(c);
+	ARE_EQ(0, w.Step());
+
+	// Moving a static shape onto a sleeping one finds the pair and wakes it
+	w.Transform(a, Transformation(Vector2(1, 1), 0, Vector2(38, 0)));
+	ARE_EQ(1, w.Step());
+	EXPECT_TRUE(w.IsAwake(c));
+
+	w.Sleep(c);
+	w.Remove(a);
+	ARE_EQ(0, w.Step());
+
+	// So does adding one on top of it
+	ShapeHandle b = w.Add(Square(Vector2(2, 0), 5), MOTION_STATIC);
+	ARE_EQ(1, w.Step());
+	EXPECT_EQ(b, w.GetContacts()[0].a);
+	EXPECT_TRUE(w.IsAwake(c));
+
+	// Static shapes moved onto each other are still not paired
+	w.Add(Square(Vector2(40, 0), 5), MOTION_STATIC);
+	w.Transform(b, Transformation(Vector2(1, 1), 0, Vector2(36, 0)));
+	ARE_EQ(0, w.Step());
+	ARE_EQ(0, w.GetPairCount());
+}
+
+TEST(CollisionWorld, Sleep)
+{
+	CollisionWorld w;
+
+	ShapeHandle ground = w.Add(Square(Vector2(0, 0), 20), MOTION_STATIC);
+	ShapeHandle a = w.Add(new Circle(Vector2(-5, 22), 5));
+	ShapeHandle b = w.Add(new Circle(Vector2(4, 22), 5));
+	ShapeHandle c = w.Add(new Circle(Vector2(60, 22), 5));
+
+	ARE_EQ(3, w.Step());
+	EXPECT_EQ(ground, w.GetContacts()[0].a);
+
+	w.Sleep(a);
+	w.Sleep(b);
+	EXPECT_FALSE(w.IsAwake(a));
+
+	// Resting contacts persist without being found or tested again
+	ARE_EQ(3, w.Step());
+	ARE_EQ(0, w.GetPairCount());
+	ARE_EQ(0, w.GetTestedCount());
+	ASSERT_EQ(3u, w.GetEvents().size());
+
+	for (auto && e : w.GetEvents())
+		EXPECT_EQ(CONTACT_PERSIST, e.type);
+
+	// A moving shape that touches a sleeping one wakes it, which lets its other pairs be found again
+	w.Transform(c, Transformation(Vector2(1, 1), 0, Vector2(-48, 0)));
+	w.Step();
+	EXPECT_TRUE(w.IsAwake(b));
+	EXPECT_FALSE(w.IsAwake(a));
+
+	// Moving a sleeping shape wakes it
+	w.Transform(a, Transformation(Vector2(1, 1), 0, Vector2(0, 1)));
+	EXPECT_TRUE(w.IsAwake(a));
+
+	// Removing a sleeping shape ends its contacts
+	w.Step();
+	w.Sleep(a);
+	w.Sleep(b);
+	w.Sleep(c);
+	w.Step();
+	const unsigned contacts = w.GetContacts().size();
+
+	w.Remove(a);
+	ARE_EQ(contacts - 2, w.Step());
+
+	for (auto && e : w.GetEvents())
+	{
+		const bool removed = (e.contact.a == a || e.contact.b == a);
+		EXPECT_EQ(removed ? CONTACT_END : CONTACT_PERSIST, e.type);
+	}
+}
+
+TEST(CollisionWorld, SleepDelay)
+{
+	CollisionWorld w;
+	EXPECT_EQ(0u, w.GetSleepDelay());
+
+	w.SetSleepDelay(2);
+	EXPECT_EQ(2u, w.GetSleepDelay());
+
+	ShapeHandle a = w.Add(new Circle(Vector2(0, 0), 5));
+	ShapeHandle b = w.Add(new Circle(Vector2(100, 0), 5));
+
+	w.Step();
+	EXPECT_TRUE(w.IsAwake(a));
+
+	// b keeps moving, a falls asleep after two still steps
+	w.Transform(b, Transformation(Vector2(1, 1), 0, Vector2(-1, 0)));
+	w.Step();
+	EXPECT_FALSE(w.IsAwake(a));
+	EXPECT_TRUE(w.IsAwake(b));
+
+	w.Transform(b, Transformation(Vector2(1, 1), 0, Vector2(-91, 0)));
+	ARE_EQ(1, w.Step());
+	EXPECT_TRUE(w.IsAwake(a));
+}
+
+TEST(CollisionWorld, SleepMatchesAwake)
+{
+	// Shapes resting on level geometry give the same contacts asleep or awake
+	CollisionWorld awake, asleep;
+	std::vector<ShapeHandle> handles;
+
+	for (CollisionWorld *w : { &awake, &asleep })
+	{
+		for (unsigned i = 0; i < 20; i++)
+			w->Add(Square(Vector2(i * 20, 0), 10), MOTION_STATIC);
+
+		Crowd(*w, 200);
+	}
+
+	asleep.SetSleepDelay(1);
+
+	for (unsigned step = 0; step < 6; step++)
+	{
+		// Only a few shapes keep moving
+		for (unsigned i = 20 + step; i < 220; i += 40)
+		{
+			for (CollisionWorld *w : { &awake, &asleep })
+				w->Transform(ShapeHandle{ i, 0 }, Transformation(Vector2(1, 1), 0, Vector2(2, 1)));
+		}
+
+		awake.Step();
+		asleep.Step();
+
+		ExpectSameContacts(awake.GetContacts(), asleep.GetContacts());
+	}
+
+	EXPECT_LT(asleep.GetPairCount() * 5, awake.GetPairCount());
+}
+
+TEST(CollisionWorld, Filter)
+{
+	CollisionWorld w;
+
+	const CollisionFilter team(1, 0xFFFFFFFF, -1);
+
+	ShapeHandle a = w.Add(new Circle(Vector2(0, 0), 5), MOTION_DYNAMIC, team);
+	ShapeHandle b = w.Add(new Circle(Vector2(6, 0), 5), MOTION_DYNAMIC, team);
+	ShapeHandle c = w.Add(new Circle(Vector2(12, 0), 5));
+
+	EXPECT_EQ(team, w.GetFilter(a));
+	EXPECT_EQ(CollisionFilter(), w.GetFilter(c));
+
+	// A handle to no shape gets a filter that collides with nothing
+	EXPECT_EQ(CollisionFilter(0, 0), w.GetFilter(ShapeHandle{ 99, 0 }));
+	EXPECT_EQ(CollisionFilter(0, 0), w.GetFilter(ShapeHandle{ a.index, a.generation + 1 }));
+
+	// Teammates ignore each other
+	ARE_EQ(1, w.Step());
+	ARE_EQ(1, w.GetPairCount());
+	EXPECT_EQ(b, w.GetContacts()[0].a);
+	EXPECT_EQ(c, w.GetContacts()[0].b);
+
+	// Filtering out a touching pair ends it, even while both shapes sleep
+	w.Sleep(b);
+	w.Sleep(c);
+	ARE_EQ(1, w.Step());
+
+	w.SetFilter(c, CollisionFilter(2, 2));
+	EXPECT_TRUE(w.IsAwake(c));
+	ARE_EQ(0, w.Step());
+	ASSERT_EQ(1u, w.GetEvents().size());
+	EXPECT_EQ(CONTACT_END, w.GetEvents()[0].type);
+
+	// Leaving the team lets the pair collide again
+	w.SetFilter(a, CollisionFilter());
+	ARE_EQ(1, w.Step());
+	EXPECT_EQ(a, w.GetContacts()[0].a);
+	EXPECT_EQ(b, w.GetContacts()[0].b);
+}
@@ -0,0 +1,103 @@
+#include "helper.hpp"
+
+#include <Crash2D/counters.hpp>
+#include <Crash2D/polygon.hpp>
+#include <Crash2D/segment.hpp>
+#include <Crash2D/sweep_broadphase.hpp>
+
+#include <thread>
+
+static Polygon Square(const Vector2 &min, const Precision_t size)
+{
+	Polygon p;
+	p.SetPointCount(4);
+	p.SetPoint(0, min);
+	p.SetPoint(1, min + Vector2(size, 0));
+	p.SetPoint(2, min + Vector2(size, size));
+	p.SetPoint(3, min + Vector2(0, size));
+	p.ReCalc();
+
+	return p;
+}
+
+TEST(Counters, Names)
+{
+	EXPECT_STREQ("displacements", Counters::GetName(COUNTER_DISPLACEMENTS));
+	EXPECT_STREQ("bounds_tests", Counters::GetName(COUNTER_BOUNDS_TESTS));
+}
+
+TEST(Counters, Arithmetic)
+{
+	Counters a, b;
+	a.values[COUNTER_AXES] = 5;
+	b.values[COUNTER_AXES] = 2;
+
+	ARE_EQ(3, (a - b)[COUNTER_AXES]);
+	ARE_EQ(7, (a + b)[COUNTER_AXES]);
+	ARE_EQ(0, (a + b)[COUNTER_PROJECTIONS]);
+}
+
+TEST(Counters, Queries)
+{
+	const Polygon a = Square(Vector2(0, 0), 10);
+	const Polygon near = Square(Vector2(5, 5), 10);
+	const Polygon far = Square(Vector2(50, 50), 10);
+
+	ResetCounters();
+
+	EXPECT_TRUE(a.Overlaps(near));
+	const Counters hit = GetThreadCounters();
+
+	EXPECT_FALSE(a.Overlaps(far));
+	const Counters miss = GetThreadCounters() - hit;
+
+	// Nothing is counted unless the library was built with CRASH2D_COUNTERS
+	if (!CountersEnabled())
+	{
+		ARE_EQ(0, hit[COUNTER_AXES]);
+		ARE_EQ(0, GetCounters()[COUNTER_DISPLACEMENTS]);
+		return;
+	}
+
+	// Overlapping shapes test every axis, the first axis already separates the far square
+	ARE_EQ(1, hit[COUNTER_DISPLACEMENTS]);
+	ARE_EQ(2, hit[COUNTER_AXES]);
+	ARE_EQ(0, hit[COUNTER_EARLY_OUTS]);
+	EXPECT_GE(hit[COUNTER_PROJECTIONS], 4u);
+
+	ARE_EQ(1, miss[COUNTER_DISPLACEMENTS]);
+	ARE_EQ(1, miss[COUNTER_AXES]);
+	ARE_EQ(1, miss[COUNTER_EARLY_OUTS]);
+
+	const Segment s(Vector2(-5, 5), Vector2(15, 5));
+	const Counters before = GetThreadCounters();
+	a.GetIntersects(s);
+
+	ARE_EQ(4, (GetThreadCounters() - before)[COUNTER_EDGE_TESTS]);
+}
+
+TEST(Counters, Threads)
+{
+	ResetCounters();
+
+	SweepBroadphase broadphase;
+	broadphase.Insert(0, Bounds(Vector2(0, 0), Vector2(10, 10)));
+	broadphase.Insert(1, Bounds(Vector2(5, 5), Vector2(15, 15)));
+	broadphase.Insert(2, Bounds(Vector2(8, 50), Vector2(20, 60)));
+
+	// Counts made on a thread that has exited still show up in the totals
+	std::thread worker([&broadphase]()
+	{
+		std::vector<ProxyPair> pairs;
+		broadphase.FindPairs(pairs);
+	});
+	worker.join();
+
+	const uint64_t expected = CountersEnabled() ? 3 : 0;
+
+	ARE_EQ(0, GetThreadCounters()[COUNTER_BOUNDS_TESTS]);
+	ARE_EQ(expected, GetCounters()[COUNTER_BOUNDS_TESTS]);
+
+	ResetCounters();
+	ARE_EQ(0, GetCounters()[COUNTER_BOUNDS_TESTS]);
+}
@@ -0,0 +1,80 @@
+#include "helper.hpp"
+
+TEST(EdgeTable, Add)
+{
+	EdgeTable t;
+	t.Add(Vector2(0, 0), Vector2(3, 4));
+
+	ARE_EQ(1, t.GetSize());
+	ARE_EQ(3, t.GetEnd(0).x);
+	ARE_EQ(4, t.GetEnd(0).y);
+	ARE_EQ(3, t.GetDirection(0).x);
+	ARE_EQ(4, t.GetDirection(0).y);
+	ARE_EQ(0.2, t.GetInverseLength(0));
+
+	Segment s(Vector2(0, 0), Vector2(3, 4));
+	ARE_EQ(s.GetAxis().x, t.GetNormal(0).x);
+	ARE_EQ(s.GetAxis().y, t.GetNormal(0).y);
+
+	t.Clear();
+	ARE_EQ(0, t.GetSize());
+}
+
+TEST(EdgeTable, DistancePoint)
+{
+	EdgeTable t;
+	t.Add(Vector2(-10, 5), Vector2(20, -7));
+
+	Segment s(Vector2(-10, 5), Vector2(20, -7));
+
+	const Vector2 points[3] = { Vector2(0, 0), Vector2(50, 50), Vector2(-30, 2) };
+
+	for (auto && p : points)
+		ARE_EQ(s.DistancePoint(p), t.DistancePoint(0, p));
+}
+
+TEST(EdgeTable, Intersect)
+{
+	EdgeTable a;
+	a.Add(Vector2(-50, 0), Vector2(50, 0));
+	a.Add(Vector2(-50, 10), Vector2(50, 10));
+
+	EdgeTable b;
+	b.Add(Vector2(0, -50), Vector2(0, 5));
+
+	Vector2 i;
+	EXPECT_TRUE(a.Intersect(0, b, 0, i));
+	ARE_EQ(0, i.x);
+	ARE_EQ(0, i.y);
+
+	EXPECT_FALSE(a.Intersect(1, b, 0, i));
+}
+
+TEST(EdgeTable, SideView)
+{
+	Polygon p;
+	p.SetPointCount(4);
+	p.SetPoint(0, Vector2(0, 0));
+	p.SetPoint(1, Vector2(10, 0));
+	p.SetPoint(2, Vector2(10, 10));
+	p.SetPoint(3, Vector2(0, 10));
+	p.ReCalc();
+
+	auto sides = p.GetSides();
+	ARE_EQ(4, sides.size());
+	EXPECT_FALSE(sides.empty());
+
+	unsigned i = 0;
+
+	for (auto && s : sides)
+	{
+		ARE_EQ(p.GetPoint(i).x, s.GetPoint(0).x);
+		ARE_EQ(p.GetPoint(i).y, s.GetPoint(0).y);
+		ARE_EQ(p.GetPoint((i + 1) % 4).x, s.GetPoint(1).x);
+		ARE_EQ(p.GetPoint((i + 1) % 4).y, s.GetPoint(1).y);
+		ARE_EQ(10, sides[i].GetLength());
+		i++;
+	}
+
+	ARE_EQ(4, i);
+}
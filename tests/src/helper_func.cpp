@@ -29,6 +29,11 @@ Polygon mPolygon(Polygon p, Vector2 displacement)
 	return pD;
 }
 
+Capsule mCapsule(Capsule c, Vector2 displacement)
+{
+	return Capsule(c.GetPoint(0) + displacement, c.GetPoint(1) + displacement, c.GetRadius());
+}
+
 bool vectorContains(std::vector<Vector2> &coords, Vector2 pt)
 {
 	auto it = std::find(std::begin(coords), std::end(coords), pt);
@@ -0,0 +1,154 @@
+#include "helper.hpp"
+
+#include <Crash2D/memory.hpp>
+#include <Crash2D/polygon.hpp>
+#include <Crash2D/circle.hpp>
+#include <Crash2D/collision.hpp>
+#include <Crash2D/collision_world.hpp>
+#include <Crash2D/SparseSpatialBroadphase.hpp>
+
+#include <cmath>
+#include <memory>
+
+static Polygon* Regular(const unsigned n)
+{
+	Polygon *p = new Polygon();
+	p->SetPointCount(n);
+
+	for (unsigned i = 0; i < n; i++)
+		p->SetPoint(i, Vector2(std::cos(i * 6.2831853f / n), std::sin(i * 6.2831853f / n)) * 10);
+
+	p->ReCalc();
+	return p;
+}
+
+// Counts what passes through it on top of operator new and delete
+class CountingAllocator : public Allocator
+{
+public:
+	CountingAllocator() : allocated(0), freed(0) {}
+
+	virtual void* Allocate(const size_t bytes, const MemoryTag tag) override
+	{
+		allocated += bytes;
+		return ::operator new(bytes);
+	}
+
+	virtual void Deallocate(void *p, const size_t bytes, const MemoryTag tag) override
+	{
+		freed += bytes;
+		::operator delete(p);
+	}
+
+	size_t allocated;
+	size_t freed;
+};
+
+TEST(Memory, Names)
+{
+	EXPECT_STREQ("shapes", MemoryStats::GetName(MEMORY_SHAPES));
+	EXPECT_STREQ("world", MemoryStats::GetName(MEMORY_WORLD));
+}
+
+TEST(Memory, Polygon)
+{
+	const std::unique_ptr<Polygon> small(Regular(4));
+	const std::unique_ptr<Polygon> large(Regular(64));
+
+	// Points, axes, seven arrays of sides and a padded kernel copy
+	EXPECT_GE(small->GetMemoryUsage(), 4 * (sizeof(Vector2) + sizeof(Axis) + 7 * sizeof(Precision_t)));
+	EXPECT_GT(large->GetMemoryUsage(), small->GetMemoryUsage() * 8);
+
+	const Circle c(Vector2(0, 0), 5);
+	ARE_EQ(c.GetPoints().capacity() * sizeof(Vector2), c.GetMemoryUsage());
+}
+
+TEST(Memory, Collision)
+{
+	const std::unique_ptr<Polygon> a(Regular(8));
+	const std::unique_ptr<Polygon> b(Regular(8));
+
+	Transformation t;
+	t.Translate(Vector2(5, 0));
+	b->Transform(t);
+
+	const Collision c = a->GetCollision(*b);
+
+	EXPECT_FALSE(c.GetIntersects().empty());
+	ARE_EQ(c.GetIntersects().capacity() * sizeof(Vector2), c.GetMemoryUsage());
+}
+
+TEST(Memory, SparseSpatialBroadphase)
+{
+	SparseSpatialBroadphase broadphase(10, 10);
+	int a, b;
+
+	// One rectangle over four cells, one inside the first of them
+	broadphase.addRectangle(5, 5, 10, 10, &a);
+	broadphase.addRectangle(1, 1, 2, 2, &b);
+
+	const SparseSpatialBroadphase::MemoryUsage usage = broadphase.getMemoryUsage();
+
+	ARE_EQ(4, usage.cells);
+	ARE_EQ(5, usage.proxies);
+	ARE_EQ(2, usage.maxProxies);
+	EXPECT_GE(usage.buckets, usage.cells);
+	EXPECT_GT(usage.loadFactor, 0);
+	EXPECT_GT(usage.bytes, 5 * sizeof(void*));
+
+	broadphase.clear();
+	ARE_EQ(0, broadphase.getMemoryUsage().cells);
+}
+
+TEST(Memory, Tags)
+{
+	const MemoryStats before = GetMemoryStats();
+
+	{
+		CollisionWorld w;
+
+		for (unsigned i = 0; i < 16; i++)
+			w.Add(Regular(5 + i));
+
+		w.Step();
+
+		const MemoryStats during = GetMemoryStats();
+
+		EXPECT_GT(during.bytes[MEMORY_SHAPES], before.bytes[MEMORY_SHAPES]);
+		EXPECT_GT(during.bytes[MEMORY_BROADPHASE], before.bytes[MEMORY_BROADPHASE]);
+		EXPECT_GT(during.bytes[MEMORY_WORLD], before.bytes[MEMORY_WORLD]);
+		EXPECT_GT(during.allocations[MEMORY_WORLD], before.allocations[MEMORY_WORLD]);
+		EXPECT_GE(during.peak[MEMORY_WORLD], during.bytes[MEMORY_WORLD]);
+		EXPECT_GT(during.GetTotal(), before.GetTotal());
+	}
+
+	const MemoryStats after = GetMemoryStats();
+
+	for (unsigned t = 0; t < MEMORY_TAG_COUNT; t++)
+		ARE_EQ(before.bytes[t], after.bytes[t]);
+}
+
+TEST(Memory, Allocator)
+{
+	ASSERT_EQ(0u, GetMemoryStats().GetTotal());
+
+	CountingAllocator counting;
+	ASSERT_TRUE(SetAllocator(&counting));
+	EXPECT_EQ(&counting, GetAllocator());
+
+	{
+		const std::unique_ptr<Polygon> p(Regular(12));
+		const uint64_t held = GetMemoryStats().GetTotal();
+
+		EXPECT_GT(held, 0u);
+		ARE_EQ(held, counting.allocated - counting.freed);
+
+		// Memory must go back to the allocator that handed it out
+		EXPECT_FALSE(SetAllocator(nullptr));
+		EXPECT_EQ(&counting, GetAllocator());
+	}
+
+	ARE_EQ(counting.allocated, counting.freed);
+	EXPECT_TRUE(SetAllocator(nullptr));
+	EXPECT_EQ(nullptr, GetAllocator());
+}
@@ -0,0 +1,160 @@
+#include "helper.hpp"
+
+TEST(OrientedBox, ConstructorRotation)
+{
+	OrientedBox b(Vector2(0, 0), Vector2(20, 10), 90);
+
+	ARE_EQ(0, b.GetCenter().x);
+	ARE_EQ(0, b.GetCenter().y);
+
+	// Rotated a quarter turn, so the box is 20 wide and 40 tall
+	ARE_EQ(10, b.GetPoint(0).x);
+	ARE_EQ(-20, b.GetPoint(0).y);
+
+	ARE_EQ(-10, b.GetPoint(2).x);
+	ARE_EQ(20, b.GetPoint(2).y);
+}
+
+TEST(OrientedBox, ReCalc)
+{
+	OrientedBox a(Vector2(5, 5), Vector2(20, 10), 30);
+	OrientedBox b;
+
+	for (unsigned i = 0; i < 4; i++)
+		b.SetPoint(i, a.GetPoint(i));
+
+	b.ReCalc();
+
+	ARE_EQ(5, b.GetCenter().x);
+	ARE_EQ(5, b.GetCenter().y);
+	ARE_EQ(20, b.GetHalfExtents().x);
+	ARE_EQ(10, b.GetHalfExtents().y);
+	ARE_EQ(a.GetAxes()[0].x, b.GetAxes()[0].x);
+	ARE_EQ(a.GetAxes()[0].y, b.GetAxes()[0].y);
+}
+
+TEST(OrientedBox, Project)
+{
+	OrientedBox b(Vector2(3, -2), Vector2(20, 10), 30);
+	Polygon p = mPolygon(b, Vector2(0, 0));
+
+	const Axis axes[3] = { Axis(1, 0), Axis(0, 1), Axis(1, 2).Normalize() };
+
+	for (auto && a : axes)
+	{
+		Projection pB = b.Project(a);
+		Projection pP = p.Project(a);
+
+		ARE_EQ(pP.min, pB.min);
+		ARE_EQ(pP.max, pB.max);
+	}
+}
+
+TEST(OrientedBox, ContainsPoint)
+{
+	OrientedBox b(Vector2(0, 0), Vector2(20, 10), 45);
+
+	EXPECT_TRUE(b.Contains(Vector2(10, 10)));
+	EXPECT_FALSE(b.Contains(Vector2(15, 0)));
+}
+
+TEST(OrientedBox, OverlapsOrientedBox)
+{
+	OrientedBox a(Vector2(0, 0), Vector2(20, 10), 45);
+	Polygon pA = mPolygon(a, Vector2(0, 0));
+
+	const Vector2 offsets[3] = { Vector2(15, 15), Vector2(0, 20), Vector2(30, -30) };
+
+	for (auto && o : offsets)
+	{
+		OrientedBox b(o, Vector2(10, 5), 10);
+		Polygon pB = mPolygon(b, Vector2(0, 0));
+
+		EXPECT_EQ(pA.Overlaps(pB), a.Overlaps(b));
+	}
+}
+
+TEST(OrientedBox, GetDisplacementOrientedBox)
+{
+	OrientedBox a(Vector2(0, 0), Vector2(20, 10), 45);
+	OrientedBox b(Vector2(10, 10), Vector2(10, 5), 10);
+
+	Polygon pA = mPolygon(a, Vector2(0, 0));
+	Polygon pB = mPolygon(b, Vector2(0, 0));
+
+	auto d = a.GetDisplacement(b);
+	auto dP = pA.GetDisplacement(pB);
+
+	ARE_EQ(dP.Length(), d.Length());
+	EXPECT_FALSE(pA.Overlaps(mPolygon(pB, d * 1.01)));
+}
+
+TEST(OrientedBox, GetDisplacementCircle)
+{
+	OrientedBox b(Vector2(0, 0), Vector2(50, 20), 30);
+	Polygon p = mPolygon(b, Vector2(0, 0));
+
+	const Circle circles[3] = { Circle(Vector2(0, 0), 10), Circle(Vector2(40, 30), 20), Circle(Vector2(-50, -10), 30) };
+
+	for (auto && c : circles)
+	{
+		auto d = b.GetDisplacement(c);
+		auto dP = p.GetDisplacement(c);
+
+		ARE_EQ(dP.Length(), d.Length());
+		EXPECT_FALSE(b.Overlaps(mCircle(c, d)));
+	}
+}
+
+TEST(OrientedBox, GetGollisionCircle)
+{
+	OrientedBox b(Vector2(0, 0), Vector2(50, 20), 30);
+	Circle c(Vector2(40, 30), 20);
+
+	Collision col = b.GetCollision(c);
+	ARE_EQ(b.Overlaps(c), col.Overlaps());
+	ARE_EQ(b.Contains(c), col.AcontainsB());
+	ARE_EQ(c.Contains(b), col.BcontainsA());
+
+	auto iC = col.GetIntersects();
+	auto iF = b.GetIntersects(c);
+
+	EXPECT_TRUE(vectorEQ(iC, iF));
+
+	auto dC = col.GetDisplacement();
+	auto dF = b.GetDisplacement(c);
+
+	ARE_EQ(dC.x, dF.x);
+	ARE_EQ(dC.y, dF.y);
+}
+
+TEST(OrientedBox, Transform)
+{
+	OrientedBox b(Vector2(0, 0), Vector2(20, 10));
+
+	Transformation t;
+	t.SetRotation(90);
+	t.Translate(Vector2(5, 0));
+	b.Transform(t);
+
+	ARE_EQ(5, b.GetCenter().x);
+	ARE_EQ(0, b.GetCenter().y);
+	ARE_EQ(20, b.GetHalfExtents().x);
+	ARE_EQ(10, b.GetHalfExtents().y);
+	ARE_EQ(0, b.GetAxes()[0].x);
+	ARE_EQ(1, b.GetAxes()[0].y);
+}
+
+// Double Disbatch tests
+
+TEST(OrientedBox, GetDisplacementShape)
+{
+	ShapePtr aP(new OrientedBox(Vector2(0, 0), Vector2(20, 10), 45));
+	ShapePtr bP(new Box(Vector2(10, 10), Vector2(10, 5)));
+
+	OrientedBox aO = *dynamic_cast<OrientedBox*>(aP.get());
+	Box bO = *dynamic_cast<Box*>(bP.get());
+
+	EXPECT_EQ(aP->GetDisplacement(*bP), aO.GetDisplacement(bO));
+	EXPECT_EQ(bP->GetDisplacement(*aP), -aO.GetDisplacement(bO));
+}
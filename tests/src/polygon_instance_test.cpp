@@ -0,0 +1,94 @@
+#include "helper.hpp"
+
+#include <Crash2D/polygon_instance.hpp>
+
+static GeometryPtr Hull()
+{
+	std::vector<Vector2> points;
+
+	for (unsigned i = 0; i < 8; i++)
+	{
+		const Precision_t angle = (2 * M_PI * i) / 8;
+		points.push_back(Vector2(std::cos(angle) * 20, std::sin(angle) * 12));
+	}
+
+	return std::make_shared<const PolygonGeometry>(points);
+}
+
+TEST(PolygonInstance, Geometry)
+{
+	GeometryPtr g = Hull();
+
+	ARE_EQ(8, g->GetPoints().size());
+	ARE_EQ(4, g->GetAxes().size());
+	ARE_EQ(0, g->GetCenter().x);
+	ARE_EQ(0, g->GetCenter().y);
+	ARE_EQ(8, g->GetVertices().GetSize());
+}
+
+TEST(PolygonInstance, SharesGeometry)
+{
+	GeometryPtr g = Hull();
+
+	std::vector<PolygonInstance> crates;
+
+	for (unsigned i = 0; i < 10; i++)
+		crates.push_back(PolygonInstance(g, AffineMatrix(Transformation(Vector2(1, 1), 0, Vector2(i * 30, 0)))));
+
+	ARE_EQ(11, g.use_count());
+	EXPECT_EQ(g.get(), crates[9].GetGeometry().get());
+	EXPECT_LT(sizeof(PolygonInstance), sizeof(Polygon));
+}
+
+TEST(PolygonInstance, Project)
+{
+	const PolygonInstance a(Hull(), AffineMatrix(Transformation(Vector2(1, 2), 30, Vector2(5, -3))));
+	const Polygon p = a.ToPolygon();
+
+	const Axis axes[3] = { Axis(1, 0), Axis(0, 1), Axis(3, 4).Normalize() };
+
+	for (auto && axis : axes)
+	{
+		ARE_EQ(p.Project(axis).min, a.Project(axis).min);
+		ARE_EQ(p.Project(axis).max, a.Project(axis).max);
+	}
+
+	ARE_EQ(p.GetCenter().x, a.GetCenter().x);
+	ARE_EQ(p.GetCenter().y, a.GetCenter().y);
+}
+
+TEST(PolygonInstance, Contains)
+{
+	PolygonInstance a(Hull());
+	a.Transform(Transformation(Vector2(1, 1), 90, Vector2(100, 0)));
+
+	EXPECT_TRUE(a.Contains(Vector2(100, 15)));
+	EXPECT_FALSE(a.Contains(Vector2(115, 0)));
+	EXPECT_FALSE(a.Contains(Vector2(0, 0)));
+}
+
+TEST(PolygonInstance, OverlapsAndDisplacement)
+{
+	GeometryPtr g = Hull();
+
+	const PolygonInstance a(g, AffineMatrix(Transformation(Vector2(1, 1), 20, Vector2(0, 0))));
+
+	const Vector2 offsets[4] = { Vector2(10, 5), Vector2(30, -8), Vector2(0, 20), Vector2(80, 0) };
+
+	for (auto && o : offsets)
+	{
+		const PolygonInstance b(g, AffineMatrix(Transformation(Vector2(1, 1), 75, o)));
+
+		const Polygon pA = a.ToPolygon();
+		const Polygon pB = b.ToPolygon();
+
+		EXPECT_EQ(pA.Overlaps(pB), a.Overlaps(b));
+		EXPECT_EQ(pB.Overlaps(pA), b.Overlaps(a));
+
+		const Vector2 expected = pA.GetDisplacement(pB);
+		const Vector2 actual = a.GetDisplacement(b);
+
+		ARE_EQ(expected.x, actual.x);
+		ARE_EQ(expected.y, actual.y);
+	}
+}
@@ -1,5 +1,7 @@
 #include "helper.hpp"
 
+#include <thread>
+
 TEST(Polygon, DefaultConstructor)
 {
 	Polygon p;
@@ -29,6 +31,40 @@ TEST(Polygon, GenerateAxis)
 	ARE_EQ(2 / std::sqrt(5), axes[2].y);
 }
 
+TEST(Polygon, GenerateAxisParallel)
+{
+	// Opposite sides of a hexagon share an axis
+	Polygon p;
+	p.SetPointCount(6);
+
+	for (unsigned i = 0; i < 6; i++)
+	{
+		const Precision_t angle = (2 * M_PI * i) / 6 + 0.3;
+		p.SetPoint(i, Vector2(std::cos(angle) * 50, std::sin(angle) * 50));
+	}
+
+	p.ReCalc();
+
+	AxesVec axes = p.GetAxes();
+	ARE_EQ(3, axes.size());
+
+	for (unsigned i = 0; i < axes.size(); i++)
+	{
+		for (unsigned j = i + 1; j < axes.size(); j++)
+			EXPECT_GT(std::abs(axes[i].Cross(axes[j])), PARALLEL_TOLERANCE);
+	}
+
+	// Sides either side of vertical wrap around the canonical order
+	AxesVec wrap = { Axis(0, 1), Axis(1, 0), Axis(1e-6, -1).Normalize(), Axis(-1e-6, 1).Normalize() };
+	ShapeImpl::RemoveParallelAxes(wrap);
+
+	ARE_EQ(2, wrap.size());
+	ARE_EQ(0, wrap[0].x);
+	ARE_EQ(1, wrap[0].y);
+	ARE_EQ(1, wrap[1].x);
+	ARE_EQ(0, wrap[1].y);
+}
+
 TEST(Polygon, GetCenter)
 {
 	Polygon p;
@@ -392,6 +428,58 @@ TEST(Polygon, GetIntersectsPolygon)
 	ARE_EQ(0, i.size());
 }
 
+TEST(Polygon, GetIntersectsPolygonManySides)
+{
+	// Jagged outlines with enough sides to take the sweep path
+	auto star = [](Vector2 center, unsigned n)
+	{
+		Polygon p;
+		p.SetPointCount(n);
+
+		for (unsigned i = 0; i < n; i++)
+		{
+			const Precision_t angle = (2 * M_PI * i) / n;
+			const Precision_t radius = (i % 2 == 0) ? 100 : 80;
+			p.SetPoint(i, center + Vector2(std::cos(angle) * radius, std::sin(angle) * radius));
+		}
+
+		p.ReCalc();
+		return p;
+	};
+
+	Polygon a = star(Vector2(0, 0), 200);
+	Polygon b = star(Vector2(30, 10), 150);
+
+	ASSERT_GT(a.GetSides().size() + b.GetSides().size(), SWEEP_THRESHOLD);
+
+	std::vector<Vector2> expected;
+
+	for (auto && sA : a.GetSides())
+	{
+		for (auto && sB : b.GetSides())
+		{
+			auto i = sA.GetIntersects(sB);
+
+			if (i.size() > 0 && !vectorContains(expected, i[0]))
+				expected.push_back(i[0]);
+		}
+	}
+
+	auto i = a.GetIntersects(b);
+
+	EXPECT_GT(i.size(), 2);
+	ARE_EQ(expected.size(), i.size());
+
+	for (unsigned j = 0; j < std::min(expected.size(), i.size()); j++)
+	{
+		ARE_EQ(expected[j].x, i[j].x);
+		ARE_EQ(expected[j].y, i[j].y);
+	}
+
+	i = a.GetIntersects(mPolygon(b, Vector2(500, 0)));
+	ARE_EQ(0, i.size());
+}
+
 TEST(Polygon, GetDisplacementSegment)
 {
 	Polygon p;
@@ -748,3 +836,155 @@ TEST(Polygon, GetGollisionShape)
 	ARE_EQ(colPtr.GetDisplacement().x, colObj.GetDisplacement().x);
 	ARE_EQ(colPtr.GetDisplacement().y, colObj.GetDisplacement().y);
 }
+
+static Polygon Pentagon()
+{
+	Polygon p;
+	p.SetPointCount(5);
+	p.SetPoint(0, Vector2(0, 0));
+	p.SetPoint(1, Vector2(40, -5));
+	p.SetPoint(2, Vector2(55, 20));
+	p.SetPoint(3, Vector2(30, 45));
+	p.SetPoint(4, Vector2(-5, 30));
+	p.ReCalc();
+
+	return p;
+}
+
+TEST(Polygon, LocalSpaceTransform)
+{
+	Transformation t(Vector2(2, 1.5), 35, Vector2(12, -4));
+	t.SetPivot(Vector2(10, 10));
+
+	Polygon eager = Pentagon();
+	eager.Transform(t);
+	eager.Transform(t);
+
+	Polygon local = Pentagon();
+	local.SetLocalSpace(true);
+	local.Transform(t);
+	local.Transform(t);
+
+	EXPECT_TRUE(local.IsLocalSpace());
+	ARE_EQ(0, local.GetLocalPoints()[0].x);
+	ARE_EQ(0, local.GetLocalPoints()[0].y);
+
+	ARE_EQ(eager.GetPointCount(), local.GetPointCount());
+
+	for (unsigned i = 0; i < eager.GetPointCount(); i++)
+	{
+		ARE_EQ(eager.GetPoint(i).x, local.GetPoint(i).x);
+		ARE_EQ(eager.GetPoint(i).y, local.GetPoint(i).y);
+	}
+
+	ARE_EQ(eager.GetCenter().x, local.GetCenter().x);
+	ARE_EQ(eager.GetCenter().y, local.GetCenter().y);
+
+	// Transformed axes match rebuilt axes up to direction
+	ASSERT_EQ(eager.GetAxes().size(), local.GetAxes().size());
+
+	for (auto && a : local.GetAxes())
+	{
+		bool found = false;
+
+		for (auto && b : eager.GetAxes())
+			found |= std::abs(a.Cross(b)) < 1e-4;
+
+		EXPECT_TRUE(found);
+	}
+
+	ASSERT_EQ(eager.GetSides().size(), local.GetSides().size());
+
+	for (unsigned i = 0; i < eager.GetSides().size(); i++)
+	{
+		ARE_EQ(eager.GetSides()[i].GetPoint(0).x, local.GetSides()[i].GetPoint(0).x);
+		ARE_EQ(eager.GetSides()[i].GetPoint(1).y, local.GetSides()[i].GetPoint(1).y);
+	}
+}
+
+TEST(Polygon, LocalSpaceCollision)
+{
+	Polygon a = Pentagon();
+
+	Polygon eager = Pentagon();
+	eager.Transform(Transformation(Vector2(1, 1), 60, Vector2(30, 10)));
+
+	Polygon local = Pentagon();
+	local.SetTransform(AffineMatrix(Transformation(Vector2(1, 1), 60, Vector2(30, 10))));
+
+	EXPECT_EQ(a.Overlaps(eager), a.Overlaps(local));
+	EXPECT_EQ(local.Overlaps(a), eager.Overlaps(a));
+
+	const Vector2 dE = a.GetDisplacement(eager);
+	const Vector2 dL = a.GetDisplacement(local);
+	ARE_EQ(dE.x, dL.x);
+	ARE_EQ(dE.y, dL.y);
+
+	auto iE = a.GetIntersects(eager);
+	auto iL = a.GetIntersects(local);
+	EXPECT_TRUE(vectorEQ(iE, iL));
+
+	Circle c(Vector2(35, 20), 5);
+	EXPECT_EQ(eager.Contains(c), local.Contains(c));
+}
+
+TEST(Polygon, LocalSpaceRefresh)
+{
+	Polygon eager = Pentagon();
+	eager.Transform(Transformation(Vector2(1, 1), 60, Vector2(30, 10)));
+
+	Polygon local = Pentagon();
+	local.SetTransform(AffineMatrix(Transformation(Vector2(1, 1), 60, Vector2(30, 10))));
+	local.Refresh();
+
+	// Nothing is left to rebuild, so several threads may query the polygon at once
+	const Circle c(Vector2(35, 20), 5);
+	bool results[4];
+	std::vector<std::thread> threads;
+
+	for (unsigned i = 0; i < 4; i++)
+		threads.emplace_back([&local, &c, &results, i]() { results[i] = local.Overlaps(c); });
+
+	for (auto && t : threads)
+		t.join();
+
+	for (auto && r : results)
+		EXPECT_EQ(eager.Overlaps(c), r);
+
+	ARE_EQ(eager.GetPoint(2).x, local.GetPoint(2).x);
+	ARE_EQ(eager.GetPoint(2).y, local.GetPoint(2).y);
+}
+
+TEST(Polygon, LocalSpaceEditAndLeave)
+{
+	Polygon p = Pentagon();
+	p.SetTransform(AffineMatrix(Transformation(Vector2(1, 1), 0, Vector2(100, 0))));
+
+	// Points set in local space are local
+	p.SetPoint(0, Vector2(-10, -10));
+	p.ReCalc();
+
+	ARE_EQ(-10, p.GetLocalPoints()[0].x);
+	ARE_EQ(90, p.GetPoint(0).x);
+	ARE_EQ(-10, p.GetPoint(0).y);
+
+	// Leaving local space keeps the world points
+	p.SetLocalSpace(false);
+	EXPECT_FALSE(p.IsLocalSpace());
+	ARE_EQ(90, p.GetPoint(0).x);
+
+	p.Transform(Transformation(Vector2(1, 1), 0, Vector2(5, 0)));
+	ARE_EQ(95, p.GetPoint(0).x);
+}
+
+TEST(Polygon, LocalSpaceOrientedBox)
+{
+	// Boxes always stay in world space
+	OrientedBox b(Vector2(0, 0), Vector2(10, 5), 30);
+	b.SetLocalSpace(true);
+	EXPECT_FALSE(b.IsLocalSpace());
+
+	b.SetTransform(AffineMatrix(Transformation(Vector2(1, 1), 0, Vector2(100, 0))));
+	EXPECT_FALSE(b.IsLocalSpace());
+	ARE_EQ(0, b.GetCenter().x);
+}
@@ -0,0 +1,117 @@
+#include "helper.hpp"
+
+#include <Crash2D/projection_kernel.hpp>
+
+static std::vector<Vector2> Points(unsigned n)
+{
+	std::vector<Vector2> points;
+
+	for (unsigned i = 0; i < n; i++)
+		points.push_back(Vector2(std::cos(i * 1.3f) * (10 + i), std::sin(i * 0.7f) * (20 - i)));
+
+	return points;
+}
+
+static Projection ProjectScalar(const std::vector<Vector2> &points, const Axis &a)
+{
+	Precision_t min = a.Dot(points[0]);
+	Precision_t max = min;
+
+	for (auto && pt : points)
+	{
+		min = std::min(min, a.Dot(pt));
+		max = std::max(max, a.Dot(pt));
+	}
+
+	return Projection(min, max);
+}
+
+TEST(ProjectionKernel, ProjectPoints)
+{
+	const Axis axis = Axis(3, -1).Normalize();
+
+	for (unsigned n = 1; n <= 9; n++)
+	{
+		auto points = Points(n);
+
+		PointArray p;
+		p.Assign(points);
+		ARE_EQ(n, p.GetSize());
+
+		Projection expected = ProjectScalar(points, axis);
+		Projection actual = ProjectPoints(p, axis);
+
+		EXPECT_EQ(expected.min, actual.min);
+		EXPECT_EQ(expected.max, actual.max);
+	}
+}
+
+TEST(ProjectionKernel, ProjectPointsAxes)
+{
+	auto points = Points(7);
+
+	PointArray p;
+	p.Assign(points);
+
+	for (unsigned n = 1; n <= 9; n++)
+	{
+		AxesVec axes;
+
+		for (unsigned i = 0; i < n; i++)
+			axes.push_back(Axis(std::cos(i * 0.4f), std::sin(i * 0.4f)));
+
+		std::vector<Projection> out(n);
+		ProjectPoints(p, axes.data(), n, out.data());
+
+		for (unsigned i = 0; i < n; i++)
+		{
+			Projection expected = ProjectScalar(points, axes[i]);
+
+			EXPECT_EQ(expected.min, out[i].min);
+			EXPECT_EQ(expected.max, out[i].max);
+		}
+	}
+}
+
+TEST(ProjectionKernel, SeparatePoints)
+{
+	Polygon a;
+	a.SetPointCount(5);
+	a.SetPoint(0, Vector2(0, 0));
+	a.SetPoint(1, Vector2(40, -5));
+	a.SetPoint(2, Vector2(55, 20));
+	a.SetPoint(3, Vector2(30, 45));
+	a.SetPoint(4, Vector2(-5, 30));
+	a.ReCalc();
+
+	const Vector2 offsets[3] = { Vector2(20, 10), Vector2(50, 40), Vector2(100, 0) };
+
+	for (auto && o : offsets)
+	{
+		Polygon b = mPolygon(a, o);
+
+		AxesVec axes = a.GetAxes();
+		axes.insert(axes.end(), b.GetAxes().begin(), b.GetAxes().end());
+
+		PointArray pA, pB;
+		pA.Assign(a.GetPoints());
+		pB.Assign(b.GetPoints());
+
+		Precision_t overlap;
+		const Vector2 d = SeparatePoints(axes, pA, pB, overlap);
+
+		ARE_EQ(a.CalcDisplacement(axes, a, b).x, d.x);
+		ARE_EQ(a.CalcDisplacement(axes, a, b).y, d.y);
+		ARE_EQ(a.GetOverlap(axes, a, b), overlap);
+	}
+}
+
+TEST(ProjectionKernel, Empty)
+{
+	PointArray p;
+	p.Assign(std::vector<Vector2>());
+
+	Projection pr = ProjectPoints(p, Axis(1, 0));
+	ARE_EQ(0, pr.min);
+	ARE_EQ(0, pr.max);
+}
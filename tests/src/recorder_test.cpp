@@ -0,0 +1,309 @@
+#include "helper.hpp"
+
+#include <Crash2D/recorder.hpp>
+#include <Crash2D/replayer.hpp>
+#include <Crash2D/circle.hpp>
+#include <Crash2D/segment.hpp>
+#include <Crash2D/capsule.hpp>
+#include <Crash2D/box.hpp>
+
+#include <sstream>
+
+static Polygon* Triangle(const Vector2 &c, Precision_t h)
+{
+	Polygon *p = new Polygon();
+	p->SetPointCount(3);
+	p->SetPoint(0, c + Vector2(-h, -h));
+	p->SetPoint(1, c + Vector2(h, -h));
+	p->SetPoint(2, c + Vector2(0, h));
+	p->ReCalc();
+
+	return p;
+}
+
+// Every kind of call a recording holds, with overlaps that change from step to step
+static std::vector<uint64_t> Record(CollisionWorld &w)
+{
+	std::vector<uint64_t> hashes;
+	std::vector<ShapeHandle> shapes;
+
+	w.SetSleepDelay(3);
+
+	shapes.push_back(w.Add(new Circle(Vector2(0, 0), 10)));
+	shapes.push_back(w.Add(new Segment(Vector2(-20, 5), Vector2(20, 5))));
+	shapes.push_back(w.Add(new Capsule(Vector2(30, 0), Vector2(40, 0), 5)));
+	shapes.push_back(w.Add(Triangle(Vector2(10, 10), 8)));
+	shapes.push_back(w.Add(new OrientedBox(Vector2(50, 0), Vector2(10, 4), 0.5f)));
+	shapes.push_back(w.Add(new Box(Vector2(0, -20), Vector2(60, 5)), MOTION_STATIC));
+	shapes.push_back(w.Add(new Circle(Vector2(20, 0), 6), MOTION_DYNAMIC, CollisionFilter(2, 1)));
+
+	Polygon *local = Triangle(Vector2(25, 10), 6);
+	local->SetLocalSpace(true);
+	shapes.push_back(w.Add(local));
+
+	for (unsigned step = 0; step < 12; step++)
+	{
+		Transformation t;
+		t.Translate(Vector2(2, -1));
+		t.SetPivot(w.Get(shapes[step % 5])->GetCenter());
+		t.Rotate(7);
+		w.Transform(shapes[step % 5], t);
+
+		if (step == 2)
+		{
+			dynamic_cast<Circle*>(w.Get(shapes[6]))->SetRadius(12);
+			w.MarkMoved(shapes[6]);
+		}
+
+		if (step == 3)
+			w.Transform(shapes[7], t);
+
+		if (step == 4)
+			w.SetFilter(shapes[6], CollisionFilter());
+
+		if (step == 5)
+			w.Sleep(shapes[7]);
+
+		if (step == 7)
+		{
+			w.Wake(shapes[7]);
+			w.Remove(shapes[1]);
+			shapes[1] = w.Add(new Segment(Vector2(0, -30), Vector2(0, 30)));
+		}
+
+		w.Step();
+		hashes.push_back(w.GetContactHash());
+	}
+
+	return hashes;
+}
+
+TEST(Recorder, RoundTrip)
+{
+	std::stringstream stream;
+	Recorder recorder(stream);
+
+	CollisionWorld recorded;
+	EXPECT_TRUE(recorded.SetRecorder(&recorder));
+	const std::vector<uint64_t> hashes = Record(recorded);
+
+	EXPECT_TRUE(recorder.IsGood());
+
+	CollisionWorld replayed;
+	Replayer replayer(stream);
+	ReplayStep step;
+
+	unsigned steps = 0;
+
+	while (replayer.Next(replayed, step))
+	{
+		EXPECT_TRUE(step.Matches()) << "step " << steps;
+		EXPECT_EQ(hashes[steps], step.hash);
+		EXPECT_GE(step.seconds, 0);
+		steps++;
+	}
+
+	EXPECT_EQ("", replayer.GetError());
+	ARE_EQ(hashes.size(), steps);
+	ARE_EQ(recorded.GetShapeCount(), replayed.GetShapeCount());
+	EXPECT_GT(recorded.GetContacts().size(), 0u);
+	EXPECT_EQ(recorded.GetContactHash(), replayed.GetContactHash());
+}
+
+TEST(Recorder, AttachEmptyOnly)
+{
+	std::stringstream stream;
+	Recorder recorder(stream);
+
+	CollisionWorld w;
+	const ShapeHandle h = w.Add(new Circle(Vector2(0, 0), 1));
+	w.Remove(h);
+
+	// Even a removed shape leaves a slot the replay would not hand out the same way
+	EXPECT_FALSE(w.SetRecorder(&recorder));
+	EXPECT_EQ(nullptr, w.GetRecorder());
+	EXPECT_TRUE(w.SetRecorder(nullptr));
+}
+
+TEST(Recorder, Mismatch)
+{
+	std::stringstream stream;
+	Recorder recorder(stream);
+
+	CollisionWorld w;
+	w.SetRecorder(&recorder);
+	w.Add(new Circle(Vector2(0, 0), 10));
+	w.Add(new Circle(Vector2(15, 0), 10));
+	w.Step();
+
+	// Moves the second circle away in the recording, so the replay finds no contact
+	std::string bytes = stream.str();
+	const Precision_t near = 15, far = 100;
+	const size_t x = bytes.find(std::string(reinterpret_cast<const char*>(&near), sizeof(near)));
+
+	ASSERT_NE(std::string::npos, x);
+	bytes.replace(x, sizeof(far), reinterpret_cast<const char*>(&far), sizeof(far));
+
+	std::istringstream in(bytes);
+	Replayer replayer(in);
+	CollisionWorld replayed;
+	ReplayStep step;
+
+	EXPECT_TRUE(replayer.Next(replayed, step));
+	EXPECT_FALSE(step.Matches());
+	ARE_EQ(1, step.expectedContacts);
+	ARE_EQ(0, step.contacts);
+}
+
+TEST(Recorder, Corrupt)
+{
+	CollisionWorld w;
+	ReplayStep step;
+
+	std::istringstream garbage("not a recording");
+	Replayer bad(garbage);
+	EXPECT_FALSE(bad.Next(w, step));
+	EXPECT_EQ("Not a recording", bad.GetError());
+
+	std::stringstream stream;
+	Recorder recorder(stream);
+	w.SetRecorder(&recorder);
+	w.Add(new Circle(Vector2(0, 0), 10));
+	w.Step();
+	w.SetRecorder(nullptr);
+
+	// Cut off in the middle of the circle
+	const std::string bytes = stream.str();
+	std::istringstream truncated(bytes.substr(0, 30));
+
+	CollisionWorld replayed;
+	Replayer cut(truncated);
+	EXPECT_FALSE(cut.Next(replayed, step));
+	EXPECT_EQ("Truncated recording", cut.GetError());
+}
+
+// A shape of a kind a recording cannot hold, it is never queried
+class Blob : public ShapeImpl
+{
+public:
+	virtual const Projection Project(const Axis &a) const override { return Projection(0, 0); }
+	virtual const bool Contains(const Shape &s) const override { return false; }
+	virtual const bool Contains(const Vector2 &v) const override { return false; }
+	virtual const bool Contains(const Segment &s) const override { return false; }
+	virtual const bool Contains(const Circle &c) const override { return false; }
+	virtual const bool Contains(const Polygon &p) const override { return false; }
+	virtual const bool Contains(const Capsule &c) const override { return false; }
+	virtual const bool IsInside(const Shape &s) const override { return false; }
+	virtual const bool IsInside(const Segment &s) const override { return false; }
+	virtual const bool IsInside(const Circle &c) const override { return false; }
+	virtual const bool IsInside(const Polygon &p) const override { return false; }
+	virtual const bool IsInside(const Capsule &c) const override { return false; }
+	virtual const bool Overlaps(const Shape &s) const override { return false; }
+	virtual const bool Overlaps(const Segment &s) const override { return false; }
+	virtual const bool Overlaps(const Circle &c) const override { return false; }
+	virtual const bool Overlaps(const Polygon &p) const override { return false; }
+	virtual const bool Overlaps(const Capsule &c) const override { return false; }
+	virtual const std::vector<Vector2> GetIntersects(const Shape &s) const override { return {}; }
+	virtual const std::vector<Vector2> GetIntersects(const Segment &s) const override { return {}; }
+	virtual const std::vector<Vector2> GetIntersects(const Circle &c) const override { return {}; }
+	virtual const std::vector<Vector2> GetIntersects(const Polygon &p) const override { return {}; }
+	virtual const std::vector<Vector2> GetIntersects(const Capsule &c) const override { return {}; }
+	virtual const Vector2 GetDisplacement(const Shape &s) const override { return Vector2(0, 0); }
+	virtual const Vector2 GetDisplacement(const Segment &s) const override { return Vector2(0, 0); }
+	virtual const Vector2 GetDisplacement(const Circle &c) const override { return Vector2(0, 0); }
+	virtual const Vector2 GetDisplacement(const Polygon &p) const override { return Vector2(0, 0); }
+	virtual const Vector2 GetDisplacement(const Capsule &c) const override { return Vector2(0, 0); }
+	virtual const Collision GetCollision(const Shape &s) const override { return Collision(); }
+	virtual const Collision GetCollision(const Segment &s) const override { return Collision(); }
+	virtual const Collision GetCollision(const Circle &c) const override { return Collision(); }
+	virtual const Collision GetCollision(const Polygon &p) const override { return Collision(); }
+	virtual const Collision GetCollision(const Capsule &c) const override { return Collision(); }
+	virtual const Projection Project(const Shape &s, const Axis &a) const override { return Projection(0, 0); }
+	virtual Shape* Clone() override { return new Blob(*this); }
+};
+
+TEST(Recorder, Unsupported)
+{
+	std::stringstream stream;
+	Recorder recorder(stream);
+
+	const Circle circle(Vector2(0, 0), 10);
+	const Blob blob;
+
+	recorder.Add(ShapeHandle{ 0, 0 }, circle, MOTION_DYNAMIC, CollisionFilter());
+	recorder.Add(ShapeHandle{ 1, 0 }, blob, MOTION_DYNAMIC, CollisionFilter());
+
+	EXPECT_FALSE(recorder.IsGood());
+
+	// Nothing is written after the marker
+	const size_t size = stream.str().size();
+	recorder.Add(ShapeHandle{ 2, 0 }, circle, MOTION_DYNAMIC, CollisionFilter());
+	recorder.Step(0, 0);
+
+	ARE_EQ(size, stream.str().size());
+
+	// The replay stops at the marker instead of reading past it
+	CollisionWorld replayed;
+	Replayer replayer(stream);
+	ReplayStep step;
+
+	EXPECT_FALSE(replayer.Next(replayed, step));
+	EXPECT_EQ("The recording holds a shape that could not be recorded", replayer.GetError());
+	ARE_EQ(1, replayed.GetShapeCount());
+}
+
+TEST(Recorder, BadMotionType)
+{
+	std::stringstream stream;
+	Recorder recorder(stream);
+
+	CollisionWorld w;
+	w.SetRecorder(&recorder);
+	w.Add(new Circle(Vector2(0, 0), 10));
+	w.Step();
+	w.SetRecorder(nullptr);
+
+	// The motion type follows the header, the operation and the handle
+	std::string bytes = stream.str();
+	const size_t type = 2 * sizeof(uint32_t) + 1 + 2 * sizeof(uint32_t);
+
+	ASSERT_EQ(static_cast<char>(MOTION_DYNAMIC), bytes[type]);
+	bytes[type] = 7;
+
+	std::istringstream in(bytes);
+	CollisionWorld replayed;
+	Replayer replayer(in);
+	ReplayStep step;
+
+	EXPECT_FALSE(replayer.Next(replayed, step));
+	EXPECT_EQ("Unknown motion type 7", replayer.GetError());
+	ARE_EQ(0, replayed.GetShapeCount());
+}
+
+TEST(Recorder, DegeneratePolygon)
+{
+	std::stringstream stream;
+	Recorder recorder(stream);
+
+	CollisionWorld w;
+	w.SetRecorder(&recorder);
+	w.Add(Triangle(Vector2(0, 0), 10));
+	w.Step();
+	w.SetRecorder(nullptr);
+
+	// The point count follows the add, the filter, the shape kind and the local flag
+	std::string bytes = stream.str();
+	const size_t count = 2 * sizeof(uint32_t) + 1 + 2 * sizeof(uint32_t) + 1 + 3 * sizeof(uint32_t) + 1 + 1;
+
+	ASSERT_EQ(3, bytes[count]);
+	bytes[count] = 2;
+
+	std::istringstream in(bytes);
+	CollisionWorld replayed;
+	Replayer replayer(in);
+	ReplayStep step;
+
+	EXPECT_FALSE(replayer.Next(replayed, step));
+	EXPECT_EQ("Polygon with 2 points", replayer.GetError());
+	ARE_EQ(0, replayed.GetShapeCount());
+}
@@ -0,0 +1,216 @@
+#include "helper.hpp"
+
+#include <Crash2D/shape_pool.hpp>
+#include <Crash2D/box.hpp>
+#include <Crash2D/capsule.hpp>
+#include <Crash2D/circle.hpp>
+#include <Crash2D/segment.hpp>
+
+#include <new>
+#include <stdexcept>
+
+static Polygon MakePolygon(const std::vector<Vector2> &points)
+{
+	Polygon p;
+	p.SetPointCount(points.size());
+
+	for (unsigned i = 0; i < points.size(); i++)
+		p.SetPoint(i, points[i]);
+
+	p.ReCalc();
+	return p;
+}
+
+TEST(ShapePool, CreateDestroy)
+{
+	ShapePool pool(4);
+
+	const PoolHandle a = pool.Create<Circle>(Vector2(0, 0), 1);
+	const PoolHandle b = pool.Create<Circle>(Vector2(3, 0), 1);
+
+	ARE_EQ(2, pool.GetCount());
+	ASSERT_TRUE(pool.IsValid(a));
+	EXPECT_EQ(Vector2(3, 0), pool.Get(b)->GetCenter());
+
+	pool.Destroy(a);
+
+	ARE_EQ(1, pool.GetCount());
+	EXPECT_FALSE(pool.IsValid(a));
+	EXPECT_EQ(nullptr, pool.Get(a));
+
+	// Destroying twice is ignored
+	pool.Destroy(a);
+	ARE_EQ(1, pool.GetCount());
+
+	// The slot is reused, but the stale handle stays invalid
+	const PoolHandle c = pool.Create<Circle>(Vector2(6, 0), 2);
+
+	ARE_EQ(a.index, c.index);
+	EXPECT_NE(a, c);
+	EXPECT_FALSE(pool.IsValid(a));
+	ASSERT_TRUE(pool.IsValid(c));
+}
+
+TEST(ShapePool, ReuseMemory)
+{
+	ShapePool pool(2);
+
+	const PoolHandle a = pool.Create<Circle>(Vector2(0, 0), 1);
+	Shape *p = pool.Get(a);
+
+	const size_t size = pool.GetMemoryUsage();
+	pool.Destroy(a);
+
+	// The freed memory is handed out again and no slab is added
+	const PoolHandle b = pool.Create<Circle>(Vector2(1, 1), 1);
+
+	EXPECT_EQ(p, pool.Get(b));
+	ARE_EQ(size, pool.GetMemoryUsage());
+
+	// A third circle needs a second slab
+	pool.Create<Circle>(Vector2(2, 2), 1);
+	pool.Create<Circle>(Vector2(3, 3), 1);
+
+	ARE_EQ(3, pool.GetCount());
+	EXPECT_EQ(2 * size, pool.GetMemoryUsage());
+}
+
+// Throws from its constructor when asked to
+class Brittle : public Circle
+{
+public:
+	Brittle(const bool fail) : Circle(Vector2(0, 0), 1)
+	{
+		if (fail)
+			throw std::runtime_error("brittle");
+	}
+};
+
+TEST(ShapePool, CreateThrows)
+{
+	ShapePool pool(1);
+
+	const PoolHandle a = pool.Create<Brittle>(false);
+	Shape *p = pool.Get(a);
+	pool.Destroy(a);
+
+	const size_t size = pool.GetMemoryUsage();
+
+	EXPECT_THROW(pool.Create<Brittle>(true), std::runtime_error);
+	ARE_EQ(0, pool.GetCount());
+
+	// The memory taken for the failed shape is handed out again instead of growing a slab
+	const PoolHandle b = pool.Create<Brittle>(false);
+
+	EXPECT_EQ(p, pool.Get(b));
+	ARE_EQ(size, pool.GetMemoryUsage());
+}
+
+// Refuses every allocation, as an engine heap that has run out would
+class FailingAllocator : public Allocator
+{
+public:
+	virtual void* Allocate(const size_t bytes, const MemoryTag tag) override
+	{
+		throw std::bad_alloc();
+	}
+
+	virtual void Deallocate(void *p, const size_t bytes, const MemoryTag tag) override
+	{
+		::operator delete(p);
+	}
+};
+
+TEST(ShapePool, GrowThrows)
+{
+	ShapePool pool(1);
+	FailingAllocator failing;
+
+	ASSERT_TRUE(SetAllocator(&failing));
+	EXPECT_THROW(pool.Create<Circle>(Vector2(0, 0), 1), std::bad_alloc);
+	EXPECT_TRUE(SetAllocator(nullptr));
+
+	// No empty slab is left behind, and the next shape grows one as usual
+	ARE_EQ(0, pool.GetMemoryUsage());
+
+	const PoolHandle a = pool.Create<Circle>(Vector2(0, 0), 1);
+	EXPECT_NE(nullptr, pool.Get(a));
+}
+
+TEST(ShapePool, Clone)
+{
+	const Circle circle(Vector2(1, 2), 3);
+	const Segment segment(Vector2(0, 0), Vector2(4, 0));
+	const Capsule capsule(Vector2(0, 0), Vector2(0, 4), 1);
+	const Polygon polygon = MakePolygon({ Vector2(0, 0), Vector2(4, 0), Vector2(2, 3) });
+	const OrientedBox oriented(Vector2(0, 0), Vector2(2, 1), 0.5f);
+	const Box box(Vector2(0, 0), Vector2(2, 2));
+
+	ShapePool pool;
+	PoolHandle h;
+
+	ASSERT_TRUE(pool.Clone(circle, h));
+	ARE_EQ(circle.GetRadius(), dynamic_cast<Circle*>(pool.Get(h))->GetRadius());
+
+	ASSERT_TRUE(pool.Clone(segment, h));
+	EXPECT_EQ(segment.GetPoint(1), pool.Get(h)->GetPoint(1));
+
+	ASSERT_TRUE(pool.Clone(capsule, h));
+	ARE_EQ(capsule.GetRadius(), dynamic_cast<Capsule*>(pool.Get(h))->GetRadius());
+
+	ASSERT_TRUE(pool.Clone(polygon, h));
+	ASSERT_NE(nullptr, dynamic_cast<Polygon*>(pool.Get(h)));
+	ARE_EQ(polygon.GetPoints().size(), pool.Get(h)->GetPoints().size());
+
+	ASSERT_TRUE(pool.Clone(oriented, h));
+	ASSERT_NE(nullptr, dynamic_cast<OrientedBox*>(pool.Get(h)));
+	EXPECT_EQ(nullptr, dynamic_cast<Box*>(pool.Get(h)));
+
+	ASSERT_TRUE(pool.Clone(box, h));
+	ASSERT_NE(nullptr, dynamic_cast<Box*>(pool.Get(h)));
+
+	ARE_EQ(6, pool.GetCount());
+}
+
+TEST(ShapePool, CloneQueries)
+{
+	const Polygon polygon = MakePolygon({ Vector2(0, 0), Vector2(4, 0), Vector2(4, 4), Vector2(0, 4) });
+	const Circle circle(Vector2(5, 2), 2);
+
+	ShapePool pool;
+	PoolHandle p, c;
+
+	ASSERT_TRUE(pool.Clone(polygon, p));
+	ASSERT_TRUE(pool.Clone(circle, c));
+
+	// The copies answer queries like the originals
+	ARE_EQ(polygon.Overlaps(circle), pool.Get(p)->Overlaps(*pool.Get(c)));
+	ARE_EQ(polygon.GetIntersects(circle).size(), pool.Get(p)->GetIntersects(*pool.Get(c)).size());
+	ARE_EQ(polygon.Contains(Vector2(1, 1)), pool.Get(p)->Contains(Vector2(1, 1)));
+}
+
+// Not one of the library's shapes, so a pool cannot copy it without slicing
+class Pebble : public Circle
+{
+public:
+	Pebble() : Circle(Vector2(0, 0), 1) {}
+};
+
+TEST(ShapePool, CloneUnknown)
+{
+	const Pebble pebble;
+	const Circle circle(Vector2(0, 0), 1);
+
+	ShapePool pool;
+	PoolHandle h{ 7, 7 };
+
+	EXPECT_FALSE(pool.Clone(pebble, h));
+	ARE_EQ(7, h.index);
+	ARE_EQ(0, pool.GetCount());
+
+	// A type seen before is cloned again without being resolved anew
+	ASSERT_TRUE(pool.Clone(circle, h));
+	ASSERT_TRUE(pool.Clone(circle, h));
+	ARE_EQ(2, pool.GetCount());
+	EXPECT_FALSE(pool.Clone(pebble, h));
+}
@@ -0,0 +1,230 @@
+#include "helper.hpp"
+
+#include <Crash2D/sweep_broadphase.hpp>
+
+static Bounds Square(const Vector2 &c, Precision_t h)
+{
+	return Bounds(c - h, c + h);
+}
+
+// Every pair tested directly, sorted the same way as FindPairs
+static std::vector<ProxyPair> BrutePairs(const std::vector<Bounds> &bounds)
+{
+	std::vector<ProxyPair> pairs;
+
+	for (unsigned a = 0; a < bounds.size(); a++)
+	{
+		for (unsigned b = a + 1; b < bounds.size(); b++)
+		{
+			if (bounds[a].Overlaps(bounds[b]))
+				pairs.push_back({ a, b });
+		}
+	}
+
+	return pairs;
+}
+
+TEST(SweepBroadphase, FindPairs)
+{
+	SweepBroadphase bp;
+	std::vector<Bounds> bounds;
+
+	for (unsigned i = 0; i < 60; i++)
+	{
+		bounds.push_back(Square(Vector2(std::cos(i * 1.3f) * 50, std::sin(i * 0.7f) * 50), 3 + i % 5));
+		bp.Insert(i, bounds.back());
+	}
+
+	ARE_EQ(60, bp.GetSize());
+
+	std::vector<ProxyPair> pairs;
+	bp.FindPairs(pairs);
+
+	EXPECT_FALSE(pairs.empty());
+	EXPECT_TRUE(pairs == BrutePairs(bounds));
+
+	// Move everything and check the re-sort
+	for (unsigned i = 0; i < bounds.size(); i++)
+	{
+		bounds[i] = Square(bounds[i].min + Vector2(std::sin(i * 2.1f) * 20, 4), 3 + i % 5);
+		bp.Update(i, bounds[i]);
+	}
+
+	bp.FindPairs(pairs);
+	EXPECT_TRUE(pairs == BrutePairs(bounds));
+}
+
+TEST(SweepBroadphase, FindPairsUnsorted)
+{
+	SweepBroadphase bp;
+	std::vector<Bounds> bounds;
+
+	// Inserted right to left, far too out of order for the insertion sort alone
+	for (unsigned i = 0; i < 2000; i++)
+	{
+		bounds.push_back(Square(Vector2((2000 - i) * 2.0f, (i * 2) % 40), 3));
+		bp.Insert(i, bounds.back());
+	}
+
+	std::vector<ProxyPair> pairs;
+	bp.FindPairs(pairs);
+
+	EXPECT_FALSE(pairs.empty());
+	EXPECT_TRUE(pairs == BrutePairs(bounds));
+}
+
+TEST(SweepBroadphase, Remove)
+{
+	SweepBroadphase bp;
+	bp.Insert(0, Square(Vector2(0, 0), 5));
+	bp.Insert(3, Square(Vector2(4, 0), 5));
+	bp.Insert(7, Square(Vector2(8, 0), 5));
+
+	std::vector<ProxyPair> pairs;
+	bp.FindPairs(pairs);
+	ARE_EQ(3, pairs.size());
+
+	bp.Remove(3);
+	EXPECT_FALSE(bp.Contains(3));
+	EXPECT_TRUE(bp.Contains(7));
+
+	bp.FindPairs(pairs);
+	ASSERT_EQ(1, pairs.size());
+	ARE_EQ(0, pairs[0].first);
+	ARE_EQ(7, pairs[0].second);
+}
+
+TEST(SweepBroadphase, Sleeping)
+{
+	SweepBroadphase bp;
+	std::vector<Bounds> bounds;
+
+	for (unsigned i = 0; i < 80; i++)
+	{
+		bounds.push_back(Square(Vector2(std::cos(i * 1.3f) * 50, std::sin(i * 0.7f) * 50), 3 + i % 5));
+		bp.Insert(i, bounds.back(), i % 3 == 0);
+	}
+
+	ARE_EQ(80, bp.GetSize());
+	EXPECT_TRUE(bp.IsAwake(3));
+	EXPECT_FALSE(bp.IsAwake(4));
+
+	// Only pairs with an awake proxy are reported
+	auto expected = [&bp, &bounds]()
+	{
+		std::vector<ProxyPair> pairs;
+
+		for (auto && p : BrutePairs(bounds))
+		{
+			if (bp.IsAwake(p.first) || bp.IsAwake(p.second))
+				pairs.push_back(p);
+		}
+
+		return pairs;
+	};
+
+	std::vector<ProxyPair> pairs;
+	bp.FindPairs(pairs);
+
+	EXPECT_FALSE(pairs.empty());
+	EXPECT_LT(pairs.size(), BrutePairs(bounds).size());
+	EXPECT_TRUE(pairs == expected());
+
+	// Change states and move things around
+	for (unsigned i = 0; i < bounds.size(); i++)
+	{
+		bp.SetAwake(i, i % 4 == 1);
+		bounds[i] = Square(bounds[i].min + Vector2(std::sin(i * 2.1f) * 20, 4), 3 + i % 5);
+		bp.Update(i, bounds[i]);
+	}
+
+	bp.Remove(5);
+	bp.Remove(6);
+	bounds[5] = Square(Vector2(1000, 1000), 0);
+	bounds[6] = Square(Vector2(-1000, -1000), 0);
+	EXPECT_EQ(78u, bp.GetSize());
+
+	bp.FindPairs(pairs);
+	EXPECT_TRUE(pairs == expected());
+
+	// Everything asleep
+	for (unsigned i = 0; i < bounds.size(); i++)
+	{
+		if (bp.Contains(i))
+			bp.SetAwake(i, false);
+	}
+
+	bp.FindPairs(pairs);
+	EXPECT_TRUE(pairs.empty());
+}
+
+TEST(SweepBroadphase, ChangesBetweenCalls)
+{
+	SweepBroadphase bp;
+	bp.Insert(0, Square(Vector2(0, 0), 5));
+	bp.Insert(1, Square(Vector2(4, 0), 5));
+	bp.Insert(2, Square(Vector2(8, 0), 5), false);
+
+	std::vector<ProxyPair> pairs;
+	bp.FindPairs(pairs);
+	ARE_EQ(3, pairs.size());
+
+	// Several changes to the same ids before the lists are compacted
+	bp.Remove(1);
+	bp.Insert(1, Square(Vector2(100, 0), 5), false);
+	bp.SetAwake(0, false);
+	bp.SetAwake(0, true);
+	bp.SetAwake(2, true);
+	bp.SetAwake(2, false);
+	bp.Remove(2);
+	bp.Insert(2, Square(Vector2(104, 0), 5));
+
+	ARE_EQ(3, bp.GetSize());
+
+	bp.FindPairs(pairs);
+	ASSERT_EQ(1, pairs.size());
+	ARE_EQ(1, pairs[0].first);
+	ARE_EQ(2, pairs[0].second);
+
+	// Each id is listed once, so the pair is not reported twice after more changes
+	bp.SetAwake(1, true);
+	bp.SetAwake(1, false);
+	bp.SetAwake(1, true);
+
+	bp.FindPairs(pairs);
+	ARE_EQ(1, pairs.size());
+}
+
+TEST(SweepBroadphase, Filter)
+{
+	SweepBroadphase bp;
+	std::vector<Bounds> bounds;
+
+	const CollisionFilter bullet(2, ~2u);
+
+	for (unsigned i = 0; i < 60; i++)
+	{
+		bounds.push_back(Square(Vector2(std::cos(i * 1.3f) * 30, std::sin(i * 0.7f) * 30), 3 + i % 5));
+		bp.Insert(i, bounds.back(), i % 4 != 0);
+
+		if (i % 2)
+			bp.SetFilter(i, bullet);
+	}
+
+	EXPECT_EQ(bullet, bp.GetFilter(1));
+	EXPECT_EQ(CollisionFilter(), bp.GetFilter(2));
+
+	std::vector<ProxyPair> expected;
+
+	for (auto && p : BrutePairs(bounds))
+	{
+		if ((bp.IsAwake(p.first) || bp.IsAwake(p.second)) && !(p.first % 2 && p.second % 2))
+			expected.push_back(p);
+	}
+
+	std::vector<ProxyPair> pairs;
+	bp.FindPairs(pairs);
+
+	EXPECT_FALSE(pairs.empty());
+	EXPECT_TRUE(pairs == expected);
+}
@@ -0,0 +1,61 @@
+#include "helper.hpp"
+
+#include <Crash2D/thread_pool.hpp>
+
+#include <atomic>
+
+TEST(ThreadPool, WorkerCount)
+{
+	ThreadPool one(1);
+	ARE_EQ(1, one.GetWorkerCount());
+
+	ThreadPool four(4);
+	ARE_EQ(4, four.GetWorkerCount());
+
+	ThreadPool none(0);
+	ARE_EQ(1, none.GetWorkerCount());
+}
+
+TEST(ThreadPool, RunsEveryTaskOnce)
+{
+	ThreadPool pool(4);
+
+	for (unsigned count = 0; count < 40; count += 7)
+	{
+		std::vector<std::atomic<unsigned>> runs(count);
+		std::atomic<unsigned> badWorker(0);
+
+		for (auto && r : runs)
+			r = 0;
+
+		pool.Run(count, [&](const unsigned task, const unsigned worker)
+		{
+			runs[task]++;
+
+			if (worker >= pool.GetWorkerCount())
+				badWorker++;
+		});
+
+		for (auto && r : runs)
+			ARE_EQ(1, r);
+
+		ARE_EQ(0, badWorker);
+	}
+}
+
+TEST(ThreadPool, UnevenTasks)
+{
+	ThreadPool pool(3);
+	std::atomic<unsigned> sum(0);
+
+	// The first block is far slower than the rest, so the other workers steal from it
+	pool.Run(30, [&](const unsigned task, const unsigned worker)
+	{
+		if (task < 10)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		sum += task;
+	});
+
+	ARE_EQ(435, sum);
+}
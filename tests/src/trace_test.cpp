@@ -0,0 +1,68 @@
+#include "helper.hpp"
+
+#include <Crash2D/trace.hpp>
+#include <Crash2D/collision_world.hpp>
+#include <Crash2D/circle.hpp>
+
+#include <sstream>
+#include <thread>
+
+static const std::string Trace()
+{
+	std::ostringstream out;
+	WriteTrace(out);
+
+	return out.str();
+}
+
+static const bool HasSpan(const std::string &trace, const std::string &name)
+{
+	return (trace.find("{\"name\":\"" + name + "\",\"ph\":\"X\"") != std::string::npos);
+}
+
+TEST(Trace, Phases)
+{
+	CollisionWorld world;
+	world.Add(new Circle(Vector2(0, 0), 10));
+	const ShapeHandle moving = world.Add(new Circle(Vector2(5, 0), 10));
+
+	ClearTrace();
+	SetQueryTracing(false);
+	world.Step();
+
+	const std::string trace = Trace();
+	EXPECT_EQ(0u, trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+	EXPECT_EQ('}', trace[trace.size() - 2]);
+
+	// Nothing is recorded unless the library was built with CRASH2D_TRACE
+	for (auto && phase : { "Step", "Broadphase insert", "Pair generation", "Narrowphase", "Merge" })
+		EXPECT_EQ(TracingEnabled(), HasSpan(trace, phase)) << phase;
+
+	EXPECT_FALSE(HasSpan(trace, "GetDisplacement"));
+
+	// Unmoved pairs reuse their results, so move one to run the queries again
+	SetQueryTracing(true);
+	world.MarkMoved(moving);
+	world.Step();
+	SetQueryTracing(false);
+
+	EXPECT_EQ(TracingEnabled(), HasSpan(Trace(), "GetDisplacement"));
+
+	ClearTrace();
+	EXPECT_FALSE(HasSpan(Trace(), "Step"));
+}
+
+TEST(Trace, Threads)
+{
+	ClearTrace();
+
+	// Spans of a thread that has exited are kept
+	std::thread worker([]()
+	{
+		TraceZone zone("Worker");
+	});
+	worker.join();
+
+	EXPECT_EQ(TracingEnabled(), HasSpan(Trace(), "Worker"));
+	ClearTrace();
+}
@@ -98,3 +98,10 @@ TEST(Vector2, GetDistance)
 	ARE_EQ(10 * std::sqrt(2), c.GetDistance(d));
 	ARE_EQ(10 * std::sqrt(2), d.GetDistance(c));
 }
+
+TEST(Vector2, InverseSqrt)
+{
+	ARE_EQ(0.5f, InverseSqrt(4));
+	ARE_EQ(0.1f, InverseSqrt(100));
+	EXPECT_NEAR(1 / std::sqrt(2.0f), InverseSqrt(2), 1e-5);
+}